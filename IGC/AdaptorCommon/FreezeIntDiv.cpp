@@ -67,7 +67,11 @@ FunctionPass *createFreezeIntDivPass() { return new FreezeIntDivLPM(); }
 #if LLVM_VERSION_MAJOR >= 16
 PreservedAnalyses FreezeIntDivNPM::run(Function &F, FunctionAnalysisManager &AM) {
   bool changed = FreezeIntDiv().run(F);
-  return changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+  if (!changed)
+    return PreservedAnalyses::all();
+  PreservedAnalyses PA;
+  PA.preserveSet<CFGAnalyses>();
+  return PA;
 }
 #endif // LLVM_VERSION_MAJOR >= 16
 
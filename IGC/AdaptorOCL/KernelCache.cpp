@@ -0,0 +1,295 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "AdaptorOCL/KernelCache.hpp"
+#include "Compiler/CISACodeGen/Platform.hpp"
+#include "common/igc_regkeys.hpp"
+
+#include "common/LLVMWarningsPush.hpp"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA256.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+#include "common/LLVMWarningsPop.hpp"
+
+#include "version.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace TC;
+
+namespace {
+// Bump when the entry layout or the key contents change.
+constexpr uint32_t EntryVersion = 1;
+constexpr char EntryMagic[8] = {'I', 'G', 'C', 'K', 'C', 'A', 'C', 'H'};
+constexpr char EntryExtension[] = ".bin";
+
+struct EntryHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t outputSize;
+  uint64_t debugDataSize;
+  uint64_t messageSize;
+  // xxHash64 of everything that follows the header.
+  uint64_t checksum;
+};
+
+class KeyBuilder {
+public:
+  void addBytes(const void *data, size_t size) {
+    hasher.update(llvm::ArrayRef<uint8_t>(static_cast<const uint8_t *>(data), size));
+  }
+  // Strings are length prefixed, so adjacent fields cannot run into each other.
+  void addString(const char *str, size_t size) {
+    const uint64_t length = str ? size : 0;
+    addBytes(&length, sizeof(length));
+    addBytes(str, length);
+  }
+  void addString(const char *str) { addString(str, str ? strlen(str) : 0); }
+  template <typename T> void add(const T &value) { addBytes(&value, sizeof(value)); }
+
+  std::string getKey() { return llvm::toHex(hasher.final(), /*LowerCase=*/true); }
+
+private:
+  llvm::SHA256 hasher;
+};
+
+#if defined(IGC_DEBUG_VARIABLES)
+// Regkeys that only control the cache itself and do not change the output.
+bool isKernelCacheFlag(const IGCFlag &flag) {
+  return &flag == &IGC_GET_REGKEY(KernelCacheDir) || &flag == &IGC_GET_REGKEY(KernelCacheMaxSizeMB) ||
+         &flag == &IGC_GET_REGKEY(KernelCacheValidate) || &flag == &IGC_GET_REGKEY(KernelCachePrintStats);
+}
+#endif
+} // namespace
+
+KernelCache::KernelCache(std::string dir, uint64_t maxSizeInBytes)
+    : m_Dir(std::move(dir)), m_MaxSizeInBytes(maxSizeInBytes) {}
+
+KernelCache::Stats &KernelCache::stats() {
+  static Stats s;
+  return s;
+}
+
+void KernelCache::printStats() {
+  const Stats &s = stats();
+  fprintf(stderr, "IGC kernel cache: hits=%llu misses=%llu stores=%llu evictions=%llu mismatches=%llu\n",
+          (unsigned long long)s.hits, (unsigned long long)s.misses, (unsigned long long)s.stores,
+          (unsigned long long)s.evictions, (unsigned long long)s.mismatches);
+}
+
+bool KernelCache::isCacheable(const STB_TranslateInputArgs *pInputArgs) {
+  // Instrumented builds depend on state that is not part of the key.
+  if (pInputArgs->pTracingOptions || pInputArgs->GTPinInput) {
+    return false;
+  }
+  // Dumps and overrides are side effects of compiling.
+  if (IGC_IS_FLAG_ENABLED(ShaderDumpEnable) || IGC_IS_FLAG_ENABLED(ShaderOverride)) {
+    return false;
+  }
+#if defined(IGC_DEBUG_VARIABLES)
+  // Regkeys applied to hash ranges or entry points would need the key of
+  // every kernel in the program.
+  for (const IGCFlag &flag : g_IGCFlagsArray) {
+    if (!flag.hashes.empty() || !flag.entry_points.empty()) {
+      return false;
+    }
+  }
+#endif
+  return true;
+}
+
+std::string KernelCache::computeKey(const STB_TranslateInputArgs *pInputArgs, TB_DATA_FORMAT inputDataFormat,
+                                    const IGC::CPlatform &platform, float profilingTimerResolution) {
+  KeyBuilder key;
+  key.add(EntryVersion);
+#ifdef IGC_REVISION
+  key.addString(IGC_REVISION);
+#else
+  key.addString(__DATE__ " " __TIME__);
+#endif
+
+  key.add(inputDataFormat);
+  key.addString(pInputArgs->pInput, pInputArgs->InputSize);
+  key.addString(pInputArgs->pOptions, pInputArgs->OptionsSize);
+  key.addString(pInputArgs->pInternalOptions, pInputArgs->InternalOptionsSize);
+  key.add(pInputArgs->CompileTimeStatisticsEnable);
+  key.add(pInputArgs->SpecConstantsSize);
+  for (uint32_t i = 0; i < pInputArgs->SpecConstantsSize; ++i) {
+    key.add(pInputArgs->pSpecConstantsIds[i]);
+    key.add(pInputArgs->pSpecConstantsValues[i]);
+  }
+  key.add(pInputArgs->NumVISAAsmsToLink);
+  for (uint32_t i = 0; i < pInputArgs->NumVISAAsmsToLink; ++i) {
+    key.addString(pInputArgs->pVISAAsmToLinkArray[i]);
+  }
+  key.add(pInputArgs->NumDirectCallFunctions);
+  for (uint32_t i = 0; i < pInputArgs->NumDirectCallFunctions; ++i) {
+    key.addString(pInputArgs->pDirectCallFunctions[i]);
+  }
+  key.add(profilingTimerResolution);
+
+  key.add(platform.getPlatformInfo());
+  key.add(platform.getWATable());
+  key.add(platform.getSkuTable());
+  key.add(platform.GetGTSystemInfo());
+
+#if defined(IGC_DEBUG_VARIABLES)
+  for (IGCFlag &flag : g_IGCFlagsArray) {
+    if (isKernelCacheFlag(flag) || !flag.IsSetToNonDefaultValue()) {
+      continue;
+    }
+    key.addString(flag.name);
+    if (flag.IsString()) {
+      key.addString(flag.m_string);
+    } else {
+      key.add(flag.m_Value);
+    }
+  }
+#endif
+  return key.getKey();
+}
+
+std::string KernelCache::getEntryPath(const std::string &key) const {
+  llvm::SmallString<256> path(m_Dir);
+  llvm::sys::path::append(path, key + EntryExtension);
+  return std::string(path);
+}
+
+bool KernelCache::load(const std::string &key, STB_TranslateOutputArgs &outputArgs) {
+  const std::string path = getEntryPath(key);
+  auto buffer = llvm::MemoryBuffer::getFile(path, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+  if (!buffer) {
+    stats().misses++;
+    return false;
+  }
+
+  llvm::StringRef data = (*buffer)->getBuffer();
+  EntryHeader header = {};
+  bool valid = data.size() >= sizeof(header);
+  if (valid) {
+    memcpy(&header, data.data(), sizeof(header));
+    data = data.drop_front(sizeof(header));
+    valid = memcmp(header.magic, EntryMagic, sizeof(EntryMagic)) == 0 && header.version == EntryVersion &&
+            header.outputSize + header.debugDataSize + header.messageSize == data.size() &&
+            llvm::xxHash64(data) == header.checksum;
+  }
+  if (!valid) {
+    // Left behind by an older compiler or damaged; it is replaced after compiling.
+    llvm::sys::fs::remove(path);
+    stats().misses++;
+    return false;
+  }
+
+  llvm::StringRef output = data.take_front(header.outputSize);
+  llvm::StringRef debugData = data.drop_front(header.outputSize).take_front(header.debugDataSize);
+  llvm::StringRef message = data.take_back(header.messageSize);
+  outputArgs.Output.assign(output.begin(), output.end());
+  outputArgs.DebugData.assign(debugData.begin(), debugData.end());
+  outputArgs.ErrorString = message.str();
+
+  // Entries are evicted by modification time, so touch the entry on use.
+  int fd = -1;
+  if (!llvm::sys::fs::openFileForWrite(path, fd, llvm::sys::fs::CD_OpenExisting, llvm::sys::fs::OF_Append)) {
+    llvm::sys::fs::setLastAccessAndModificationTime(fd, std::chrono::system_clock::now());
+    llvm::sys::fs::file_t file = llvm::sys::fs::convertFDToNativeFile(fd);
+    llvm::sys::fs::closeFile(file);
+  }
+  stats().hits++;
+  return true;
+}
+
+void KernelCache::store(const std::string &key, const STB_TranslateOutputArgs &outputArgs) {
+  std::string entry(sizeof(EntryHeader), '\0');
+  entry.append(outputArgs.Output.begin(), outputArgs.Output.end());
+  entry.append(outputArgs.DebugData.begin(), outputArgs.DebugData.end());
+  entry.append(outputArgs.ErrorString);
+
+  EntryHeader header = {};
+  memcpy(header.magic, EntryMagic, sizeof(EntryMagic));
+  header.version = EntryVersion;
+  header.outputSize = outputArgs.Output.size();
+  header.debugDataSize = outputArgs.DebugData.size();
+  header.messageSize = outputArgs.ErrorString.size();
+  header.checksum = llvm::xxHash64(llvm::StringRef(entry).drop_front(sizeof(header)));
+  memcpy(&entry[0], &header, sizeof(header));
+
+  // Write to a unique temporary file and rename it into place, so readers in
+  // other processes never see a partially written entry.
+  const std::string path = getEntryPath(key);
+  llvm::SmallString<256> tmpPath;
+  int fd = -1;
+  if (llvm::sys::fs::createUniqueFile(path + "-%%%%%%%%.tmp", fd, tmpPath)) {
+    return;
+  }
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    os.write(entry.data(), entry.size());
+    os.close();
+    if (os.has_error()) {
+      os.clear_error();
+      llvm::sys::fs::remove(tmpPath);
+      return;
+    }
+  }
+  if (llvm::sys::fs::rename(tmpPath, path)) {
+    llvm::sys::fs::remove(tmpPath);
+    return;
+  }
+  stats().stores++;
+  evict();
+}
+
+void KernelCache::evict() {
+  struct Entry {
+    llvm::sys::TimePoint<> lastUse;
+    uint64_t size;
+    std::string path;
+  };
+  std::vector<Entry> entries;
+  uint64_t totalSize = 0;
+
+  std::error_code ec;
+  for (llvm::sys::fs::directory_iterator it(m_Dir, ec), end; it != end && !ec; it.increment(ec)) {
+    if (llvm::sys::path::extension(it->path()) != EntryExtension) {
+      continue;
+    }
+    auto status = it->status();
+    if (!status) {
+      continue;
+    }
+    entries.push_back({status->getLastModificationTime(), status->getSize(), it->path()});
+    totalSize += status->getSize();
+  }
+  if (totalSize <= m_MaxSizeInBytes) {
+    return;
+  }
+
+  // Trim well below the limit, so that not every store has to evict.
+  const uint64_t targetSize = m_MaxSizeInBytes / 4 * 3;
+  std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) { return a.lastUse < b.lastUse; });
+  for (const Entry &e : entries) {
+    if (totalSize <= targetSize) {
+      break;
+    }
+    // Another process may have removed it already.
+    if (!llvm::sys::fs::remove(e.path, /*IgnoreNonExisting=*/false)) {
+      totalSize -= e.size;
+      stats().evictions++;
+    }
+  }
+}
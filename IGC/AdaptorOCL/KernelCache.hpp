@@ -0,0 +1,62 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#pragma once
+
+#include "AdaptorOCL/TranslationBlock.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace IGC {
+class CPlatform;
+}
+
+namespace TC {
+// On-disk cache of TranslateBuild results. Entries are keyed by a hash of
+// everything the result depends on: the input, build options, spec constants,
+// platform, workaround and SKU tables, regkeys and the compiler revision.
+//
+// Entries are written to a temporary file and renamed into place, so several
+// processes can share one cache directory. When the directory grows over the
+// size limit, the least recently used entries are removed.
+class KernelCache {
+public:
+  struct Stats {
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> stores{0};
+    std::atomic<uint64_t> evictions{0};
+    std::atomic<uint64_t> mismatches{0};
+  };
+
+  KernelCache(std::string dir, uint64_t maxSizeInBytes);
+
+  // Returns false when the build must not be cached, e.g. because it is
+  // instrumented or its regkeys depend on the shader hash.
+  static bool isCacheable(const STB_TranslateInputArgs *pInputArgs);
+  static std::string computeKey(const STB_TranslateInputArgs *pInputArgs, TB_DATA_FORMAT inputDataFormat,
+                                const IGC::CPlatform &platform, float profilingTimerResolution);
+
+  // Fills outputArgs and marks the entry as recently used on a hit.
+  bool load(const std::string &key, STB_TranslateOutputArgs &outputArgs);
+  void store(const std::string &key, const STB_TranslateOutputArgs &outputArgs);
+
+  // Process-wide counters of all caches.
+  static Stats &stats();
+  static void printStats();
+
+private:
+  std::string getEntryPath(const std::string &key) const;
+  void evict();
+
+  std::string m_Dir;
+  uint64_t m_MaxSizeInBytes;
+};
+} // namespace TC
@@ -20,12 +20,16 @@ SPDX-License-Identifier: MIT
 #include "llvmWrapper/IR/Module.h"
 #include "llvmWrapper/ADT/ScopeExit.h"
 
+#include <algorithm>
 #include <cstring>
 #include <string>
 #include <stdexcept>
 #include <fstream>
+#include <atomic>
 #include <mutex>
 #include <numeric>
+#include <thread>
+#include <functional>
 #include <chrono>
 
 #include "AdaptorCommon/customApi.hpp"
@@ -35,6 +39,7 @@ SPDX-License-Identifier: MIT
 
 #include "AdaptorOCL/UnifyIROCL.hpp"
 #include "AdaptorOCL/DriverInfoOCL.hpp"
+#include "AdaptorOCL/KernelCache.hpp"
 
 #include "Compiler/CISACodeGen/OpenCLKernelCodeGen.hpp"
 #include "Compiler/MetaDataApi/IGCMetaDataHelper.h"
@@ -148,9 +153,51 @@ using namespace IGC;
 
 namespace TC {
 
-static std::mutex llvm_mutex;
+// VC compiler effectively uses global variables to store some configuration
+// information, so VC builds are still serialized on this mutex. It also guards
+// the process-wide llvm::cl option registry, which the VC driver resets and
+// reparses on every build. SPMD builds only take it while llvm::cl defaults
+// have to be (re)applied, see ApplyDefaultLLVMOptions.
+static std::mutex vc_mutex;
+
+// Set when the llvm::cl registry may be missing IGC's SPMD defaults: at
+// startup and whenever a VC build runs, since the VC driver resets all
+// option occurrences.
+static std::atomic<bool> llvmDefaultsPending{true};
+
+// Set while the current thread holds vc_mutex. The signal/exception guard in
+// igc_ocl_translation_ctx_impl.h calls UnlockMutex() after any failed build,
+// so it must only release a lock that this thread actually owns.
+static thread_local bool vc_mutex_owned = false;
+
+void UnlockMutex() {
+  if (vc_mutex_owned) {
+    vc_mutex_owned = false;
+    vc_mutex.unlock();
+  }
+}
+
+#if defined(NDEBUG) && !defined(_WIN32)
+// Defined next to sig_jmp_buf, see igc_ocl_translation_ctx_impl.cpp.
+int RunWithSignalGuard(const std::function<void()> &body);
+#endif
 
-void UnlockMutex() { llvm_mutex.unlock(); }
+namespace {
+// Scoped ownership of vc_mutex that stays consistent with vc_mutex_owned.
+// longjmp out of a signal handler skips the destructor; UnlockMutex() then
+// releases the lock from EX_GUARD_END instead.
+class VCBuildLock {
+public:
+  VCBuildLock() {
+    vc_mutex.lock();
+    vc_mutex_owned = true;
+    llvmDefaultsPending.store(true, std::memory_order_relaxed);
+  }
+  ~VCBuildLock() { UnlockMutex(); }
+  VCBuildLock(const VCBuildLock &) = delete;
+  VCBuildLock &operator=(const VCBuildLock &) = delete;
+};
+} // namespace
 
 bool ProcessElfInput(STB_TranslateInputArgs &InputArgs, STB_TranslateOutputArgs &OutputArgs,
                      IGC::OpenCLProgramContext &Context, PLATFORM &platform, const TB_DATA_FORMAT &outType,
@@ -200,6 +247,13 @@ void CIGCTranslationBlock::Delete(CIGCTranslationBlock *pTranslationBlock) { del
 bool CIGCTranslationBlock::Translate(const STB_TranslateInputArgs *pInputArgs, STB_TranslateOutputArgs *pOutputArgs) {
   LoadRegistryKeys();
 
+  const char *compileTraceFile = IGC_GET_REGKEYSTRING(CompileTraceFile);
+  if (compileTraceFile[0] != '\0') {
+    vISA::trace::enable(compileTraceFile, IGC_GET_FLAG_VALUE(CompileTraceSampleRate));
+  }
+  vISA::trace::Sample compileTraceSample;
+  COMPILE_TRACE_SCOPE("Translate", "igc");
+
   // Create a copy of input arguments that can be modified
   STB_TranslateInputArgs InputArgsCopy = *pInputArgs;
 
@@ -999,96 +1053,626 @@ static void WriteSpecConstantsDump(const STB_TranslateInputArgs *pInputArgs, QWO
   DumpShaderFile(pOutputFolder, outputstr.str().c_str(), outputstr.str().size(), hash, "_specconst.txt");
 }
 
-bool TranslateBuildSPMD(const STB_TranslateInputArgs *pInputArgs, STB_TranslateOutputArgs *pOutputArgs,
-                        TB_DATA_FORMAT inputDataFormatTemp, const IGC::CPlatform &IGCPlatform,
-                        float profilingTimerResolution, const ShaderHash &inputShHash) {
-  // This part of code is a critical-section for threads,
-  // due static LLVM object which handles options.
-  // Setting mutex to ensure that single thread will enter and setup this flag.
-  {
-    const std::lock_guard<std::mutex> lock(llvm_mutex);
-    std::vector<const char *> args;
-    args.push_back("igc");
-    auto optionsMap = llvm::cl::getRegisteredOptions();
-
-    // The default value (8) for max of trip count upper bound that is considered
-    // in unrolling is not enough for some important compute workloads, so we set it to 16.
-    // When UnrollMaxUpperBound parameter will be available to set in UnrollingPreferences
-    // this code will be removed.
-    llvm::StringRef unrollMaxUpperBoundFlag = "-unroll-max-upperbound=16";
-    auto unrollMaxUpperBoundSwitch = optionsMap.find(unrollMaxUpperBoundFlag.trim("-=16"));
-    if (unrollMaxUpperBoundSwitch != optionsMap.end()) {
-      if (unrollMaxUpperBoundSwitch->second->getNumOccurrences() == 0) {
-        args.push_back(unrollMaxUpperBoundFlag.data());
+// Sets IGC's preferred defaults for LLVM options that the user did not
+// specify explicitly. Caller must hold vc_mutex.
+static void SetDefaultLLVMOptions() {
+  std::vector<const char *> args;
+  args.push_back("igc");
+  auto optionsMap = llvm::cl::getRegisteredOptions();
+
+  // The default value (8) for max of trip count upper bound that is considered
+  // in unrolling is not enough for some important compute workloads, so we set it to 16.
+  // When UnrollMaxUpperBound parameter will be available to set in UnrollingPreferences
+  // this code will be removed.
+  llvm::StringRef unrollMaxUpperBoundFlag = "-unroll-max-upperbound=16";
+  auto unrollMaxUpperBoundSwitch = optionsMap.find(unrollMaxUpperBoundFlag.trim("-=16"));
+  if (unrollMaxUpperBoundSwitch != optionsMap.end()) {
+    if (unrollMaxUpperBoundSwitch->second->getNumOccurrences() == 0) {
+      args.push_back(unrollMaxUpperBoundFlag.data());
+    }
+  }
+
+  // Disable code sinking in instruction combining.
+  // This is a workaround for a performance issue caused by code sinking
+  // that is being done in LLVM's instcombine pass.
+  // This code will be removed once sinking is removed from instcombine.
+  llvm::StringRef instCombineFlag = "-instcombine-code-sinking=0";
+  auto instCombineSinkingSwitch = optionsMap.find(instCombineFlag.trim("-=0"));
+  if (instCombineSinkingSwitch != optionsMap.end()) {
+    if (instCombineSinkingSwitch->second->getNumOccurrences() == 0) {
+      args.push_back(instCombineFlag.data());
+    }
+  }
+
+  // With the default (250) maximum number of accesses allowed for memory
+  // promotion when using MemorySSA we lack the performance for some
+  // applications. Setting the number of accesses for memory promotion
+  // cap to 500 solves this issue.
+  llvm::StringRef licmMSSAPromotionFlag = "-licm-mssa-max-acc-promotion=500";
+  auto licmMSSAPromotionSwitch = optionsMap.find(licmMSSAPromotionFlag.trim("-=500"));
+  if (licmMSSAPromotionSwitch != optionsMap.end()) {
+    if (licmMSSAPromotionSwitch->second->getNumOccurrences() == 0) {
+      args.push_back(licmMSSAPromotionFlag.data());
+    }
+  }
+
+  // Avoid stack overflow in AliasAnalysis for expansive loop unrolling cases.
+  llvm::StringRef aaQueryDepthFlag = "-basic-aa-max-query-depth=192";
+  auto aaQueryDepthSwitch = optionsMap.find(aaQueryDepthFlag.trim("-=192"));
+  if (aaQueryDepthSwitch != optionsMap.end()) {
+    if (aaQueryDepthSwitch->second->getNumOccurrences() == 0) {
+      args.push_back(aaQueryDepthFlag.data());
+    }
+  }
+
+  llvm::StringRef dsePartialOverwriteTrackingFlag = "-enable-dse-partial-overwrite-tracking=1";
+  auto dsePartialOverwriteTrackingSwitch = optionsMap.find(dsePartialOverwriteTrackingFlag.trim("-=1"));
+  if (dsePartialOverwriteTrackingSwitch != optionsMap.end()) {
+    if (dsePartialOverwriteTrackingSwitch->second->getNumOccurrences() == 0) {
+      args.push_back(dsePartialOverwriteTrackingFlag.data());
+    }
+  }
+
+  llvm::StringRef dseMSSAStepLimitFlag = "-dse-memoryssa-walklimit=150";
+  auto dseMSSAStepLimitSwitch = optionsMap.find(dseMSSAStepLimitFlag.trim("-=150"));
+  if (dseMSSAStepLimitSwitch != optionsMap.end()) {
+    if (dseMSSAStepLimitSwitch->second->getNumOccurrences() == 0) {
+      args.push_back(dseMSSAStepLimitFlag.data());
+    }
+  }
+
+  // From pass IndVarSimplify we are only interested in optimization done by -replexitval.
+  // Disable other features that can have a negative impact on performance.
+  std::array<llvm::StringRef, 4> indVarSimplifyFlags = {"-indvars-post-increment-ranges=0", "-disable-lftr=1",
+                                                        "-indvars-widen-indvars=0", "-verify-indvars=0"};
+  for (const auto indVarSimplifyFlag : indVarSimplifyFlags) {
+    auto indVarSimplifySwitch = optionsMap.find(indVarSimplifyFlag.drop_front(1).split("=").first);
+    if (indVarSimplifySwitch != optionsMap.end()) {
+      if (indVarSimplifySwitch->second->getNumOccurrences() == 0) {
+        args.push_back(indVarSimplifyFlag.data());
       }
     }
+  }
+
+  if (std::size(args) > 1) {
+    llvm::cl::ParseCommandLineOptions(std::size(args), &args[0]);
+  }
+}
+
+static void ApplyDefaultLLVMOptions() {
+  if (!llvmDefaultsPending.load(std::memory_order_acquire))
+    return;
+
+  const std::lock_guard<std::mutex> lock(vc_mutex);
+  if (llvmDefaultsPending.load(std::memory_order_relaxed)) {
+    SetDefaultLLVMOptions();
+    llvmDefaultsPending.store(false, std::memory_order_release);
+  }
+}
+
+// Sets the default denorm modes of the module. Unification switches them to
+// FLOAT_DENORM_FLUSH_TO_ZERO when the options ask for it, so they have to be
+// reset each time the metadata is (re)created.
+static void SetDefaultDenormModes(OpenCLProgramContext &oclContext) {
+  CompOptions *compOpt = &oclContext.getModuleMetaData()->compOpt;
+  compOpt->FloatDenormMode16 = FLOAT_DENORM_RETAIN;
+  compOpt->FloatDenormMode32 = FLOAT_DENORM_RETAIN;
+  compOpt->FloatDenormMode64 = FLOAT_DENORM_RETAIN;
+  if (oclContext.platform.hasBFTFDenormMode()) {
+    compOpt->FloatDenormModeBFTF = FLOAT_DENORM_RETAIN;
+  }
+}
+
+// Runs unification, optimization and code generation on the module currently
+// set in oclContext. Returns false and fills pOutputArgs on failure.
+static bool CompileProgramModule(OpenCLProgramContext &oclContext, STB_TranslateOutputArgs *pOutputArgs) {
+  oclContext.getModuleMetaData()->csInfo.forcedSIMDSize |= IGC_GET_FLAG_VALUE(ForceOCLSIMDWidth);
+
+  try {
+    if (IGCLLVM::starts_with(llvm::StringRef(IGCLLVM::getTargetTriple(*oclContext.getModule())), "spir")) {
+      IGC::UnifyIRSPIR(&oclContext);
+    } else // not SPIR
+    {
+      IGC::UnifyIROCL(&oclContext);
+    }
+
+    if (oclContext.HasError()) {
+      if (oclContext.HasWarning()) {
+        SetOutputMessage(oclContext.GetErrorAndWarning(), *pOutputArgs);
+      } else {
+        SetOutputMessage(oclContext.GetError(), *pOutputArgs);
+      }
+      return false;
+    }
+
+    // Compiler Options information available after unification.
+    ModuleMetaData *modMD = oclContext.getModuleMetaData();
+    if (modMD->compOpt.DenormsAreZero) {
+      modMD->compOpt.FloatDenormMode16 = FLOAT_DENORM_FLUSH_TO_ZERO;
+      modMD->compOpt.FloatDenormMode32 = FLOAT_DENORM_FLUSH_TO_ZERO;
+    }
+    if (modMD->compOpt.BFTFDenormsAreZero) {
+      modMD->compOpt.FloatDenormModeBFTF = FLOAT_DENORM_FLUSH_TO_ZERO;
+    }
+    if (IGC_GET_FLAG_VALUE(ForceFastestSIMD)) {
+      oclContext.m_retryManager->AdvanceState();
+      oclContext.m_retryManager->SetFirstStateId(oclContext.m_retryManager->GetRetryId());
+    }
+    // Optimize the IR. This happens once for each program, not per-kernel.
+    IGC::OptimizeIR(&oclContext);
+
+    // Now, perform code generation
+    IGC::CodeGen(&oclContext);
+  } catch (std::bad_alloc &e) {
+    (void)e; // not used now
+    SetOutputMessage("IGC: Out Of Memory", *pOutputArgs);
+    return false;
+  } catch (std::exception &e) {
+    if (pOutputArgs->ErrorString.empty()) {
+      std::string message = "IGC: ";
+      message += oclContext.GetErrorAndWarning();
+      message += '\n';
+      message += e.what();
+      SetErrorMessage(message.c_str(), *pOutputArgs);
+    }
+    return false;
+  }
+  return true;
+}
+
+// Parses the module of a single kernel that CompileKernelsInParallel split
+// off the program.
+static bool ParseKernelBitcode(llvm::Module *&pKernelModule, llvm::StringRef bitcode, std::string &errorString,
+                               llvm::LLVMContext &context) {
+  pKernelModule = nullptr;
+  llvm::Expected<std::unique_ptr<llvm::Module>> MOE =
+      llvm::parseBitcodeFile(llvm::MemoryBufferRef(bitcode, "<kernel>"), context);
+  if (!MOE) {
+    errorString = "Parsing llvm module failed! " + llvm::toString(MOE.takeError());
+    return false;
+  }
+  pKernelModule = MOE->release();
+  return true;
+}
+
+// Reparses the input, or kernelBitcode when only one kernel is compiled, into
+// a fresh LLVMContext and drops the kernels that do not need to be recompiled
+// by the next retry state.
+static bool PrepareForRetry(OpenCLProgramContext &oclContext, llvm::Module *&pKernelModule,
+                            const STB_TranslateInputArgs *pInputArgs, STB_TranslateOutputArgs *pOutputArgs,
+                            TB_DATA_FORMAT inputDataFormatTemp, const IGC::CPlatform &IGCPlatform,
+                            llvm::StringRef kernelBitcode = {}) {
+  oclContext.clearBeforeRetry();
+  oclContext.clear();
+
+  // Create a new LLVMContext
+  oclContext.initLLVMContextWrapper();
+
+  IGC::Debug::RegisterComputeErrHandlers(*oclContext.getLLVMContext());
+
+  const bool parsed = kernelBitcode.empty()
+                          ? ParseInput(pKernelModule, pInputArgs, pOutputArgs->ErrorString,
+                                       *oclContext.getLLVMContext(), inputDataFormatTemp, IGCPlatform)
+                          : ParseKernelBitcode(pKernelModule, kernelBitcode, pOutputArgs->ErrorString,
+                                               *oclContext.getLLVMContext());
+  if (!parsed) {
+    return false;
+  }
+  oclContext.setModule(pKernelModule);
+
+  // Remove annotations for kernels that do not require recompilation
+  RebuildGlobalAnnotations(oclContext, pKernelModule);
+
+  // Set default denorm since metadata was cleared.
+  SetDefaultDenormModes(oclContext);
+
+  for (auto it = pKernelModule->getFunctionList().begin(), ie = pKernelModule->getFunctionList().end(); it != ie;) {
+    Function *pFunc = &*(it++);
+    // Only retry compilation on kernels that need it.
+    // Skip erasure if the kernel is still referenced (e.g., called as a
+    // device function by another kernel that will be recompiled).
+    // Quoting from the OpenCL C spec: "It is just a regular function call if a __kernel function is called by
+    // another kernel function."
+    if (pFunc->getCallingConv() == llvm::CallingConv::SPIR_KERNEL &&
+        oclContext.m_retryManager->kernelSet.find(pFunc->getName().str()) ==
+            oclContext.m_retryManager->kernelSet.end() &&
+        pFunc->use_empty()) {
+      pFunc->eraseFromParent();
+      // TODO: Consider running a proper cleanup of
+      // !opencl.kernels metadata entries here instead of
+      // deferring 'null' entries to the "retried"
+      // unification phase.
+    }
+  }
+  return true;
+}
 
-    // Disable code sinking in instruction combining.
-    // This is a workaround for a performance issue caused by code sinking
-    // that is being done in LLVM's instcombine pass.
-    // This code will be removed once sinking is removed from instcombine.
-    llvm::StringRef instCombineFlag = "-instcombine-code-sinking=0";
-    auto instCombineSinkingSwitch = optionsMap.find(instCombineFlag.trim("-=0"));
-    if (instCombineSinkingSwitch != optionsMap.end()) {
-      if (instCombineSinkingSwitch->second->getNumOccurrences() == 0) {
-        args.push_back(instCombineFlag.data());
+// Compiles the whole program in oclContext, walking through the retry states
+// of its retry manager. With doSplitModule, kernels are compiled one at a time.
+static bool CompileProgram(OpenCLProgramContext &oclContext, llvm::Module *&pKernelModule, bool doSplitModule,
+                           const STB_TranslateInputArgs *pInputArgs, STB_TranslateOutputArgs *pOutputArgs,
+                           TB_DATA_FORMAT inputDataFormatTemp, const IGC::CPlatform &IGCPlatform) {
+  // set retry manager
+  bool retry = false;
+  oclContext.m_retryManager->Enable(ShaderType::OPENCL_SHADER);
+  do {
+    llvm::TinyPtrVector<const llvm::Function *> kernelFunctions;
+    if (doSplitModule) {
+      for (const auto &F : pKernelModule->functions()) {
+        if (F.getCallingConv() == llvm::CallingConv::SPIR_KERNEL) {
+          kernelFunctions.push_back(&F);
+        }
       }
+
+      if (retry) {
+        fprintf(stderr, "IGC recompiles whole module with different optimization strategy, recompiling all kernels \n");
+      }
+      IGC_ASSERT_EXIT_MESSAGE(kernelFunctions.empty() == false, "No kernels found!");
+      fprintf(stderr, "IGC compiles kernels one by one... (%d total)\n", kernelFunctions.size());
     }
 
-    // With the default (250) maximum number of accesses allowed for memory
-    // promotion when using MemorySSA we lack the performance for some
-    // applications. Setting the number of accesses for memory promotion
-    // cap to 500 solves this issue.
-    llvm::StringRef licmMSSAPromotionFlag = "-licm-mssa-max-acc-promotion=500";
-    auto licmMSSAPromotionSwitch = optionsMap.find(licmMSSAPromotionFlag.trim("-=500"));
-    if (licmMSSAPromotionSwitch != optionsMap.end()) {
-      if (licmMSSAPromotionSwitch->second->getNumOccurrences() == 0) {
-        args.push_back(licmMSSAPromotionFlag.data());
+    // for Module splitting feature; if it's inactive, flow is as normal
+    do {
+      KernelModuleSplitter splitter(oclContext, *pKernelModule);
+      if (doSplitModule) {
+        const llvm::Function *pKernelFunction = kernelFunctions.back();
+
+        fprintf(stderr, "Compiling kernel #%d: %s\n", kernelFunctions.size(), pKernelFunction->getName().data());
+        kernelFunctions.pop_back();
+
+        splitter.splitModuleForKernel(pKernelFunction);
+        splitter.setSplittedModuleInOCLContext();
       }
+
+      if (!CompileProgramModule(oclContext, pOutputArgs)) {
+        return false;
+      }
+
+      retry = (!oclContext.m_retryManager->kernelSet.empty() && oclContext.m_retryManager->AdvanceState());
+
+      if (retry) {
+        splitter.retry();
+        kernelFunctions.clear();
+        if (!PrepareForRetry(oclContext, pKernelModule, pInputArgs, pOutputArgs, inputDataFormatTemp, IGCPlatform)) {
+          return false;
+        }
+      }
+    } while (!kernelFunctions.empty());
+  } while (retry);
+  return true;
+}
+
+// Returns whether every kernel of M can be compiled in a module of its own
+// with the same result as compiling M whole. Kernels must not share anything
+// that is laid out or resolved per program: program-scope variables, functions
+// called through pointers, exported symbols or other kernels they call.
+// Otherwise, reason tells why not.
+static bool CanCompileKernelsSeparately(const OpenCLProgramContext &oclContext, const llvm::Module &M,
+                                        std::string &reason) {
+  if (oclContext.m_Options.IsLibraryCompilation || oclContext.m_Options.EnableTakeGlobalAddress) {
+    reason = "it exports symbols";
+    return false;
+  }
+  unsigned numKernels = 0;
+  for (const auto &F : M) {
+    if (F.hasFnAttribute("referenced-indirectly")) {
+      reason = "it has indirectly called functions";
+      return false;
+    }
+    if (F.isDeclaration() || F.getCallingConv() != llvm::CallingConv::SPIR_KERNEL) {
+      continue;
     }
+    ++numKernels;
+    for (const llvm::User *U : F.users()) {
+      if (llvm::isa<llvm::CallBase>(U)) {
+        reason = "a kernel calls another kernel";
+        return false;
+      }
+    }
+  }
+  if (numKernels < 2) {
+    reason = "it has a single kernel";
+    return false;
+  }
+  for (const auto &GV : M.globals()) {
+    unsigned AS = GV.getType()->getAddressSpace();
+    if (AS == ADDRESS_SPACE_GLOBAL || AS == ADDRESS_SPACE_CONSTANT) {
+      reason = "it has program-scope variables";
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compiles every kernel of the program on up to numThreads worker threads.
+// LLVMContext is not thread-safe, so the program parsed into oclContext is
+// split once, on this thread, into one module per kernel. Each worker reads
+// the bitcode of its kernel into the LLVMContext of an OpenCLProgramContext of
+// its own and walks that kernel's retry states. The resulting shader programs
+// are merged into oclContext in module order, as the whole-program compile
+// emits them. A failure or exception in a worker fails the build with that
+// worker's error.
+//
+// With speculativeRetry, every kernel also gets a second context that starts
+// at the retry state right away instead of waiting for the first state to ask
+// for it. The retry context keeps its compiled kernels back from the driver.
+// Whichever of the two states finishes last joins them: when the first state
+// asked for a retry, the retry context takes over its collected kernels, so
+// the comparison done by NeedsRetry is the same as in the serial flow, and
+// goes on with its retry states. Otherwise the retry result is dropped. No
+// worker ever waits for another one.
+static bool CompileKernelsInParallel(OpenCLProgramContext &oclContext,
+                                     std::vector<std::unique_ptr<OpenCLProgramContext>> &kernelContexts,
+                                     unsigned numThreads, bool speculativeRetry, const IGC::COCLBTILayout &oclLayout,
+                                     const IGC::CDriverInfo &driverInfo, const STB_TranslateInputArgs *pInputArgs,
+                                     STB_TranslateOutputArgs *pOutputArgs, TB_DATA_FORMAT inputDataFormatTemp,
+                                     const IGC::CPlatform &IGCPlatform) {
+  llvm::Module &programModule = *oclContext.getModule();
+  std::vector<std::string> kernelNames;
+  std::vector<llvm::SmallVector<char, 0>> kernelBitcode;
+  for (const auto &F : programModule) {
+    if (F.isDeclaration() || F.getCallingConv() != llvm::CallingConv::SPIR_KERNEL) {
+      continue;
+    }
+    KernelModuleSplitter splitter(oclContext, programModule);
+    splitter.splitModuleForKernel(&F);
+    std::unique_ptr<llvm::Module> kernelModule = splitter.takeSplittedModule();
+    kernelNames.push_back(F.getName().str());
+    kernelBitcode.emplace_back();
+    llvm::raw_svector_ostream OS(kernelBitcode.back());
+    llvm::WriteBitcodeToFile(*kernelModule, OS);
+  }
+  if (IGC_IS_FLAG_ENABLED(PrintParallelKernelCompile)) {
+    fprintf(stderr, "IGC compiles %zu kernels on %u threads\n", kernelNames.size(), numThreads);
+  }
 
-    // Avoid stack overflow in AliasAnalysis for expansive loop unrolling cases.
-    llvm::StringRef aaQueryDepthFlag = "-basic-aa-max-query-depth=192";
-    auto aaQueryDepthSwitch = optionsMap.find(aaQueryDepthFlag.trim("-=192"));
-    if (aaQueryDepthSwitch != optionsMap.end()) {
-      if (aaQueryDepthSwitch->second->getNumOccurrences() == 0) {
-        args.push_back(aaQueryDepthFlag.data());
+  // One slot per kernel and compiled state: slot = kernel * numStates + state.
+  const size_t numStates = speculativeRetry ? 2 : 1;
+  const size_t numSlots = kernelNames.size() * numStates;
+  kernelContexts.resize(numSlots);
+  std::vector<STB_TranslateOutputArgs> kernelOutputs(numSlots);
+  std::vector<char> kernelSucceeded(numSlots, false);
+
+  // Number of states of a kernel that are still compiled. useRetryState tells
+  // whether the first state asked for a retry that the speculative retry
+  // context covers.
+  std::vector<std::atomic<unsigned>> statesLeft(kernelNames.size());
+  for (auto &left : statesLeft) {
+    left = (unsigned)numStates;
+  }
+  std::vector<char> useRetryState(kernelNames.size(), false);
+
+  // Walks the retry states of the kernel in the given slot. The first
+  // CompileProgramModule is skipped when resuming a retry context whose
+  // kernels were handed to the driver by joinRetryState.
+  auto compileStates = [&](size_t slot, llvm::Module *pModule, bool resume) {
+    const size_t idx = slot / numStates;
+    const bool isRetryState = slot % numStates != 0;
+    const llvm::StringRef bitcode(kernelBitcode[idx].data(), kernelBitcode[idx].size());
+    STB_TranslateOutputArgs &output = kernelOutputs[slot];
+    OpenCLProgramContext &ctx = *kernelContexts[slot];
+    while (true) {
+      if (!resume) {
+        if (!pModule->getFunction(kernelNames[idx])) {
+          // The kernel does not need this retry state.
+          break;
+        }
+        if (!CompileProgramModule(ctx, &output)) {
+          return false;
+        }
+        if (ctx.m_deferGatherDataForDriver) {
+          // Finished by joinRetryState.
+          return true;
+        }
+      }
+      resume = false;
+      bool retry = (!ctx.m_retryManager->kernelSet.empty() && ctx.m_retryManager->AdvanceState());
+      if (!retry) {
+        break;
+      }
+      // Functions retried on their own depend on this state's results, so
+      // only a plain kernel retry can be handed over to the speculative state.
+      if (speculativeRetry && !isRetryState && ctx.m_retryManager->PerFuncRetrySet.empty()) {
+        useRetryState[idx] = true;
+        return true;
+      }
+      if (!PrepareForRetry(ctx, pModule, pInputArgs, &output, inputDataFormatTemp, IGCPlatform, bitcode)) {
+        return false;
       }
     }
 
-    llvm::StringRef dsePartialOverwriteTrackingFlag = "-enable-dse-partial-overwrite-tracking=1";
-    auto dsePartialOverwriteTrackingSwitch = optionsMap.find(dsePartialOverwriteTrackingFlag.trim("-=1"));
-    if (dsePartialOverwriteTrackingSwitch != optionsMap.end()) {
-      if (dsePartialOverwriteTrackingSwitch->second->getNumOccurrences() == 0) {
-        args.push_back(dsePartialOverwriteTrackingFlag.data());
+    ctx.failOnSpills();
+    if (ctx.HasError()) {
+      if (output.ErrorString.empty()) {
+        SetOutputMessage(ctx.GetErrorAndWarning(), output);
       }
+      return false;
     }
+    return true;
+  };
 
-    llvm::StringRef dseMSSAStepLimitFlag = "-dse-memoryssa-walklimit=150";
-    auto dseMSSAStepLimitSwitch = optionsMap.find(dseMSSAStepLimitFlag.trim("-=150"));
-    if (dseMSSAStepLimitSwitch != optionsMap.end()) {
-      if (dseMSSAStepLimitSwitch->second->getNumOccurrences() == 0) {
-        args.push_back(dseMSSAStepLimitFlag.data());
+  auto compileKernel = [&](size_t slot) {
+    const size_t idx = slot / numStates;
+    const bool isRetryState = slot % numStates != 0;
+    const llvm::StringRef bitcode(kernelBitcode[idx].data(), kernelBitcode[idx].size());
+    STB_TranslateOutputArgs &output = kernelOutputs[slot];
+    kernelContexts[slot] = std::make_unique<OpenCLProgramContext>(oclLayout, IGCPlatform, pInputArgs, driverInfo);
+    OpenCLProgramContext &ctx = *kernelContexts[slot];
+    ctx.m_ProfilingTimerResolution = oclContext.m_ProfilingTimerResolution;
+    if (oclContext.isSPIRV()) {
+      ctx.setAsSPIRV();
+    }
+    ctx.gtpin_init = oclContext.gtpin_init;
+    ctx.hash = oclContext.hash;
+    ctx.annotater = nullptr;
+    IGC::Debug::RegisterComputeErrHandlers(*ctx.getLLVMContext());
+
+    ctx.m_retryManager->Enable(ShaderType::OPENCL_SHADER);
+    if (isRetryState) {
+      if (!ctx.m_retryManager->AdvanceState()) {
+        // There is no retry state to speculate on.
+        return true;
       }
+      ctx.m_deferGatherDataForDriver = true;
+    }
+
+    llvm::Module *pModule = nullptr;
+    if (!ParseKernelBitcode(pModule, bitcode, output.ErrorString, *ctx.getLLVMContext())) {
+      return false;
+    }
+    ctx.setModule(pModule);
+    if (ctx.isSPIRV()) {
+      deserialize(*ctx.getModuleMetaData(), pModule);
     }
+    SetDefaultDenormModes(ctx);
+    return compileStates(slot, pModule, false);
+  };
 
-    // From pass IndVarSimplify we are only interested in optimization done by -replexitval.
-    // Disable other features that can have a negative impact on performance.
-    std::array<llvm::StringRef, 4> indVarSimplifyFlags = {"-indvars-post-increment-ranges=0", "-disable-lftr=1",
-                                                          "-indvars-widen-indvars=0", "-verify-indvars=0"};
-    for (const auto indVarSimplifyFlag : indVarSimplifyFlags) {
-      auto indVarSimplifySwitch = optionsMap.find(indVarSimplifyFlag.drop_front(1).split("=").first);
-      if (indVarSimplifySwitch != optionsMap.end()) {
-        if (indVarSimplifySwitch->second->getNumOccurrences() == 0) {
-          args.push_back(indVarSimplifyFlag.data());
+  // Exceptions must not leave a worker thread, so they fail the kernel like
+  // any other error of its compile. So do the signals Translate guards
+  // against, which would otherwise jump to a target set on another thread.
+  auto runGuarded = [&](size_t slot, const std::function<bool()> &compile) {
+    STB_TranslateOutputArgs &output = kernelOutputs[slot];
+    auto guardedCompile = [&]() {
+      try {
+        kernelSucceeded[slot] = compile();
+      } catch (std::bad_alloc &e) {
+        (void)e; // not used now
+        kernelSucceeded[slot] = false;
+        SetOutputMessage("IGC: Out Of Memory", output);
+      } catch (std::exception &e) {
+        kernelSucceeded[slot] = false;
+        if (output.ErrorString.empty()) {
+          SetErrorMessage(std::string("IGC: ") + e.what(), output);
         }
       }
+    };
+#if defined(NDEBUG) && !defined(_WIN32)
+    if (int sig = RunWithSignalGuard(guardedCompile)) {
+      UnlockMutex();
+      kernelSucceeded[slot] = false;
+      SetErrorMessage("IGC: Internal Compiler Error: Signal " + std::to_string(sig) + " caught while compiling " +
+                          kernelNames[slot / numStates],
+                      output);
+    }
+#else
+    guardedCompile();
+#endif
+  };
+
+  // Runs once both states of a kernel are done, on the thread that finished
+  // last, and decides what the retry context's kept back kernels are for.
+  auto joinRetryState = [&](size_t idx) {
+    const size_t firstSlot = idx * numStates;
+    const size_t retrySlot = firstSlot + 1;
+    OpenCLProgramContext *retryCtx = kernelContexts[retrySlot].get();
+    if (!retryCtx || !retryCtx->m_deferGatherDataForDriver) {
+      return;
+    }
+    retryCtx->m_deferGatherDataForDriver = false;
+    if (!useRetryState[idx] || !kernelSucceeded[firstSlot] || !kernelSucceeded[retrySlot]) {
+      DiscardDeferredDataForDriver(retryCtx);
+      return;
+    }
+    if (IGC_IS_FLAG_ENABLED(PrintParallelKernelCompile)) {
+      fprintf(stderr, "IGC takes the retry state of %s from its speculative compile\n", kernelNames[idx].c_str());
+    }
+    runGuarded(retrySlot, [&]() {
+      auto &previous = kernelContexts[firstSlot]->getRetryManagerVISA()->previousKernels;
+      auto &current = retryCtx->getRetryManagerVISA()->previousKernels;
+      for (auto &it : previous) {
+        current[it.first] = std::move(it.second);
+      }
+      previous.clear();
+      GatherDeferredDataForDriver(retryCtx);
+      return compileStates(retrySlot, retryCtx->getModule(), true);
+    });
+  };
+
+  auto runSlot = [&](size_t slot) {
+    runGuarded(slot, [&]() { return compileKernel(slot); });
+    const size_t idx = slot / numStates;
+    if (speculativeRetry && --statesLeft[idx] == 0) {
+      joinRetryState(idx);
+    }
+  };
+
+  // Hand out slots to the workers in order.
+  std::atomic<size_t> nextSlot{0};
+  auto worker = [&]() {
+    for (size_t slot = nextSlot++; slot < numSlots; slot = nextSlot++) {
+      runSlot(slot);
+    }
+  };
+  std::vector<std::thread> workers;
+  for (unsigned i = 1; i < std::min<size_t>(numThreads, numSlots); ++i) {
+    workers.emplace_back(worker);
+  }
+  worker();
+  for (auto &w : workers) {
+    w.join();
+  }
+  // A retry context may still hold kernels of the first state it did not
+  // pick. Drop them while the context they were compiled in is alive.
+  for (auto &ctx : kernelContexts) {
+    if (ctx) {
+      ctx->getRetryManagerVISA()->previousKernels.clear();
+      DiscardDeferredDataForDriver(ctx.get());
+    }
+  }
+
+  // Pick the context whose shader programs are used for each kernel.
+  std::vector<OpenCLProgramContext *> selected;
+  for (size_t idx = 0; idx < kernelNames.size(); ++idx) {
+    size_t slot = idx * numStates;
+    if (kernelSucceeded[slot] && useRetryState[idx]) {
+      slot += 1;
+    }
+    if (!kernelSucceeded[slot]) {
+      pOutputArgs->ErrorString = kernelOutputs[slot].ErrorString;
+      return false;
     }
+    selected.push_back(kernelContexts[slot].get());
+  }
+
+  // Merge the per-kernel results. CanCompileKernelsSeparately made sure that
+  // there is no program-scope data to merge.
+  ModuleMetaData *modMD = oclContext.getModuleMetaData();
+  for (size_t idx = 0; idx < kernelNames.size(); ++idx) {
+    OpenCLProgramContext *ctx = selected[idx];
+    OpenCLProgramContext *firstStateCtx = kernelContexts[idx * numStates].get();
 
-    if (std::size(args) > 1) {
-      llvm::cl::ParseCommandLineOptions(std::size(args), &args[0]);
+    auto &programList = ctx->m_programOutput.m_ShaderProgramList;
+    std::move(programList.begin(), programList.end(),
+              std::back_inserter(oclContext.m_programOutput.m_ShaderProgramList));
+    programList.clear();
+
+    if (ctx->m_programOutput.m_pSystemThreadKernelOutput && !oclContext.m_programOutput.m_pSystemThreadKernelOutput) {
+      std::swap(oclContext.m_programOutput.m_pSystemThreadKernelOutput, ctx->m_programOutput.m_pSystemThreadKernelOutput);
+    }
+
+    // Options are only known after unification, and are the same for all kernels.
+    modMD->compOpt = ctx->getModuleMetaData()->compOpt;
+    modMD->csInfo.forcedSIMDSize = ctx->getModuleMetaData()->csInfo.forcedSIMDSize;
+    oclContext.m_enableSimdVariantCompilation |= ctx->m_enableSimdVariantCompilation;
+
+    if (firstStateCtx != ctx && firstStateCtx->HasWarning()) {
+      oclContext.EmitWarning(firstStateCtx->GetWarning().c_str(), NoIRContext);
+    }
+    if (ctx->HasWarning()) {
+      oclContext.EmitWarning(ctx->GetWarning().c_str(), NoIRContext);
     }
   }
+  return true;
+}
+
+bool TranslateBuildSPMD(const STB_TranslateInputArgs *pInputArgs, STB_TranslateOutputArgs *pOutputArgs,
+                        TB_DATA_FORMAT inputDataFormatTemp, const IGC::CPlatform &IGCPlatform,
+                        float profilingTimerResolution, const ShaderHash &inputShHash) {
+  // LLVM options live in a static, process-wide registry. The defaults only
+  // need to be applied again after a VC build reset them, so in the common
+  // case concurrent SPMD builds do not contend on any lock here.
+  ApplyDefaultLLVMOptions();
 
   if (IGC_IS_FLAG_ENABLED(QualityMetricsEnable)) {
     IGC::Debug::SetDebugFlag(IGC::Debug::DebugFlag::SHADER_QUALITY_METRICS, true);
@@ -1171,6 +1755,9 @@ bool TranslateBuildSPMD(const STB_TranslateInputArgs *pInputArgs, STB_TranslateO
 
   USC::SShaderStageBTLayout zeroLayout = USC::g_cZeroShaderStageBTLayout;
   IGC::COCLBTILayout oclLayout(&zeroLayout);
+  // Contexts of kernels compiled by CompileKernelsInParallel. Their shader
+  // programs are moved into oclContext, so they must outlive it.
+  std::vector<std::unique_ptr<OpenCLProgramContext>> kernelContexts;
   OpenCLProgramContext oclContext(oclLayout, IGCPlatform, pInputArgs, *driverInfo, llvmContext);
 
   bool compilerTimeNeedsEnd = false;
@@ -1233,157 +1820,30 @@ bool TranslateBuildSPMD(const STB_TranslateInputArgs *pInputArgs, STB_TranslateO
 
   oclContext.annotater = nullptr;
 
-  // Set default denorm.
-  // Note that those values have been set to FLOAT_DENORM_FLUSH_TO_ZERO
-  CompOptions *compOpt = &oclContext.getModuleMetaData()->compOpt;
-  compOpt->FloatDenormMode16 = FLOAT_DENORM_RETAIN;
-  compOpt->FloatDenormMode32 = FLOAT_DENORM_RETAIN;
-  compOpt->FloatDenormMode64 = FLOAT_DENORM_RETAIN;
-  if (oclContext.platform.hasBFTFDenormMode()) {
-    compOpt->FloatDenormModeBFTF = FLOAT_DENORM_RETAIN;
-  }
+  SetDefaultDenormModes(oclContext);
 
   // TODO: Again, this should not happen on each compilation
 
   bool doSplitModule = oclContext.m_InternalOptions.CompileOneKernelAtTime || IGC_IS_FLAG_ENABLED(CompileOneAtTime);
-  // set retry manager
-  bool retry = false;
-  oclContext.m_retryManager->Enable(ShaderType::OPENCL_SHADER);
-  do {
-    llvm::TinyPtrVector<const llvm::Function *> kernelFunctions;
-    if (doSplitModule) {
-      for (const auto &F : pKernelModule->functions()) {
-        if (F.getCallingConv() == llvm::CallingConv::SPIR_KERNEL) {
-          kernelFunctions.push_back(&F);
-        }
-      }
-
-      if (retry) {
-        fprintf(stderr, "IGC recompiles whole module with different optimization strategy, recompiling all kernels \n");
-      }
-      IGC_ASSERT_EXIT_MESSAGE(kernelFunctions.empty() == false, "No kernels found!");
-      fprintf(stderr, "IGC compiles kernels one by one... (%d total)\n", kernelFunctions.size());
+  unsigned parallelKernelThreads = IGC_GET_FLAG_VALUE(ParallelKernelCompileThreads);
+  bool compileKernelsInParallel = false;
+  if (!doSplitModule && parallelKernelThreads > 1) {
+    std::string reason;
+    compileKernelsInParallel = CanCompileKernelsSeparately(oclContext, *pKernelModule, reason);
+    if (!compileKernelsInParallel && IGC_IS_FLAG_ENABLED(PrintParallelKernelCompile)) {
+      fprintf(stderr, "IGC compiles the program whole: %s\n", reason.c_str());
     }
-
-    // for Module splitting feature; if it's inactive, flow is as normal
-    do {
-      KernelModuleSplitter splitter(oclContext, *pKernelModule);
-      if (doSplitModule) {
-        const llvm::Function *pKernelFunction = kernelFunctions.back();
-
-        fprintf(stderr, "Compiling kernel #%d: %s\n", kernelFunctions.size(), pKernelFunction->getName().data());
-        kernelFunctions.pop_back();
-
-        splitter.splitModuleForKernel(pKernelFunction);
-        splitter.setSplittedModuleInOCLContext();
-      }
-
-      oclContext.getModuleMetaData()->csInfo.forcedSIMDSize |= IGC_GET_FLAG_VALUE(ForceOCLSIMDWidth);
-
-      try {
-        if (IGCLLVM::starts_with(llvm::StringRef(IGCLLVM::getTargetTriple(*oclContext.getModule())), "spir")) {
-          IGC::UnifyIRSPIR(&oclContext);
-        } else // not SPIR
-        {
-          IGC::UnifyIROCL(&oclContext);
-        }
-
-        if (oclContext.HasError()) {
-          if (oclContext.HasWarning()) {
-            SetOutputMessage(oclContext.GetErrorAndWarning(), *pOutputArgs);
-          } else {
-            SetOutputMessage(oclContext.GetError(), *pOutputArgs);
-          }
-          return false;
-        }
-
-        // Compiler Options information available after unification.
-        ModuleMetaData *modMD = oclContext.getModuleMetaData();
-        if (modMD->compOpt.DenormsAreZero) {
-          modMD->compOpt.FloatDenormMode16 = FLOAT_DENORM_FLUSH_TO_ZERO;
-          modMD->compOpt.FloatDenormMode32 = FLOAT_DENORM_FLUSH_TO_ZERO;
-        }
-        if (modMD->compOpt.BFTFDenormsAreZero) {
-          modMD->compOpt.FloatDenormModeBFTF = FLOAT_DENORM_FLUSH_TO_ZERO;
-        }
-        if (IGC_GET_FLAG_VALUE(ForceFastestSIMD)) {
-          oclContext.m_retryManager->AdvanceState();
-          oclContext.m_retryManager->SetFirstStateId(oclContext.m_retryManager->GetRetryId());
-        }
-        // Optimize the IR. This happens once for each program, not per-kernel.
-        IGC::OptimizeIR(&oclContext);
-
-        // Now, perform code generation
-        IGC::CodeGen(&oclContext);
-      } catch (std::bad_alloc &e) {
-        (void)e; // not used now
-        SetOutputMessage("IGC: Out Of Memory", *pOutputArgs);
-        return false;
-      } catch (std::exception &e) {
-        if (pOutputArgs->ErrorString.empty()) {
-          std::string message = "IGC: ";
-          message += oclContext.GetErrorAndWarning();
-          message += '\n';
-          message += e.what();
-          SetErrorMessage(message.c_str(), *pOutputArgs);
-        }
-        return false;
-      }
-
-      retry = (!oclContext.m_retryManager->kernelSet.empty() && oclContext.m_retryManager->AdvanceState());
-
-      if (retry) {
-        splitter.retry();
-        kernelFunctions.clear();
-        oclContext.clearBeforeRetry();
-        oclContext.clear();
-
-        // Create a new LLVMContext
-        oclContext.initLLVMContextWrapper();
-
-        IGC::Debug::RegisterComputeErrHandlers(*oclContext.getLLVMContext());
-
-        if (!ParseInput(pKernelModule, pInputArgs, pOutputArgs->ErrorString, *oclContext.getLLVMContext(),
-                        inputDataFormatTemp, IGCPlatform)) {
-          return false;
-        }
-        oclContext.setModule(pKernelModule);
-
-        // Remove annotations for kernels that do not require recompilation
-        RebuildGlobalAnnotations(oclContext, pKernelModule);
-
-        // Set default denorm since metadata was cleared.
-        // Note that those values have been set to FLOAT_DENORM_FLUSH_TO_ZERO
-        compOpt = &oclContext.getModuleMetaData()->compOpt;
-        compOpt->FloatDenormMode16 = FLOAT_DENORM_RETAIN;
-        compOpt->FloatDenormMode32 = FLOAT_DENORM_RETAIN;
-        compOpt->FloatDenormMode64 = FLOAT_DENORM_RETAIN;
-        if (oclContext.platform.hasBFTFDenormMode()) {
-          compOpt->FloatDenormModeBFTF = FLOAT_DENORM_RETAIN;
-        }
-
-        for (auto it = pKernelModule->getFunctionList().begin(), ie = pKernelModule->getFunctionList().end();
-             it != ie;) {
-          Function *pFunc = &*(it++);
-          // Only retry compilation on kernels that need it.
-          // Skip erasure if the kernel is still referenced (e.g., called as a
-          // device function by another kernel that will be recompiled).
-          // Quoting from the OpenCL C spec: "It is just a regular function call if a __kernel function is called by
-          // another kernel function."
-          if (pFunc->getCallingConv() == llvm::CallingConv::SPIR_KERNEL &&
-              oclContext.m_retryManager->kernelSet.find(pFunc->getName().str()) ==
-                  oclContext.m_retryManager->kernelSet.end() &&
-              pFunc->use_empty()) {
-            pFunc->eraseFromParent();
-            // TODO: Consider running a proper cleanup of
-            // !opencl.kernels metadata entries here instead of
-            // deferring 'null' entries to the "retried"
-            // unification phase.
-          }
-        }
-      }
-    } while (!kernelFunctions.empty());
-  } while (retry);
+  }
+  if (compileKernelsInParallel) {
+    if (!CompileKernelsInParallel(oclContext, kernelContexts, parallelKernelThreads,
+                                  IGC_IS_FLAG_ENABLED(SpeculativeRetryCompile), oclLayout, *driverInfo, pInputArgs,
+                                  pOutputArgs, inputDataFormatTemp, IGCPlatform)) {
+      return false;
+    }
+  } else if (!CompileProgram(oclContext, pKernelModule, doSplitModule, pInputArgs, pOutputArgs, inputDataFormatTemp,
+                             IGCPlatform)) {
+    return false;
+  }
 
   oclContext.failOnSpills();
 
@@ -1450,10 +1910,10 @@ bool TranslateBuildVC(const STB_TranslateInputArgs *pInputArgs, STB_TranslateOut
 
   // Currently, VC compiler effectively uses global variables to store
   // some configuration information. This may lead to problems
-  // during multi-threaded compilations. The mutex below serializes
-  // the whole compilation process.
+  // during multi-threaded compilations. The lock below serializes
+  // the whole VC compilation process (SPMD builds are not affected).
   // This is a temporary measure till a proper re-design is done.
-  const std::lock_guard<std::mutex> lock(llvm_mutex);
+  const VCBuildLock lock;
 
   std::error_code status =
       vc::translateBuild(pInputArgs, pOutputArgs, inputDataFormatTemp, IGCPlatform, profilingTimerResolution);
@@ -1461,6 +1921,32 @@ bool TranslateBuildVC(const STB_TranslateInputArgs *pInputArgs, STB_TranslateOut
 }
 #endif // defined(IGC_VC_ENABLED)
 
+static bool TranslateBuildCompile(const STB_TranslateInputArgs *pInputArgs, STB_TranslateOutputArgs *pOutputArgs,
+                                  TB_DATA_FORMAT inputDataFormatTemp, const IGC::CPlatform &IGCPlatform,
+                                  float profilingTimerResolution, const ShaderHash &inputShHash) {
+#if defined(IGC_VC_ENABLED)
+  // if VC option was specified, go to VC compilation directly.
+  if (pInputArgs->pOptions && (strstr(pInputArgs->pOptions, "-vc-codegen") || strstr(pInputArgs->pOptions, "-cmc"))) {
+    return TranslateBuildVC(pInputArgs, pOutputArgs, inputDataFormatTemp, IGCPlatform, profilingTimerResolution,
+                            inputShHash);
+  }
+#endif // defined(IGC_VC_ENABLED)
+
+  if (inputDataFormatTemp != TB_DATA_FORMAT_SPIR_V) {
+    return TranslateBuildSPMD(pInputArgs, pOutputArgs, inputDataFormatTemp, IGCPlatform, profilingTimerResolution,
+                              inputShHash);
+  }
+
+  // Recognize if SPIR-V module contains SPMD,ESIMD or SPMD+ESIMD code and compile it.
+  std::string errorMessage;
+  bool ret = VLD::TranslateBuildSPMDAndESIMD(pInputArgs, pOutputArgs, inputDataFormatTemp, IGCPlatform,
+                                             profilingTimerResolution, inputShHash, errorMessage);
+  if (!ret && !errorMessage.empty()) {
+    SetErrorMessage(errorMessage, *pOutputArgs);
+  }
+  return ret;
+}
+
 bool TranslateBuild(const STB_TranslateInputArgs *pInputArgs, STB_TranslateOutputArgs *pOutputArgs,
                     TB_DATA_FORMAT inputDataFormatTemp, const IGC::CPlatform &IGCPlatform,
                     float profilingTimerResolution) {
@@ -1495,27 +1981,41 @@ bool TranslateBuild(const STB_TranslateInputArgs *pInputArgs, STB_TranslateOutpu
     WriteSpecConstantsDump(pInputArgs, inputShHash.getAsmHash());
   }
 
-#if defined(IGC_VC_ENABLED)
-  // if VC option was specified, go to VC compilation directly.
-  if (pInputArgs->pOptions && (strstr(pInputArgs->pOptions, "-vc-codegen") || strstr(pInputArgs->pOptions, "-cmc"))) {
-    return TranslateBuildVC(pInputArgs, pOutputArgs, inputDataFormatTemp, IGCPlatform, profilingTimerResolution,
-                            inputShHash);
+  const char *cacheDir = IGC_GET_REGKEYSTRING(KernelCacheDir);
+  if (cacheDir[0] == '\0' || !KernelCache::isCacheable(pInputArgs)) {
+    return TranslateBuildCompile(pInputArgs, pOutputArgs, inputDataFormatTemp, IGCPlatform, profilingTimerResolution,
+                                 inputShHash);
   }
-#endif // defined(IGC_VC_ENABLED)
 
-  if (inputDataFormatTemp != TB_DATA_FORMAT_SPIR_V) {
-    return TranslateBuildSPMD(pInputArgs, pOutputArgs, inputDataFormatTemp, IGCPlatform, profilingTimerResolution,
-                              inputShHash);
+  KernelCache cache(cacheDir, uint64_t(IGC_GET_FLAG_VALUE(KernelCacheMaxSizeMB)) * 1024 * 1024);
+  const std::string key =
+      KernelCache::computeKey(pInputArgs, inputDataFormatTemp, IGCPlatform, profilingTimerResolution);
+  auto printCacheStats = IGCLLVM::make_scope_exit([]() {
+    if (IGC_IS_FLAG_ENABLED(KernelCachePrintStats)) {
+      KernelCache::printStats();
+    }
+  });
+
+  STB_TranslateOutputArgs cachedOutput;
+  const bool hit = cache.load(key, cachedOutput);
+  if (hit && IGC_IS_FLAG_DISABLED(KernelCacheValidate)) {
+    *pOutputArgs = std::move(cachedOutput);
+    return true;
   }
 
-  // Recognize if SPIR-V module contains SPMD,ESIMD or SPMD+ESIMD code and compile it.
-  std::string errorMessage;
-  bool ret = VLD::TranslateBuildSPMDAndESIMD(pInputArgs, pOutputArgs, inputDataFormatTemp, IGCPlatform,
-                                             profilingTimerResolution, inputShHash, errorMessage);
-  if (!ret && !errorMessage.empty()) {
-    SetErrorMessage(errorMessage, *pOutputArgs);
+  if (!TranslateBuildCompile(pInputArgs, pOutputArgs, inputDataFormatTemp, IGCPlatform, profilingTimerResolution,
+                             inputShHash)) {
+    return false;
   }
-  return ret;
+  if (hit) {
+    if (cachedOutput.Output == pOutputArgs->Output && cachedOutput.DebugData == pOutputArgs->DebugData) {
+      return true;
+    }
+    KernelCache::stats().mismatches++;
+    fprintf(stderr, "IGC kernel cache: entry %s differs from the compiled output, replacing it\n", key.c_str());
+  }
+  cache.store(key, *pOutputArgs);
+  return true;
 }
 
 bool CIGCTranslationBlock::Initialize(const STB_CreateArgs *pCreateArgs) {
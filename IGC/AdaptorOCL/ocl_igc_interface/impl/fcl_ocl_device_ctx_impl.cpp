@@ -17,7 +17,8 @@ SPDX-License-Identifier: MIT
 #include "cif/export/library_api.h"
 
 #ifndef WIN32
-jmp_buf sig_jmp_buf;
+// Per thread, so a signal raised during one build returns into that build only.
+thread_local jmp_buf sig_jmp_buf;
 #else
 #include <excpt.h>
 #endif
@@ -10,7 +10,41 @@ SPDX-License-Identifier: MIT
 #include "ocl_igc_interface/impl/igc_ocl_translation_ctx_impl.h"
 
 #ifndef WIN32
-jmp_buf sig_jmp_buf;
+#include <pthread.h>
+#include <cstring>
+#include <functional>
+
+// Per thread, so a signal raised during one build returns into that build only.
+thread_local jmp_buf sig_jmp_buf;
+// Whether sig_jmp_buf holds a live jump target on this thread.
+thread_local bool sig_jmp_armed = false;
+
+namespace TC {
+// Runs body with sig_jmp_buf armed on this thread and returns the signal that
+// interrupted it, or 0. The jump target of an enclosing guard on the same
+// thread is restored afterwards.
+int RunWithSignalGuard(const std::function<void()> &body) {
+  jmp_buf outer;
+  std::memcpy(outer, sig_jmp_buf, sizeof(jmp_buf));
+  const bool outerArmed = sig_jmp_armed;
+  int sig = setjmp(sig_jmp_buf);
+  if (sig == 0) {
+    sig_jmp_armed = true;
+    body();
+  }
+  std::memcpy(sig_jmp_buf, outer, sizeof(jmp_buf));
+  sig_jmp_armed = outerArmed;
+  if (sig != 0) {
+    // longjmp out of the handler leaves the signal blocked, and this thread
+    // goes on to compile other kernels.
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, sig);
+    pthread_sigmask(SIG_UNBLOCK, &set, nullptr);
+  }
+  return sig;
+}
+} // namespace TC
 #endif
 
 #include "cif/macros/enable.h"
@@ -81,5 +115,14 @@ OclTranslationOutputBase *CIF_GET_INTERFACE_CLASS(IgcOclTranslationCtx, 4)::Tran
 #if defined(WIN32)
 int ex_filter(unsigned int code, struct _EXCEPTION_POINTERS *ep) { return EXCEPTION_EXECUTE_HANDLER; }
 #else
-void signalHandler(int sig, siginfo_t *info, void *ucontext) { longjmp(sig_jmp_buf, sig); }
+void signalHandler(int sig, siginfo_t *info, void *ucontext) {
+  // A thread with no build to return to, e.g. one the application owns, gets
+  // the default disposition of the signal.
+  if (!sig_jmp_armed) {
+    signal(sig, SIG_DFL);
+    raise(sig);
+    return;
+  }
+  longjmp(sig_jmp_buf, sig);
+}
 #endif
@@ -419,7 +419,8 @@ OCL_API_CALL void signalHandler(int sig, siginfo_t *info, void *ucontext);
     SET_SIG_HANDLER(SIGSEGV)                                                                                           \
     SET_SIG_HANDLER(SIGTERM)                                                                                           \
     int sig = setjmp(sig_jmp_buf);                                                                                     \
-    if (sig == 0) {
+    if (sig == 0) {                                                                                                    \
+      sig_jmp_armed = true;
 
 #define EX_GUARD_END                                                                                                   \
   }                                                                                                                    \
@@ -427,6 +428,7 @@ OCL_API_CALL void signalHandler(int sig, siginfo_t *info, void *ucontext);
     TC::UnlockMutex();                                                                                                 \
     res = CIF_GET_PIMPL()->GetErrorOutput(outVersion, sig);                                                            \
   }                                                                                                                    \
+  sig_jmp_armed = false;                                                                                               \
   REMOVE_SIG_HANDLER(SIGABRT)                                                                                          \
   REMOVE_SIG_HANDLER(SIGFPE)                                                                                           \
   REMOVE_SIG_HANDLER(SIGILL)                                                                                           \
@@ -10,32 +10,57 @@ SPDX-License-Identifier: MIT
 #define IGC_SIGNAL_GUARD_H
 
 #include <csignal>
+#include <mutex>
 
 namespace IGC::detail {
+// Installs Handler for Signal for the lifetime of the guard, unless the
+// application already installed its own handler. Guards may be alive on
+// several threads at once (concurrent builds), so installation is reference
+// counted and the original disposition is only restored by the last guard.
 class SignalGuard {
 public:
   SignalGuard(int Signal, void (*Handler)(int, siginfo_t *, void *)) : Signal(Signal) {
-    sigaction(Signal, nullptr, &SAOld);
-    if (SAOld.sa_handler == SIG_DFL) {
-      struct sigaction SA;
-      sigemptyset(&SA.sa_mask);
-      SA.sa_sigaction = Handler;
-      SA.sa_flags = 0;
-      sigaction(Signal, &SA, nullptr);
+    std::lock_guard<std::mutex> Lock(getMutex());
+    State &S = getState(Signal);
+    if (S.Users++ == 0) {
+      sigaction(Signal, nullptr, &S.SAOld);
+      if (S.SAOld.sa_handler == SIG_DFL) {
+        struct sigaction SA;
+        sigemptyset(&SA.sa_mask);
+        SA.sa_sigaction = Handler;
+        SA.sa_flags = 0;
+        sigaction(Signal, &SA, nullptr);
+      }
     }
   }
 
   ~SignalGuard() {
-    if (SAOld.sa_handler == SIG_DFL)
-      sigaction(Signal, &SAOld, nullptr);
+    std::lock_guard<std::mutex> Lock(getMutex());
+    State &S = getState(Signal);
+    if (--S.Users == 0 && S.SAOld.sa_handler == SIG_DFL)
+      sigaction(Signal, &S.SAOld, nullptr);
   }
 
   SignalGuard(const SignalGuard &) = delete;
   SignalGuard &operator=(const SignalGuard &) = delete;
 
 private:
+  struct State {
+    unsigned Users = 0;
+    struct sigaction SAOld;
+  };
+
+  static std::mutex &getMutex() {
+    static std::mutex M;
+    return M;
+  }
+
+  static State &getState(int Signal) {
+    static State States[NSIG];
+    return States[Signal];
+  }
+
   const int Signal;
-  struct sigaction SAOld;
 }; // class SignalGuard
 } // namespace IGC::detail
 
@@ -61,6 +61,20 @@ struct BiFDataRecord {
   }
 };
 
+// Record of the closure table generated by BiFManagerTool. For a built-in
+// function, identified by the size and hash of its name, it holds the index
+// of the set of sections needed to link it, its own section included.
+// Records are sorted by name size and then by hash.
+struct BiFClosureRecord {
+  uint64_t nameHash;
+  uint32_t nameSize;
+  uint32_t sectionSet;
+};
+
+inline bool operator<(const BiFClosureRecord &LHS, const BiFClosureRecord &RHS) {
+  return LHS.nameSize != RHS.nameSize ? LHS.nameSize < RHS.nameSize : LHS.nameHash < RHS.nameHash;
+}
+
 class BiFManagerCommon {
 public:
   BiFManagerCommon(llvm::LLVMContext &Context);
@@ -26,8 +26,11 @@ SPDX-License-Identifier: MIT
 #include <llvm/IR/GlobalValue.h>
 #include "common/LLVMWarningsPop.hpp"
 #include "llvmWrapper/TargetParser/Triple.h"
+#include "llvmWrapper/Support/MathExtras.h"
 #include "BiFManagerHandler.hpp"
 
+#include <algorithm>
+#include <optional>
 #include <string>
 #include <list>
 #include <AdaptorOCL/OCL/BuiltinResource.h>
@@ -80,6 +83,61 @@ BiFManagerHandler::BiFManagerHandler(LLVMContext &Context)
 
 BiFManagerHandler::~BiFManagerHandler() {}
 
+// LLVM modules belong to one LLVMContext and every build has its own, so only
+// the context independent part of the stream is kept for the whole process:
+// the stream itself and the bitcode handles of its sections. Each build still
+// lazily parses and materializes just the sections and functions it needs.
+struct BiFManagerHandler::BiFStreamCache {
+  std::unique_ptr<llvm::MemoryBuffer> Buffer;
+  // Bitcode handles of the sections indexed by section ID
+  std::vector<std::optional<llvm::BitcodeModule>> Sections;
+
+  BiFStreamCache() {
+    char Resource[5] = {'-'};
+    _snprintf_s(Resource, sizeof(Resource), sizeof(Resource), "#%d", OCL_BIFBC);
+    Buffer.reset(llvm::LoadBufferFromResource(Resource, "BIFBC"));
+    if (Buffer.get() == nullptr) {
+      return;
+    }
+
+    const char *beginOfStream = Buffer->getBufferStart();
+    const BiFDataRecord *entryRecord = (const BiFDataRecord *)(beginOfStream);
+    const char *entryStreamForModules = (beginOfStream + entryRecord->bufferSize);
+    size_t numSections = entryRecord->bufferSize / sizeof(BiFDataRecord) - 1;
+
+    Sections.resize(numSections);
+    for (size_t i = 0; i < numSections; ++i) {
+      const BiFDataRecord *record = entryRecord + i + 1;
+      if (record->ID < 0 || (size_t)record->ID >= numSections) {
+        continue;
+      }
+      llvm::MemoryBufferRef sectionBuffer(
+          llvm::StringRef(entryStreamForModules + record->bufferStart, record->bufferSize), "");
+      llvm::Expected<std::vector<llvm::BitcodeModule>> ModulesOrErr = llvm::getBitcodeModuleList(sectionBuffer);
+      if (!ModulesOrErr || ModulesOrErr->size() != 1) {
+        llvm::consumeError(ModulesOrErr.takeError());
+        continue;
+      }
+      Sections[record->ID].emplace(ModulesOrErr->front());
+    }
+  }
+};
+
+const BiFManagerHandler::BiFStreamCache &BiFManagerHandler::getBiFStreamCache() {
+  static const BiFStreamCache Cache;
+  return Cache;
+}
+
+llvm::Expected<std::unique_ptr<llvm::Module>> BiFManagerHandler::loadBiFSection(BiFSectionID ID) {
+  const BiFStreamCache &Cache = getBiFStreamCache();
+  if (ID < 0 || (size_t)ID >= Cache.Sections.size() || !Cache.Sections[ID]) {
+    return llvm::createStringError(llvm::inconvertibleErrorCode(), "Invalid BiF section");
+  }
+  // Parse from a copy of the handle, so concurrent builds share nothing mutable.
+  llvm::BitcodeModule Section = *Cache.Sections[ID];
+  return Section.getLazyModule(Context, /*ShouldLazyLoadMetadata=*/false, /*IsImporting=*/false);
+}
+
 void BiFManagerHandler::LinkBiF(llvm::Module &Module) {
   BIF_COMPILER_TIME_START(TIME_OCL_BiFMgr_TOTAL);
   isPtrSizeInBits32 = isModulePtrSize32(&Module);
@@ -165,15 +223,21 @@ void BiFManagerHandler::SetCallbackLinker(
   this->CallbackLinker = CallbackLinker;
 }
 
+const BiFClosureRecord *BiFManagerHandler::findClosureRecord(const std::string &FuncName) const {
+  const BiFClosureRecord *begin = isPtrSizeInBits32 ? std::begin(BiFClosure32) : std::begin(BiFClosure64);
+  const BiFClosureRecord *end = isPtrSizeInBits32 ? std::end(BiFClosure32) : std::end(BiFClosure64);
+
+  BiFClosureRecord key = {getHash(FuncName), (uint32_t)FuncName.size(), 0};
+  const BiFClosureRecord *record = std::lower_bound(begin, end, key);
+  if (record == end || key < *record) {
+    return nullptr;
+  }
+  return record;
+}
+
 void BiFManagerHandler::findAllBuiltins(llvm::Module *pModule, TFunctionsVec &neededBuiltinInstr) {
   std::function<bool(llvm::Function *)> predicate = [&](llvm::Function *pFunc) -> bool {
-    auto funcName = pFunc->getName().str();
-
-    if (isPtrSizeInBits32) {
-      return GetDepList32(funcName)[0] > -1;
-    } else {
-      return GetDepList64(funcName)[0] > -1;
-    }
+    return findClosureRecord(pFunc->getName().str()) != nullptr;
   };
 
   FindAllBuiltins(pModule, predicate, neededBuiltinInstr);
@@ -182,56 +246,44 @@ void BiFManagerHandler::findAllBuiltins(llvm::Module *pModule, TFunctionsVec &ne
 void BiFManagerHandler::preapareBiFSections(llvm::Module &pMainModule, TFunctionsVec &BuiltInNeeded) {
   const char *beginOfStream = this->BufferData.get()->getBufferStart();
 
-  // On begining of stream we keep entry record which has pointer to begin
-  // of modules
-  BiFDataRecord *entryRecord = (BiFDataRecord *)(beginOfStream);
-
-  // Exclude the begin ptr of modules
-  const char *entryStreamForModules = (beginOfStream + entryRecord->bufferSize);
-
   std::map<BiFSectionID, BiFDataRecord *> neededModules;
 
   // Collect all needed Modules which should be prepared for linking
-  auto getModulePtr = [&, beginOfStream, entryStreamForModules](BiFSectionID bifIndexSection) {
+  auto getModulePtr = [&, beginOfStream](BiFSectionID bifIndexSection) {
     BiFDataRecord *recordBifIndex = (BiFDataRecord *)(beginOfStream + (sizeof(BiFDataRecord) * (bifIndexSection + 1)));
 
     return recordBifIndex;
   };
 
-  auto process_deps = [&](const auto &deps) {
-    for (auto dep_i = deps.begin(); dep_i != deps.end(); ++dep_i) {
-      auto bifIndexSection = *dep_i;
-
-      if (neededModules.count(bifIndexSection) > 0) {
-        // Allready loaded section
-        continue;
-      }
-
-      neededModules[bifIndexSection] = getModulePtr(bifIndexSection);
-    }
-  };
-
+  // The closure table already holds every section a built-in function needs,
+  // so the needed sections are the union of their section sets
+  uint64_t neededSections[BiFSectionSetWords] = {};
   for (auto bif_i : BuiltInNeeded) {
-    auto funcName = bif_i->getName().str();
+    const BiFClosureRecord *record = findClosureRecord(bif_i->getName().str());
+    if (record == nullptr) {
+      continue;
+    }
+    const uint64_t *sectionSet = BiFSectionSets[record->sectionSet];
+    for (int i = 0; i < BiFSectionSetWords; ++i) {
+      neededSections[i] |= sectionSet[i];
+    }
+  }
+  // The first section has always been linked together with any built-in
+  // function, keep doing so
+  if (!BuiltInNeeded.empty()) {
+    neededSections[0] |= 1;
+  }
 
-    if (isPtrSizeInBits32) {
-      process_deps(GetDepList32(funcName));
-    } else {
-      process_deps(GetDepList64(funcName));
+  for (int i = 0; i < BiFSectionSetWords; ++i) {
+    for (uint64_t bits = neededSections[i]; bits != 0; bits &= bits - 1) {
+      BiFSectionID bifIndexSection = i * 64 + IGCLLVM::countr_zero(bits);
+      neededModules[bifIndexSection] = getModulePtr(bifIndexSection);
     }
   }
 
   auto LoadModule = [&](BiFDataRecord *record) {
-    // Localize the module in stream
-    const char *bifModuleBegin = (entryStreamForModules + record->bufferStart);
-
-    // Attach a MemoryBuffer in this place
-    auto bifMemBuffer =
-        llvm::MemoryBuffer::getMemBuffer(llvm::StringRef(bifModuleBegin, record->bufferSize), "", false);
-
     // Read this llvm module
-    llvm::Expected<std::unique_ptr<llvm::Module>> ModuleOrErr =
-        getLazyBitcodeModule(bifMemBuffer->getMemBufferRef(), Context);
+    llvm::Expected<std::unique_ptr<llvm::Module>> ModuleOrErr = loadBiFSection(record->ID);
 
     if (llvm::Error EC = ModuleOrErr.takeError()) {
       std::string error_str = "Error lazily loading bitcode for generic builtins,"
@@ -322,9 +374,12 @@ llvm::Module *BiFManagerHandler::builtinSizeModule() {
 }
 
 std::unique_ptr<llvm::MemoryBuffer> BiFManagerHandler::getBiFModuleBuffer() {
-  char Resource[5] = {'-'};
-  _snprintf_s(Resource, sizeof(Resource), sizeof(Resource), "#%d", OCL_BIFBC);
-  return std::unique_ptr<llvm::MemoryBuffer>{llvm::LoadBufferFromResource(Resource, "BIFBC")};
+  const BiFStreamCache &Cache = getBiFStreamCache();
+  if (Cache.Buffer.get() == nullptr) {
+    return nullptr;
+  }
+  // The stream lives as long as the process, so hand out a view instead of a copy
+  return llvm::MemoryBuffer::getMemBuffer(Cache.Buffer->getMemBufferRef(), false);
 }
 
 void BiFManagerHandler::cleanModule(llvm::Module &Base) {
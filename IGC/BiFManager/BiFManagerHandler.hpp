@@ -56,12 +56,26 @@ public:
 
   // Private methods
 private:
+  // Context independent data of the stream, loaded once per process and
+  // shared by all handlers
+  struct BiFStreamCache;
+  static const BiFStreamCache &getBiFStreamCache();
+
   // Function which gets the stream with all sections of built-in functions
   static std::unique_ptr<llvm::MemoryBuffer> getBiFModuleBuffer();
 
+  // Function lazily loads the section of built-in functions into Context
+  // ID : Section ID
+  llvm::Expected<std::unique_ptr<llvm::Module>> loadBiFSection(BiFSectionID ID);
+
   llvm::Module *builtinSizeModule();
   static bool isModulePtrSize32(llvm::Module *pMain);
 
+  // Function finds the closure table record of the built-in function
+  // FuncName : Name of the function
+  // Returns nullptr if FuncName is not a built-in function
+  const BiFClosureRecord *findClosureRecord(const std::string &FuncName) const;
+
   // Function looks for all calls of built-in function in user module
   // pModule : User module
   // neededBuiltinInstr [OUT] : List of needed built-in functions
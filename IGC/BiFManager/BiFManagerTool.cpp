@@ -31,6 +31,7 @@ SPDX-License-Identifier: MIT
 #include "llvmWrapper/Transforms/IPO/StripDeadPrototypes.h"
 #include "BiFManagerTool.hpp"
 
+#include <algorithm>
 #include <string>
 #include <list>
 
@@ -47,85 +48,41 @@ BiFManagerTool::BiFManagerTool(LLVMContext &Context)
 
 BiFManagerTool::~BiFManagerTool() {}
 
-void BiFManagerTool::writeHashMapSingle(llvm::raw_fd_ostream &fileDataHeader, BiFDictionary *ListOfFunctions,
-                                        std::vector<std::string> &listFunc, int MaxDependencyList, int SizeType) {
-  size_t funcNameSize = listFunc[0].size();
-
-  std::string hashMap = "\nconst std::array<int, " + std::to_string(MaxDependencyList) + "> GetDepList" +
-                        std::to_string(SizeType) + "_S" + std::to_string(funcNameSize) +
-                        "(size_t FuncIDHash)\n{\n    switch (FuncIDHash)\n    {";
-  fileDataHeader.write(hashMap.c_str(), hashMap.size());
-
-  std::string hashType = sizeof(size_t) == 4 ? "UL" : "ULL";
-
-  for (auto rec_i = listFunc.begin(); rec_i != listFunc.end();) {
-    std::string funcName = *rec_i;
-    std::string funcKey;
-    funcKey = funcName;
-    auto listOfDependency = ListOfFunctions->operator[](funcKey);
-
-    std::string record = "\n        // bif func: " + funcName;
-    record += "\n        case ";
-    record += std::to_string(getHash(funcName)) + hashType;
-    record += ": { return std::array<int, " + std::to_string(MaxDependencyList) + ">{ ";
-
-    for (size_t i = 0; i < listOfDependency.size(); ++i) {
-      record += std::to_string(listOfDependency[i]);
-
-      if (i + 1 != listOfDependency.size()) {
-        record += ", ";
+void BiFManagerTool::writeClosureTable(llvm::raw_fd_ostream &fileDataHeader, BiFDictionary *ListOfFunctions,
+                                       std::map<std::vector<uint64_t>, uint32_t> &SectionSets, int SizeType) {
+  std::vector<BiFClosureRecord> records;
+  records.reserve(ListOfFunctions->size());
+
+  for (const auto &rec_i : *ListOfFunctions) {
+    const std::string &funcName = rec_i.first;
+
+    // The dependency list is already the transitive closure of the sections
+    // needed by the function, its own section included.
+    std::vector<uint64_t> sectionSet;
+    for (BiFSectionID dep : rec_i.second) {
+      size_t word = dep / 64;
+      if (sectionSet.size() <= word) {
+        sectionSet.resize(word + 1, 0);
       }
+      sectionSet[word] |= 1ULL << (dep % 64);
     }
-    record += " }; }";
-
-    ++rec_i;
 
-    fileDataHeader.write(record.c_str(), record.size());
+    auto set_i = SectionSets.insert({sectionSet, (uint32_t)SectionSets.size()}).first;
+    records.push_back({getHash(funcName), (uint32_t)funcName.size(), set_i->second});
   }
 
-  hashMap = "\n    }\n    return std::array<int, " + std::to_string(MaxDependencyList) + ">{ -1 };\n}";
-  fileDataHeader.write(hashMap.c_str(), hashMap.size());
-}
-
-void BiFManagerTool::writeHashMap(llvm::raw_fd_ostream &fileDataHeader, BiFDictionary *ListOfFunctions,
-                                  int MaxDependencyList, int SizeType) {
-  std::map<size_t, std::vector<std::string>> sortBySizeNameFunc;
-
-  for (auto rec_i = ListOfFunctions->begin(); rec_i != ListOfFunctions->end(); ++rec_i) {
-    const auto &record_inst = *rec_i;
-    const std::string &funcName =
-        record_inst.first;
-    auto funcNameSize = funcName.size();
-
-    if (sortBySizeNameFunc.find(funcNameSize) == sortBySizeNameFunc.end()) {
-      sortBySizeNameFunc.insert({funcNameSize, {funcName}});
-    } else {
-      sortBySizeNameFunc[funcNameSize].push_back(funcName);
-    }
+  std::sort(records.begin(), records.end());
+  for (size_t i = 1; i < records.size(); ++i) {
+    IGC_ASSERT_EXIT_MESSAGE(records[i - 1] < records[i], "[BiFManager] - Hash collision in closure table");
   }
 
-  for (auto rec_i = sortBySizeNameFunc.begin(); rec_i != sortBySizeNameFunc.end(); ++rec_i) {
-    writeHashMapSingle(fileDataHeader, ListOfFunctions, rec_i->second, MaxDependencyList, SizeType);
+  std::string table = "\nconst BiFClosureRecord BiFClosure" + std::to_string(SizeType) + "[] = {";
+  for (const auto &record : records) {
+    table += "\n    { " + std::to_string(record.nameHash) + "ULL, " + std::to_string(record.nameSize) + ", " +
+             std::to_string(record.sectionSet) + " },";
   }
-
-  std::string hashMap = "\nconst std::array<int, " + std::to_string(MaxDependencyList) + "> GetDepList" +
-                        std::to_string(SizeType) + "(std::string& FuncName)\n{\n    switch (FuncName.size())\n    {";
-
-  fileDataHeader.write(hashMap.c_str(), hashMap.size());
-
-  for (auto rec_i = sortBySizeNameFunc.begin(); rec_i != sortBySizeNameFunc.end(); ++rec_i) {
-    size_t funcNameSize = rec_i->first;
-    std::string record = "\n        // bif func name size : " + std::to_string(funcNameSize);
-    record += "\n        case ";
-    record += std::to_string(funcNameSize);
-    record += ": { return GetDepList" + std::to_string(SizeType) + "_S" + std::to_string(funcNameSize) +
-              "(BiFManagerCommon::getHash(FuncName)); }";
-
-    fileDataHeader.write(record.c_str(), record.size());
-  }
-
-  hashMap = "\n    }\n    return std::array<int, " + std::to_string(MaxDependencyList) + ">{ -1 };\n}";
-  fileDataHeader.write(hashMap.c_str(), hashMap.size());
+  table += "\n};\n";
+  fileDataHeader.write(table.c_str(), table.size());
 }
 
 void BiFManagerTool::WriteBitcode(const llvm::StringRef BitCodePath) {
@@ -195,14 +152,35 @@ void BiFManagerTool::WriteHeader(const llvm::StringRef HeaderPath) {
 
   printf("[BiFManager] - Start writing header for bifbc\n");
 
-  writeHashMap(fileDataHeader, &Bif32, Bif32MaxDep, 32);
+  std::map<std::vector<uint64_t>, uint32_t> sectionSets;
+
+  writeClosureTable(fileDataHeader, &Bif32, sectionSets, 32);
   printf("[BiFManager] - Done for BiF32 header for bifbc\n");
 
-  std::string newline = "\n";
-  fileDataHeader.write(newline.c_str(), newline.size());
+  writeClosureTable(fileDataHeader, &Bif64, sectionSets, 64);
+  printf("[BiFManager] - Done for BiF64 header for bifbc\n");
 
-  writeHashMap(fileDataHeader, &Bif64, Bif64MaxDep, 64);
-  printf("[BiFManager] - Done for BiF32 header for bifbc\n");
+  // Every set has room for all sections, so linking can union them word by word
+  size_t setWords = (BiFSections.size() + 63) / 64;
+  std::vector<const std::vector<uint64_t> *> setsByIndex(sectionSets.size());
+  for (const auto &set_i : sectionSets) {
+    setsByIndex[set_i.second] = &set_i.first;
+  }
+
+  std::string sets = "\nconst int BiFSectionSetWords = " + std::to_string(setWords) + ";\n";
+  sets += "const uint64_t BiFSectionSets[][BiFSectionSetWords] = {";
+  for (const auto *set : setsByIndex) {
+    sets += "\n    { ";
+    for (size_t i = 0; i < setWords; ++i) {
+      sets += std::to_string(i < set->size() ? (*set)[i] : 0) + "ULL";
+      if (i + 1 != setWords) {
+        sets += ", ";
+      }
+    }
+    sets += " },";
+  }
+  sets += "\n};\n";
+  fileDataHeader.write(sets.c_str(), sets.size());
 
   assert(Bif32MaxDep == Bif64MaxDep && "[BiFManager] - Mismatch between BiF32 and BiF64");
 }
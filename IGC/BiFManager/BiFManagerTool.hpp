@@ -79,11 +79,11 @@ private:
   // Function generating the splited sections of built-in functions
   void generateSplitedBiFModules(llvm::Module *pMainModule);
 
-  static void writeHashMapSingle(llvm::raw_fd_ostream &fileDataHeader, BiFDictionary *ListOfFunctions,
-                                 std::vector<std::string> &listFunc, int MaxDependencyList, int SizeType);
-
-  static void writeHashMap(llvm::raw_fd_ostream &fileDataHeader, BiFDictionary *ListOfFunctions, int MaxDependencyList,
-                           int SizeType);
+  // Function writes the closure table of the dictionary. The section sets are
+  // deduplicated into SectionSets, which is written once for both tables.
+  // SectionSets [IN/OUT] : Bitsets of sections mapped to their index
+  static void writeClosureTable(llvm::raw_fd_ostream &fileDataHeader, BiFDictionary *ListOfFunctions,
+                                std::map<std::vector<uint64_t>, uint32_t> &SectionSets, int SizeType);
 
   static void markBuiltinFunc(llvm::Module *pM);
 
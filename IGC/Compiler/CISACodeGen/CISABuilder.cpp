@@ -4426,6 +4426,12 @@ void CEncoder::InitVISABuilderOptions(TARGET_PLATFORM VISAPlatform, bool canAbor
   if (IGC_IS_FLAG_ENABLED(SelectiveFastRA) && !hasStackCall) {
     SaveOption(vISA_SelectiveFastRA, true);
   }
+  if (IGC_IS_FLAG_SET(VISACompileTier)) {
+    SaveOption(vISA_CompileTier, IGC_GET_FLAG_VALUE(VISACompileTier));
+  }
+  if (IGC_IS_FLAG_SET(VISACompileBudget)) {
+    SaveOption(vISA_CompileBudget, IGC_GET_FLAG_VALUE(VISACompileBudget));
+  }
   if (IGC_IS_FLAG_ENABLED(PartitionWithFastHybridRA)) {
     SaveOption(vISA_PartitionWithFastHybridRA, true);
   }
@@ -4863,12 +4869,19 @@ void CEncoder::InitVISABuilderOptions(TARGET_PLATFORM VISAPlatform, bool canAbor
        context->getModuleMetaData()->csInfo.enableNewSpillCostFunction)) {
     SaveOption(vISA_NewSpillCostFunction, true);
   }
+  if (IGC_IS_FLAG_ENABLED(LatencySpillCost)) {
+    SaveOption(vISA_LatencySpillCost, true);
+  }
+  if (IGC_IS_FLAG_ENABLED(LoopBoundarySplit)) {
+    SaveOption(vISA_LoopBoundarySplit, true);
+  }
 
   // visaasm in ZeBinary will be used for parsing.
-  // We need to set GenerateISAASM flag for the builder, because otherwise
+  // We need to set LinkableVISA flag for the builder, because otherwise
   // VISAKernelImpl::generateVariableName will generate non-unique names.
+  // Unlike GenerateISAASM it doesn't dump a .visaasm file per kernel.
   if (context->getCompilerOption().EmitZeBinVISASections) {
-    SaveOption(vISA_GenerateISAASM, true);
+    SaveOption(vISA_LinkableVISA, true);
   }
 
   if (context->getModuleMetaData()->compOpt.FastRelaxedMath || context->getModuleMetaData()->compOpt.FiniteMathOnly) {
@@ -5017,7 +5030,11 @@ void CEncoder::InitEncoder(bool canAbortOnSpill, bool hasStackCall, bool hasInli
   m_encoderState.m_secondNibble = false;
   m_enableVISAdump = false;
   m_nestLevelForcedNoMaskRegion = 0;
-  m_hasInlineAsm = hasInlineAsmCall;
+  // Inline asm blocks are parsed straight into the kernel being built, unless
+  // the whole kernel is printed as vISA text anyway to be linked with others.
+  m_parseInlineAsmFragments =
+      hasInlineAsmCall && !hasAdditionalVisaAsmToLink && IGC_IS_FLAG_ENABLED(ParseInlineAsmFragments);
+  m_hasInlineAsm = hasInlineAsmCall && !m_parseInlineAsmFragments;
   m_hasUniqueExclusiveLoad = false;
 
   InitLabelMap(m_program->entry);
@@ -5044,8 +5061,9 @@ void CEncoder::InitEncoder(bool canAbortOnSpill, bool hasStackCall, bool hasInli
   auto builderMode = m_hasInlineAsm || hasAdditionalVisaAsmToLink ? vISA_ASM_WRITER : vISA_DEFAULT;
 
   // Build options. If in Debug mode, always enable VISA IR
-  auto builderOpt =
-      (enableVISADump || m_hasInlineAsm || hasAdditionalVisaAsmToLink) ? VISA_BUILDER_BOTH : VISA_BUILDER_GEN;
+  auto builderOpt = (enableVISADump || m_hasInlineAsm || m_parseInlineAsmFragments || hasAdditionalVisaAsmToLink)
+                        ? VISA_BUILDER_BOTH
+                        : VISA_BUILDER_GEN;
 #if defined(_DEBUG)
   builderOpt = VISA_BUILDER_BOTH;
 #endif
@@ -5106,6 +5124,11 @@ void CEncoder::InitEncoder(bool canAbortOnSpill, bool hasStackCall, bool hasInli
     SaveOption(vISA_MaxGRFNum, upperBoundGRF);
   }
 
+  if (m_parseInlineAsmFragments) {
+    // Inline asm refers to the variables of the kernel by name.
+    SaveOption(vISA_InlineVISAFragments, true);
+  }
+
   // Pass all build options to builder
   SetBuilderOptions(vbuilder);
 
@@ -5794,11 +5817,17 @@ VISAKernel *CEncoder::shaderOverrideVISASecondPassOrInlineAsm(bool visaAsmOverri
     }
 
     if (result == 0 && additionalVISAAsmToLink) {
-      std::stringstream ss;
-      result = vAsmTextBuilder->ParseVISAText(vbuilder->GetAsmTextStream().str(), "");
-      for (auto visaAsm : *additionalVISAAsmToLink) {
-        result = (result == 0) ? vAsmTextBuilder->ParseVISAText(visaAsm, "") : result;
+      // Parse this module and the ones linked to it in one go, so the vISA
+      // verifier runs once instead of after every module.
+      std::string asmText;
+      std::vector<const char *> visaTexts;
+      if (!m_hasInlineAsm) {
+        asmText = vbuilder->GetAsmTextStream().str();
+        visaTexts.push_back(asmText.c_str());
       }
+      visaTexts.insert(visaTexts.end(), additionalVISAAsmToLink->begin(), additionalVISAAsmToLink->end());
+      unsigned failedText = 0;
+      result = vAsmTextBuilder->ParseLinkedVISAText(visaTexts, failedText);
 
       if (result == 0) {
         // Mark invoke_simd targets with LTO_InvokeOptTarget attribute.
@@ -5914,6 +5943,15 @@ void CEncoder::Compile(bool hasSymbolTable, GenXFunctionGroupAnalysis *&pFGA) {
     m_vIsaCompileStatus = vbuilder->Compile(m_enableVISAdump ? GetDumpFileName("isaasm").c_str() : "", emitVisaOnly);
   }
 
+  if (vISA::trace::isEnabled()) {
+    // The args go to the innermost open span, which is the vISACompile one.
+    std::ostringstream hash;
+    hash << "0x" << std::hex << std::setw(16) << std::setfill('0') << context->hash.getAsmHash();
+    vISA::trace::addArg("kernel", m_program->entry->getName().str());
+    vISA::trace::addArg("hash", hash.str());
+    vISA::trace::addArg("simd", numLanes(m_program->m_State.m_dispatchSize));
+    vISA::trace::addArg("spill_size", jitInfo->stats.spillMemUsed);
+  }
   COMPILER_TIME_END(m_program->GetContext(), TIME_CG_vISACompile);
 
 #if GET_TIME_STATS
@@ -7452,6 +7490,11 @@ std::string CEncoder::GetVariableName(CVariable *var) {
   }
 }
 
+bool CEncoder::ParseInlineAsm(const std::string &asmStr) {
+  IGC_ASSERT(m_parseInlineAsmFragments);
+  return vbuilder->ParseVISAFragment(vKernel, asmStr) == VISA_SUCCESS;
+}
+
 std::string CEncoder::GetDumpFileName(std::string extension) {
   std::string filename = IGC::Debug::GetDumpNameObj(m_program, extension.c_str()).str();
   return filename;
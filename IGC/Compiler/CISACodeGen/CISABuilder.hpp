@@ -459,6 +459,9 @@ public:
   void AddVISASymbol(std::string &symName, CVariable *cvar);
 
   std::string GetVariableName(CVariable *var);
+  bool ParsesInlineAsmFragments() const { return m_parseInlineAsmFragments; }
+  // Parses one inline asm block into the current kernel.
+  bool ParseInlineAsm(const std::string &asmStr);
   std::string GetDumpFileName(std::string extension);
 
   bool IsPayloadSectionAsPrimary() { return vKernel == vPayloadSection; }
@@ -704,7 +707,10 @@ protected:
   int m_nestLevelForcedNoMaskRegion = 0;
 
   bool m_enableVISAdump = false;
+  // Inline asm goes through the whole kernel's vISA text
   bool m_hasInlineAsm = false;
+  // Inline asm blocks are parsed one by one into the kernel
+  bool m_parseInlineAsmFragments = false;
 
   std::vector<VISA_LabelOpnd *> labelMap;
   std::vector<CName> labelNameMap; // parallel to labelMap
@@ -478,6 +478,10 @@ bool CatchAllLineNumber::run(llvm::Function &F) {
 #if LLVM_VERSION_MAJOR >= 16
 PreservedAnalyses CatchAllLineNumberNPM::run(Function &F, FunctionAnalysisManager &AM) {
   bool changed = CatchAllLineNumber().run(F);
-  return changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+  if (!changed)
+    return PreservedAnalyses::all();
+  PreservedAnalyses PA;
+  PA.preserveSet<CFGAnalyses>();
+  return PA;
 }
 #endif // LLVM_VERSION_MAJOR >= 16
@@ -10262,7 +10262,6 @@ bool EmitPass::validateInlineAsmConstraints(llvm::CallInst *inst, SmallVector<St
 //   "mul (M1, 16) $0(0, 0)<1> $1(0, 0)<1;1,0> $2(0, 0)<1;1,0>",
 //   "=r,r,r"(float %6, float %7)
 void EmitPass::EmitInlineAsm(llvm::CallInst *inst) {
-  std::stringstream &str = m_encoder->GetVISABuilder()->GetAsmTextStream();
   InlineAsm *IA = cast<InlineAsm>(IGCLLVM::getCalledValue(inst));
   string asmStr = IGCLLVM::getAsmString(IA);
   smallvector<CVariable *, 8> opnds;
@@ -10396,7 +10395,6 @@ void EmitPass::EmitInlineAsm(llvm::CallInst *inst) {
     }
   }
 
-  str << endl << "/// Inlined ASM" << endl;
   // Look for variables to replace with the VISA variable
   size_t startPos = 0;
   while (startPos < asmStr.size()) {
@@ -10431,6 +10429,17 @@ void EmitPass::EmitInlineAsm(llvm::CallInst *inst) {
     startPos = varPos + varName.size();
   }
 
+  if (m_encoder->ParsesInlineAsmFragments()) {
+    if (!m_encoder->ParseInlineAsm(asmStr)) {
+      std::string msg =
+          "parsing vISA inline assembly failed:\n" + m_encoder->GetVISABuilder()->GetCriticalMsg();
+      m_pCtx->EmitError(msg.c_str(), inst);
+    }
+    return;
+  }
+
+  std::stringstream &str = m_encoder->GetVISABuilder()->GetAsmTextStream();
+  str << endl << "/// Inlined ASM" << endl;
   str << asmStr;
   if (asmStr.back() != '\n')
     str << endl;
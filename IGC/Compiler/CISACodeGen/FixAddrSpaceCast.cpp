@@ -76,7 +76,11 @@ IGC_INITIALIZE_PASS_END(AddrSpaceCastFixingLPM, PASS_FLAG, PASS_DESC, PASS_CFG_O
 llvm::PreservedAnalyses AddrSpaceCastFixingNPM::run(llvm::Function &F, llvm::FunctionAnalysisManager &AM) {
   AddrSpaceCastFixing impl;
   bool changed = impl.runOnFunction(F);
-  return changed ? llvm::PreservedAnalyses::none() : llvm::PreservedAnalyses::all();
+  if (!changed)
+    return llvm::PreservedAnalyses::all();
+  llvm::PreservedAnalyses PA;
+  PA.preserveSet<llvm::CFGAnalyses>();
+  return PA;
 }
 #endif // LLVM_VERSION_MAJOR >= 16
 } // namespace IGC
@@ -18,6 +18,7 @@ SPDX-License-Identifier: MIT
 #include "common/igc_regkeys.hpp"
 #include "llvmWrapper/IR/Function.h"
 
+#include <algorithm>
 #include <fstream>
 #include <queue>
 #include <regex>
@@ -254,34 +255,95 @@ PressurePair IGCLivenessAnalysisBase::estimateSizeInBytes(ValueSet &Set, Functio
   return Result;
 }
 
-void IGCLivenessAnalysisBase::collectPressureForBB(llvm::BasicBlock &BB, InsideBlockPressureMap &BBListing,
-                                                   unsigned int SIMD, WIAnalysisRunner *WI) {
+// walks the block bottom-up and reports the pressure right after each
+// instruction, starting from the values that are live out of the block
+template <typename CallbackT>
+static void walkPressureForBB(IGCLivenessAnalysisBase &Base, llvm::BasicBlock &BB, unsigned int SIMD,
+                              WIAnalysisRunner *WI, CallbackT Callback) {
 
   const DataLayout &DL = BB.getParent()->getParent()->getDataLayout();
-  ValueSet &BBOut = Out[&BB];
+  ValueSet &BBOut = Base.Out[&BB];
   // this should be a copy
   ValueSet BBSet = BBOut;
 
-  PressurePair SizeInBytes = estimateSizeInBytes(BBSet, *BB.getParent(), SIMD, WI);
+  PressurePair SizeInBytes = Base.estimateSizeInBytes(BBSet, *BB.getParent(), SIMD, WI);
 
   for (auto RI = BB.rbegin(), RE = BB.rend(); RI != RE; ++RI) {
 
     llvm::Instruction *Inst = &(*RI);
 
     PressurePair SizeUpdate = {};
-    SizeUpdate = addOperandsToSet(Inst, BBSet, SIMD, WI, DL);
+    SizeUpdate = Base.addOperandsToSet(Inst, BBSet, SIMD, WI, DL);
 
-    BBListing[Inst] = SizeInBytes;
+    Callback(Inst, SizeInBytes);
     SizeInBytes += SizeUpdate;
 
     if (!BBSet.count(Inst))
       continue;
-    PressurePair InstSizeInBytes = computeSizeInBytes(Inst, SIMD, WI, DL);
+    PressurePair InstSizeInBytes = Base.computeSizeInBytes(Inst, SIMD, WI, DL);
     SizeInBytes -= InstSizeInBytes;
     BBSet.erase(Inst);
   }
 }
 
+void IGCLivenessAnalysisBase::collectPressureForBB(llvm::BasicBlock &BB, InsideBlockPressureMap &BBListing,
+                                                   unsigned int SIMD, WIAnalysisRunner *WI) {
+  walkPressureForBB(*this, BB, SIMD, WI,
+                    [&BBListing](llvm::Instruction *Inst, PressurePair Pressure) { BBListing[Inst] = Pressure; });
+}
+
+PressurePair IGCLivenessAnalysisBase::computeMaxPressureForBB(llvm::BasicBlock &BB, unsigned int SIMD,
+                                                              WIAnalysisRunner *WI) {
+  PressurePair MaxSizeInBytes = {};
+  walkPressureForBB(*this, BB, SIMD, WI, [&MaxSizeInBytes](llvm::Instruction *, PressurePair Pressure) {
+    MaxSizeInBytes = std::max(MaxSizeInBytes, Pressure);
+  });
+  return MaxSizeInBytes;
+}
+
+PressurePair IGCLivenessAnalysisRunner::getMaxPressurePairForBB(llvm::BasicBlock &BB, unsigned int SIMD,
+                                                                WIAnalysisRunner *WI) {
+  auto &Entries = PressureCache[&BB];
+  auto It = std::find_if(Entries.begin(), Entries.end(),
+                         [&](const BBPressureEntry &E) { return E.SIMD == SIMD && E.WI == WI; });
+  if (It != Entries.end())
+    return It->MaxPressure;
+  Entries.push_back({SIMD, WI, computeMaxPressureForBB(BB, SIMD, WI)});
+  return Entries.back().MaxPressure;
+}
+
+// pressure inside a block depends only on its instructions and the values
+// that are live out of it. Outside of BBs the instructions are the same and
+// the sets only grow, so a block keeps its cached maximum as long as the size
+// of its live-out set is the same
+void IGCLivenessAnalysisRunner::rerunLivenessAnalysis(llvm::Function &F, BBSet *BBs) {
+  if (BBs == nullptr) {
+    clearLiveness();
+    PressureCache.clear();
+    livenessAnalysis(F, nullptr);
+    return;
+  }
+
+  llvm::SmallVector<std::pair<llvm::BasicBlock *, size_t>, 32> CachedOutSizes;
+  for (auto &Entry : PressureCache) {
+    if (!BBs->count(Entry.first))
+      CachedOutSizes.push_back({Entry.first, Out[Entry.first].size()});
+  }
+
+  for (BasicBlock *BB : *BBs) {
+    In[BB].clear();
+    Out[BB].clear();
+    InPhi[BB].clear();
+    PressureCache.erase(BB);
+  }
+  livenessAnalysis(F, BBs);
+
+  for (auto &Entry : CachedOutSizes) {
+    if (Out[Entry.first].size() != Entry.second)
+      PressureCache.erase(Entry.first);
+  }
+}
+
 bool IGCLivenessAnalysis::runOnFunction(llvm::Function &F) {
   auto *FGA = getAnalysisIfAvailable<GenXFunctionGroupAnalysis>();
   auto *MDUtils = getAnalysis<MetaDataUtilsWrapper>().getMetaDataUtils();
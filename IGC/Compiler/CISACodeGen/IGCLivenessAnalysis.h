@@ -17,6 +17,7 @@ SPDX-License-Identifier: MIT
 #include "common/LLVMWarningsPush.hpp"
 #include <llvm/Config/llvm-config.h>
 #include <llvm/ADT/PostOrderIterator.h>
+#include <llvm/ADT/SmallVector.h>
 #include <llvm/IR/DIBuilder.h>
 #include <llvm/IR/Function.h>
 #include <llvm/Pass.h>
@@ -96,6 +97,7 @@ public:
                                    unsigned int SIMD, WIAnalysisRunner *WI = nullptr);
   void collectPressureForBB(llvm::BasicBlock &BB, InsideBlockPressureMap &BBListing, unsigned int SIMD,
                             WIAnalysisRunner *WI = nullptr);
+  PressurePair computeMaxPressureForBB(llvm::BasicBlock &BB, unsigned int SIMD, WIAnalysisRunner *WI = nullptr);
 
   PressurePair bytesToRegisters(PressurePair Pair) {
     PressurePair Result = {};
@@ -160,28 +162,12 @@ public:
     return (it != modMD->FuncMD.end()) ? it->second.maxRegNonUniformPressure + it->second.maxRegUniformPressure : 0;
   }
 
-  PressurePair getMaxPressurePairForBB(llvm::BasicBlock &BB, unsigned int SIMD, WIAnalysisRunner *WI = nullptr) {
-    InsideBlockPressureMap PressureMap;
-    collectPressureForBB(BB, PressureMap, SIMD, WI);
-
-    PressurePair MaxSizeInBytes = {};
-    for (const auto &Pair : PressureMap) {
-
-      MaxSizeInBytes = std::max(MaxSizeInBytes, Pair.second);
-    }
-    return MaxSizeInBytes;
-  }
+  // returns the maximum pressure inside the block in bytes, the result is
+  // cached until the block or its live-out set changes
+  PressurePair getMaxPressurePairForBB(llvm::BasicBlock &BB, unsigned int SIMD, WIAnalysisRunner *WI = nullptr);
 
   unsigned int getMaxRegCountForBB(llvm::BasicBlock &BB, unsigned int SIMD, WIAnalysisRunner *WI = nullptr) {
-    InsideBlockPressureMap PressureMap;
-    collectPressureForBB(BB, PressureMap, SIMD, WI);
-
-    PressurePair MaxSizeInBytes = {};
-    for (const auto &Pair : PressureMap) {
-
-      MaxSizeInBytes = std::max(MaxSizeInBytes, Pair.second);
-    }
-    return bytesToRegisters(MaxSizeInBytes);
+    return bytesToRegisters(getMaxPressurePairForBB(BB, SIMD, WI));
   }
 
   PressurePair getMaxPressurePairForFunction(llvm::Function &F, unsigned int SIMD, WIAnalysisRunner *WI = nullptr) {
@@ -231,9 +217,8 @@ public:
   }
 
   void releaseMemory() {
-    In.clear();
-    InPhi.clear();
-    Out.clear();
+    clearLiveness();
+    PressureCache.clear();
   }
 
   // if you need to recompute pressure analysis after modifications were made
@@ -244,17 +229,23 @@ public:
   // ...
   // rerunLivenessAnalysis()
   // collectPressureForBB()
-  void rerunLivenessAnalysis(llvm::Function &F, BBSet *BBs = nullptr) {
-    if (BBs != nullptr) {
-      for (BasicBlock *BB : *BBs) {
-        In[BB].clear();
-        Out[BB].clear();
-        InPhi[BB].clear();
-      }
-    } else {
-      releaseMemory();
-    }
-    livenessAnalysis(F, BBs);
+  // BBs must hold every block whose instructions were changed, cached per
+  // block maximums are dropped for them and for the blocks whose live-out
+  // set grew during the rerun
+  void rerunLivenessAnalysis(llvm::Function &F, BBSet *BBs = nullptr);
+
+private:
+  struct BBPressureEntry {
+    unsigned int SIMD = 0;
+    WIAnalysisRunner *WI = nullptr;
+    PressurePair MaxPressure = {};
+  };
+  std::unordered_map<llvm::BasicBlock *, llvm::SmallVector<BBPressureEntry, 2>> PressureCache;
+
+  void clearLiveness() {
+    In.clear();
+    InPhi.clear();
+    Out.clear();
   }
 };
 
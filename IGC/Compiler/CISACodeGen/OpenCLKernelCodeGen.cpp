@@ -2398,52 +2398,13 @@ static void CodeGen(OpenCLProgramContext *ctx, CShaderProgram::KernelShaderMap &
   DumpLLVMIR(ctx, "codegen");
 }
 
-void CodeGen(OpenCLProgramContext *ctx) {
 #ifndef DX_ONLY_IGC
 #ifndef VK_ONLY_IGC
-  // Do program-wide code generation.
-  // Currently, this just creates the program-scope patch stream.
-  if (ctx->m_retryManager->IsFirstTry()) {
-    CollectProgramInfo(ctx);
-  }
-
+// Hands the kernels compiled by CodeGen to the driver, and collects the ones
+// that need to be retried.
+static void GatherKernelsForDriver(OpenCLProgramContext *ctx, CShaderProgram::KernelShaderMap &shaders) {
   MetaDataUtils *pMdUtils = ctx->getMetaDataUtils();
 
-  // Clear spill parameters of retry manager in the very begining of code gen
-  ctx->m_retryManager->ClearSpillParams();
-  // early retry kernel set should always be empty before compilation
-  ctx->m_retryManager->earlyRetryKernelSet.clear();
-
-  CShaderProgram::KernelShaderMap shaders;
-  CodeGen(ctx, shaders);
-
-  if (ctx->m_programOutput.m_pSystemThreadKernelOutput == nullptr) {
-    const auto options = ctx->m_InternalOptions;
-    if (options.IncludeSIPCSR || options.IncludeSIPKernelDebug || options.IncludeSIPKernelDebugWithLocalMemory ||
-        options.KernelDebugEnable) {
-      DWORD systemThreadMode = 0;
-
-      if (options.IncludeSIPCSR) {
-        systemThreadMode |= USC::SYSTEM_THREAD_MODE_CSR;
-      }
-
-      if (options.KernelDebugEnable || options.IncludeSIPKernelDebug) {
-        systemThreadMode |= USC::SYSTEM_THREAD_MODE_DEBUG;
-      }
-
-      if (options.IncludeSIPKernelDebugWithLocalMemory) {
-        systemThreadMode |= USC::SYSTEM_THREAD_MODE_DEBUG_LOCAL;
-      }
-
-      bool success = SIP::CSystemThread::CreateSystemThreadKernel(
-          ctx->platform, (USC::SYSTEM_THREAD_MODE)systemThreadMode, ctx->m_programOutput.m_pSystemThreadKernelOutput);
-
-      if (!success) {
-        ctx->EmitError("System thread kernel could not be created!", NoIRContext);
-      }
-    }
-  }
-
   // Clear the retry set and collect kernels for retry in the loop below.
   ctx->m_retryManager->kernelSet.clear();
 
@@ -2520,10 +2481,78 @@ void CodeGen(OpenCLProgramContext *ctx) {
   // The skip set to avoid retry is not needed. Clear it and collect a new set
   // during retry compilation.
   ctx->m_retryManager->kernelSkip.clear();
+}
+#endif // ifndef VK_ONLY_IGC
+#endif // ifndef DX_ONLY_IGC
+
+void CodeGen(OpenCLProgramContext *ctx) {
+#ifndef DX_ONLY_IGC
+#ifndef VK_ONLY_IGC
+  // Do program-wide code generation.
+  // Currently, this just creates the program-scope patch stream.
+  if (ctx->m_retryManager->IsFirstTry()) {
+    CollectProgramInfo(ctx);
+  }
+
+  // Clear spill parameters of retry manager in the very begining of code gen
+  ctx->m_retryManager->ClearSpillParams();
+  // early retry kernel set should always be empty before compilation
+  ctx->m_retryManager->earlyRetryKernelSet.clear();
+
+  CShaderProgram::KernelShaderMap shaders;
+  CodeGen(ctx, shaders);
+
+  if (ctx->m_programOutput.m_pSystemThreadKernelOutput == nullptr) {
+    const auto options = ctx->m_InternalOptions;
+    if (options.IncludeSIPCSR || options.IncludeSIPKernelDebug || options.IncludeSIPKernelDebugWithLocalMemory ||
+        options.KernelDebugEnable) {
+      DWORD systemThreadMode = 0;
+
+      if (options.IncludeSIPCSR) {
+        systemThreadMode |= USC::SYSTEM_THREAD_MODE_CSR;
+      }
+
+      if (options.KernelDebugEnable || options.IncludeSIPKernelDebug) {
+        systemThreadMode |= USC::SYSTEM_THREAD_MODE_DEBUG;
+      }
+
+      if (options.IncludeSIPKernelDebugWithLocalMemory) {
+        systemThreadMode |= USC::SYSTEM_THREAD_MODE_DEBUG_LOCAL;
+      }
+
+      bool success = SIP::CSystemThread::CreateSystemThreadKernel(
+          ctx->platform, (USC::SYSTEM_THREAD_MODE)systemThreadMode, ctx->m_programOutput.m_pSystemThreadKernelOutput);
+
+      if (!success) {
+        ctx->EmitError("System thread kernel could not be created!", NoIRContext);
+      }
+    }
+  }
+
+  if (ctx->m_deferGatherDataForDriver) {
+    ctx->m_deferredShaders = std::move(shaders);
+    return;
+  }
+  GatherKernelsForDriver(ctx, shaders);
+#endif // ifndef VK_ONLY_IGC
+#endif // ifndef DX_ONLY_IGC
+}
+
+void GatherDeferredDataForDriver(OpenCLProgramContext *ctx) {
+#ifndef DX_ONLY_IGC
+#ifndef VK_ONLY_IGC
+  CShaderProgram::KernelShaderMap shaders = std::move(ctx->m_deferredShaders);
+  ctx->m_deferredShaders.clear();
+  GatherKernelsForDriver(ctx, shaders);
 #endif // ifndef VK_ONLY_IGC
 #endif // ifndef DX_ONLY_IGC
 }
 
+void DiscardDeferredDataForDriver(OpenCLProgramContext *ctx) {
+  destroyShaderMap(ctx->m_deferredShaders);
+  ctx->m_deferredShaders.clear();
+}
+
 bool COpenCLKernel::hasReadWriteImage(llvm::Function &F) {
   if (!isEntryFunc(m_pMdUtils, &F)) {
     // Ignore read/write flags for subroutines for now.
@@ -45,6 +45,12 @@ public:
   // Functions that are forced to be direct calls.
   std::unordered_set<std::string> m_DirectCallFunctions;
   SComputeShaderWalkOrder m_walkOrderStruct;
+  // When set, CodeGen keeps the compiled kernels in m_deferredShaders instead
+  // of handing them to the driver. Speculative retry compilation uses it to
+  // compare them with the previous retry state of the same kernel once that
+  // state is done, see GatherDeferredDataForDriver.
+  bool m_deferGatherDataForDriver = false;
+  CShaderProgram::KernelShaderMap m_deferredShaders;
 
   OpenCLProgramContext(const COCLBTILayout &btiLayout, const CPlatform &platform,
                        const TC::STB_TranslateInputArgs *pInputArgs, const CDriverInfo &driverInfo,
@@ -239,4 +245,8 @@ private:
 };
 
 void CodeGen(OpenCLProgramContext *ctx);
+// Hands the kernels kept by CodeGen under m_deferGatherDataForDriver to the
+// driver, or drops them.
+void GatherDeferredDataForDriver(OpenCLProgramContext *ctx);
+void DiscardDeferredDataForDriver(OpenCLProgramContext *ctx);
 } // namespace IGC
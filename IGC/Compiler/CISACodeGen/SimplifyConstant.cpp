@@ -718,6 +718,11 @@ bool PromoteConstantLPM::runOnFunction(Function &F) {
 llvm::PreservedAnalyses IGC::PromoteConstantNPM::run(llvm::Function &F, llvm::FunctionAnalysisManager &AM) {
   LoopInfo &LI = AM.getResult<llvm::LoopAnalysis>(F);
   bool changed = promoteConstants(F, LI);
-  return changed ? llvm::PreservedAnalyses::none() : llvm::PreservedAnalyses::all();
+  if (!changed)
+    return llvm::PreservedAnalyses::all();
+  llvm::PreservedAnalyses PA;
+  PA.preserveSet<llvm::CFGAnalyses>();
+  PA.preserve<llvm::LoopAnalysis>();
+  return PA;
 }
 #endif // LLVM_VERSION_MAJOR >= 16
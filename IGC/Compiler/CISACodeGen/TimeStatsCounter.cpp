@@ -73,9 +73,13 @@ bool TimeStatsCounter::run() {
     }
   } else {
     if (mode == STATS_COUNTER_START) {
+      if (igcPassSpan)
+        vISA::trace::begin(*igcPassSpan);
       COMPILER_TIME_PASS_START(ctx, igcPass);
     } else {
       COMPILER_TIME_PASS_END(ctx, igcPass);
+      if (igcPassSpan)
+        vISA::trace::end(*igcPassSpan);
     }
   }
   return false;
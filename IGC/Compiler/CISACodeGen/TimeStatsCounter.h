@@ -14,6 +14,7 @@ SPDX-License-Identifier: MIT
 #include "common/LLVMWarningsPop.hpp"
 #include "Compiler/CodeGenPublic.h"
 #include "common/Stats.hpp"
+#include <optional>
 #include <string>
 
 namespace IGC {
@@ -29,6 +30,8 @@ class TimeStatsCounter {
   COMPILE_TIME_INTERVALS interval{};
   TimeStatsCounterStartEndMode mode{};
   std::string igcPass{};
+  // Set only when the compilation that adds the pass is traced.
+  std::optional<vISA::trace::SpanID> igcPassSpan{};
   TimeStatsCounterType type{};
 
 public:
@@ -36,7 +39,11 @@ public:
   TimeStatsCounter(CodeGenContext *_ctx, COMPILE_TIME_INTERVALS _interval, TimeStatsCounterStartEndMode _mode)
       : ctx(_ctx), interval(_interval), mode(_mode), type(STATS_COUNTER_ENUM_TYPE) {}
   TimeStatsCounter(CodeGenContext *_ctx, const std::string &_igcPass, TimeStatsCounterStartEndMode _mode)
-      : ctx(_ctx), mode(_mode), igcPass(_igcPass), type(STATS_COUNTER_LLVM_PASS) {}
+      : ctx(_ctx), mode(_mode), igcPass(_igcPass), type(STATS_COUNTER_LLVM_PASS) {
+    if (vISA::trace::isRecording()) {
+      igcPassSpan = vISA::trace::intern(igcPass, "pass");
+    }
+  }
 
   bool run();
 };
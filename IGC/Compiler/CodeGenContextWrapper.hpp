@@ -51,6 +51,12 @@ private:
 // so the CodeGenContext* is wrapped rather than returned bare.
 struct CodeGenContextResult {
   CodeGenContext *Ctx = nullptr;
+
+  // Like the legacy ImmutablePass, the result never goes stale; without this
+  // it would be recomputed after every pass that changes the module.
+  bool invalidate(llvm::Module &, const llvm::PreservedAnalyses &, llvm::ModuleAnalysisManager::Invalidator &) {
+    return false;
+  }
 };
 
 // New Pass Manager analysis exposing the CodeGenContext to ported passes.
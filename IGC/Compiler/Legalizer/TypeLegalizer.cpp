@@ -56,7 +56,11 @@ llvm::PreservedAnalyses TypeLegalizerNPM::run(llvm::Function &F, llvm::FunctionA
   TypeLegalizer Legalizer;
   DominatorTree &DT = AM.getResult<llvm::DominatorTreeAnalysis>(F);
   bool changed = Legalizer.runImpl(F, DT);
-  return changed ? llvm::PreservedAnalyses::none() : llvm::PreservedAnalyses::all();
+  if (!changed)
+    return llvm::PreservedAnalyses::all();
+  llvm::PreservedAnalyses PA;
+  PA.preserveSet<llvm::CFGAnalyses>();
+  return PA;
 }
 #endif // LLVM_VERSION_MAJOR >= 16
 
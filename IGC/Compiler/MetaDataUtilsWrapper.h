@@ -67,6 +67,12 @@ private:
 struct MetaDataUtilsResult {
   IGCMD::MetaDataUtils *MdUtils = nullptr;
   ModuleMetaData *ModMD = nullptr;
+
+  // Like the legacy ImmutablePass, the result never goes stale; without this
+  // it would be recomputed after every pass that changes the module.
+  bool invalidate(llvm::Module &, const llvm::PreservedAnalyses &, llvm::ModuleAnalysisManager::Invalidator &) {
+    return false;
+  }
 };
 
 // New Pass Manager analysis exposing the MetaDataUtils/ModuleMetaData to ported
@@ -323,6 +323,10 @@ bool BreakConstantExpr::breakConstantStruct(ConstantStruct *cs, int operandIndex
 #if LLVM_VERSION_MAJOR >= 16
 PreservedAnalyses BreakConstantExprNPM::run(Function &F, FunctionAnalysisManager &) {
   bool changed = BreakConstantExpr().run(F);
-  return changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+  if (!changed)
+    return PreservedAnalyses::all();
+  PreservedAnalyses PA;
+  PA.preserveSet<CFGAnalyses>();
+  return PA;
 }
 #endif // LLVM_VERSION_MAJOR >= 16
@@ -55,6 +55,10 @@ bool DisableInlining::run(llvm::Function &F) {
 #if LLVM_VERSION_MAJOR >= 16
 PreservedAnalyses DisableInliningNPM::run(Function &F, FunctionAnalysisManager &) {
   bool changed = DisableInlining().run(F);
-  return changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+  if (!changed)
+    return PreservedAnalyses::all();
+  PreservedAnalyses PA;
+  PA.preserveSet<CFGAnalyses>();
+  return PA;
 }
 #endif // LLVM_VERSION_MAJOR >= 16
\ No newline at end of file
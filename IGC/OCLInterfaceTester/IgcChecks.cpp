@@ -12,6 +12,11 @@ SPDX-License-Identifier: MIT
 
 #include "ocl_igc_interface/igc_ocl_device_ctx.h"
 
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
 // Match one supported field by name: set it from the parsed value, read it back
 // Uses key/val from the enclosing forEachStdinField lambda.
 #define FIELD(h, NAME, TYPE)                                                                                           \
@@ -278,3 +283,118 @@ CHECK(regkey, "Interface v6: test that regkey token is returned correctly") {
   std::cout << readBuf(buf.get()) << "\n";
   return ExitCode::Success;
 }
+
+// Small kernel in LLVM IR text form, compiled by the concurrent_build check.
+static const char concurrentBuildKernel[] = R"(
+target datalayout = "e-p:64:64:64-i1:8:8-i8:8:8-i16:16:16-i32:32:32-i64:64:64-f32:32:32-f64:64:64-v16:16:16-v24:32:32-v32:32:32-v48:64:64-v64:64:64-v96:128:128-v128:128:128-v192:256:256-v256:256:256-v512:512:512-v1024:1024:1024-G1"
+target triple = "spir64-unknown-unknown"
+
+define spir_kernel void @saxpy(ptr addrspace(1) %x, ptr addrspace(1) %y, float %a) !kernel_arg_addr_space !0 !kernel_arg_access_qual !1 !kernel_arg_type !2 !kernel_arg_type_qual !3 !kernel_arg_base_type !2 {
+entry:
+  %gid = call spir_func i64 @_Z13get_global_idj(i32 0)
+  %px = getelementptr inbounds float, ptr addrspace(1) %x, i64 %gid
+  %py = getelementptr inbounds float, ptr addrspace(1) %y, i64 %gid
+  %vx = load float, ptr addrspace(1) %px, align 4
+  %vy = load float, ptr addrspace(1) %py, align 4
+  %mul = fmul float %a, %vx
+  %add = fadd float %mul, %vy
+  store float %add, ptr addrspace(1) %py, align 4
+  ret void
+}
+
+declare spir_func i64 @_Z13get_global_idj(i32)
+
+!opencl.ocl.version = !{!4}
+!opencl.spir.version = !{!4}
+
+!0 = !{i32 1, i32 1, i32 0}
+!1 = !{!"none", !"none", !"none"}
+!2 = !{!"float*", !"float*", !"float"}
+!3 = !{!"", !"", !""}
+!4 = !{i32 1, i32 2}
+)";
+
+// Compile concurrentBuildKernel once on a fresh translation context.
+// Returns the device binary, or an empty string if the build failed.
+static std::string buildConcurrentKernel(CIF::CIFMain *cif, IGC::IgcOclDeviceCtx<3> *deviceCtx) {
+  auto translationCtx = deviceCtx->CreateTranslationCtx(IGC::CodeType::llvmLl, IGC::CodeType::oclGenBin);
+  if (!translationCtx)
+    return {};
+
+  auto src = CIF::Builtins::CreateConstBuffer<CIF::Builtins::BufferSimple>(cif, concurrentBuildKernel,
+                                                                           sizeof(concurrentBuildKernel));
+  auto options = CIF::Builtins::CreateConstBuffer<CIF::Builtins::BufferSimple>(cif, nullptr, 0);
+  auto internalOptions = CIF::Builtins::CreateConstBuffer<CIF::Builtins::BufferSimple>(cif, nullptr, 0);
+  if (!src || !options || !internalOptions)
+    return {};
+
+  auto output = translationCtx->Translate(src.get(), options.get(), internalOptions.get(), nullptr, 0);
+  if (!output || !output->Successful())
+    return {};
+
+  return std::string(readBuf(output->GetOutput<CIF::Builtins::BufferSimple>()));
+}
+
+// Translation context
+CHECK(concurrent_build, "Interface v3: test that builds running on several threads match a serial build") {
+  auto deviceCtx = cif->CreateInterface<IGC::IgcOclDeviceCtx<3>>();
+  if (!deviceCtx) {
+    std::cerr << "error: failed to create IGC::IgcOclDeviceCtx<3> interface\n";
+    return ExitCode::UnsupportedInterface;
+  }
+
+  auto platform = deviceCtx->GetPlatformHandle();
+  if (!applyPlatform(platform.get())) {
+    std::cerr << "error: check 'concurrent_build' requires --platform <name>\n";
+    return ExitCode::MissingPlatform;
+  }
+  deviceCtx->GetGTSystemInfoHandle()->SetMaxSlicesSupported(8);
+
+  // threads/builds must both be provided via stdin.
+  long threads = 0, builds = 0;
+  int rc = forEachStdinField([&](std::string_view key, uint64_t val) {
+    if (key == "threads")
+      threads = static_cast<long>(val);
+    else if (key == "builds")
+      builds = static_cast<long>(val);
+    else
+      return unknownField(key);
+    return true;
+  });
+  if (rc != ExitCode::Success)
+    return rc;
+  if (threads <= 0 || builds <= 0) {
+    std::cerr << "error: 'threads' and 'builds' must be provided and non-zero\n";
+    return ExitCode::MissingInput;
+  }
+
+  // Reference binary from a serial build.
+  const std::string reference = buildConcurrentKernel(cif, deviceCtx.get());
+  if (reference.empty()) {
+    std::cerr << "error: serial build failed\n";
+    return ExitCode::FailedToGetInterface;
+  }
+
+  // Every thread runs `builds` compilations; each result is compared byte for
+  // byte against the serial one.
+  std::atomic<long> failed{0}, mismatched{0};
+  std::vector<std::thread> workers;
+  for (long t = 0; t < threads; ++t) {
+    workers.emplace_back([&]() {
+      for (long b = 0; b < builds; ++b) {
+        std::string binary = buildConcurrentKernel(cif, deviceCtx.get());
+        if (binary.empty())
+          ++failed;
+        else if (binary != reference)
+          ++mismatched;
+      }
+    });
+  }
+  for (auto &w : workers)
+    w.join();
+
+  std::cout << "builds=" << threads * builds << "\n";
+  std::cout << "failed=" << failed << "\n";
+  std::cout << "mismatched=" << mismatched << "\n";
+  return ExitCode::Success;
+}
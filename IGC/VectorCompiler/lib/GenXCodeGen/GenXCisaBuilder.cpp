@@ -211,14 +211,22 @@ void handleCisaCallError(const Twine &Call, LLVMContext &Ctx) {
   vc::diagnose(Ctx, "VISA builder API call failed", Call);
 }
 
+// VisaText is the module that failed to parse, or empty if the modules parsed
+// but the vISA verifier rejected them.
 void handleInlineAsmParseError(const GenXBackendConfig &BC, StringRef VisaErr,
                                StringRef VisaText, LLVMContext &Ctx) {
   std::string ErrMsg;
   raw_string_ostream SS{ErrMsg};
-  SS << "Failed to parse inline visa assembly\n";
+  if (VisaText.empty())
+    SS << "Failed to verify inline visa assembly\n";
+  else
+    SS << "Failed to parse inline visa assembly\n";
   if (!VisaErr.empty())
     SS << VisaErr << '\n';
-  if (BC.hasShaderDumper() && BC.asmDumpsEnabled()) {
+  if (VisaText.empty()) {
+    // The verifier checks all linked modules at once, so there is no single
+    // module to dump.
+  } else if (BC.hasShaderDumper() && BC.asmDumpsEnabled()) {
     const char *DumpModuleName = "inline_asm_text";
     const char *DumpModuleExt = "visaasm";
     SS << "Full module dumped as '" << DumpModuleName << '.' << DumpModuleExt
@@ -805,19 +813,19 @@ bool GenXCisaBuilder::runOnModule(Module &M) {
     if (!CisaBuilder || !VISAAsmTextReader)
       return Changed;
 
-    auto ParseVISA = [&](const std::string &Text) {
-      auto Result = VISAAsmTextReader->ParseVISAText(Text, "");
-      if (Result == 0)
-        return;
-
+    // The vISA verifier runs once over this module and the linked ones.
+    std::string AsmText = CisaBuilder->GetAsmTextStream().str();
+    std::vector<const char *> Texts{AsmText.c_str()};
+    Texts.insert(Texts.end(), LTOStrings.begin(), LTOStrings.end());
+    unsigned FailedText = 0;
+    auto Result = VISAAsmTextReader->ParseLinkedVISAText(Texts, FailedText);
+    if (Result != 0) {
       GM->setHasError();
       auto Msg = VISAAsmTextReader->GetCriticalMsg();
-      handleInlineAsmParseError(*BC, Msg, Text, *Ctx);
-    };
-
-    ParseVISA(CisaBuilder->GetAsmTextStream().str());
-    for (auto VisaAsm : LTOStrings)
-      ParseVISA(VisaAsm);
+      StringRef FailedModule =
+          FailedText < Texts.size() ? Texts[FailedText] : "";
+      handleInlineAsmParseError(*BC, Msg, FailedModule, *Ctx);
+    }
   }
 
   return Changed;
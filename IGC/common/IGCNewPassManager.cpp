@@ -11,6 +11,7 @@ SPDX-License-Identifier: MIT
 #include "Compiler/MetaDataUtilsWrapper.h"
 #include "Compiler/CodeGenPublic.h"
 #include "Compiler/CISACodeGen/TimeStatsCounter.h"
+#include "common/debug/Debug.hpp"
 #include "common/debug/Dump.hpp"
 #include "common/Stats.hpp"
 #include "common/igc_regkeys.hpp"
@@ -18,6 +19,8 @@ SPDX-License-Identifier: MIT
 
 #include "common/LLVMWarningsPush.hpp"
 #include <llvm/IR/Module.h>
+#include <llvm/Analysis/LazyCallGraph.h>
+#include <llvm/Analysis/LoopInfo.h>
 #include "common/LLVMWarningsPop.hpp"
 
 #include <algorithm>
@@ -83,6 +86,19 @@ const Module *igcUnwrapModule(const Any &IR) {
   return nullptr;
 }
 
+// Returns the module, function, SCC or loop an analysis is computed for.
+const void *igcUnwrapIRUnit(const Any &IR) {
+  if (const Module *const *M = any_cast<const Module *>(&IR))
+    return *M;
+  if (const Function *const *F = any_cast<const Function *>(&IR))
+    return *F;
+  if (const LazyCallGraph::SCC *const *C = any_cast<const LazyCallGraph::SCC *>(&IR))
+    return *C;
+  if (const Loop *const *L = any_cast<const Loop *>(&IR))
+    return *L;
+  return nullptr;
+}
+
 // Dump the module IR to an IGC dump (file, or console when PrintToConsole is set),
 // mirroring IGCPassManager::addPrintPass. IGC metadata is serialized into the module
 // first so it appears in the dump, matching SerializePrintMetaDataPass.
@@ -166,7 +182,8 @@ IGCNewPassManager::IGCNewPassManager(CodeGenContext *ctx, const char *name, cons
   m_PB->crossRegisterProxies(m_LAM, m_FAM, m_CGAM, m_MAM);
 
   // Per-pass instrumentation: IR dumps (PrintBefore/PrintAfter/ShaderDumpEnableAll)
-  // and per-pass timing (DumpTimeStatsPerPass), matching IGCPassManager::add.
+  // and per-pass timing (DumpTimeStatsPerPass) and compile trace spans, matching
+  // IGCPassManager::add.
   CodeGenContext *pCtx = m_pContext;
   const std::string pmName = m_name;
 
@@ -178,6 +195,8 @@ IGCNewPassManager::IGCNewPassManager(CodeGenContext *ctx, const char *name, cons
     StringRef FinalPassID(RemappedPassID);
     if (IGC_REGKEY_OR_FLAG_ENABLED(DumpTimeStatsPerPass, TIME_STATS_PER_PASS))
       COMPILER_TIME_PASS_START(pCtx, pmName + "_" + FinalPassID.str());
+    if (vISA::trace::isRecording())
+      vISA::trace::begin(traceSpanFor(FinalPassID));
     StringRef AliasID = toggleAliasFor(FinalPassID);
     if (igcIsPrintBefore(FinalPassID) || (!AliasID.empty() && igcIsPrintBefore(AliasID)))
       igcDumpModuleIR(pCtx, pmName, *M, FinalPassID, /*isBefore=*/true);
@@ -194,7 +213,46 @@ IGCNewPassManager::IGCNewPassManager(CodeGenContext *ctx, const char *name, cons
       igcDumpModuleIR(pCtx, pmName, *M, FinalPassID, /*isBefore=*/false);
     if (IGC_REGKEY_OR_FLAG_ENABLED(DumpTimeStatsPerPass, TIME_STATS_PER_PASS))
       COMPILER_TIME_PASS_END(pCtx, pmName + "_" + FinalPassID.str());
+    if (vISA::trace::isRecording())
+      vISA::trace::end(traceSpanFor(FinalPassID));
   });
+
+  if (IGC_IS_FLAG_ENABLED(PrintNPMAnalysisStats)) {
+    // An analysis computed again for an IR unit it was invalidated on is a
+    // recomputation.
+    m_PIC.registerBeforeAnalysisCallback([this](StringRef AnalysisID, Any IR) {
+      AnalysisStats &stats = m_analysisStats[AnalysisID.str()];
+      stats.runs++;
+      if (stats.invalidatedUnits.erase(igcUnwrapIRUnit(IR)))
+        stats.recomputations++;
+    });
+    m_PIC.registerAnalysisInvalidatedCallback([this](StringRef AnalysisID, Any IR) {
+      AnalysisStats &stats = m_analysisStats[AnalysisID.str()];
+      stats.invalidations++;
+      stats.invalidatedUnits.insert(igcUnwrapIRUnit(IR));
+    });
+  }
+}
+
+vISA::trace::SpanID IGCNewPassManager::traceSpanFor(StringRef passID) {
+  auto it = m_traceSpanIDs.find(passID);
+  if (it != m_traceSpanIDs.end())
+    return it->second;
+  vISA::trace::SpanID id = vISA::trace::intern(m_name + "_" + passID.str(), "pass");
+  m_traceSpanIDs[passID] = id;
+  return id;
+}
+
+void IGCNewPassManager::printAnalysisStats() const {
+  auto &OS = IGC::Debug::ods();
+  unsigned totalRuns = 0, totalRecomputes = 0;
+  OS << "NPM analysis stats (" << m_name << "): runs, invalidations\n";
+  for (const auto &[name, stats] : m_analysisStats) {
+    OS << "  " << name << ": " << stats.runs << ", " << stats.invalidations << "\n";
+    totalRuns += stats.runs;
+    totalRecomputes += stats.recomputations;
+  }
+  OS << "  total: " << totalRuns << " runs, " << totalRecomputes << " recomputations\n";
 }
 
 void IGCNewPassManager::registerContextAnalyses(CodeGenContext *ctx, IGCMD::MetaDataUtils *pMdUtils,
@@ -206,7 +264,11 @@ void IGCNewPassManager::registerContextAnalyses(CodeGenContext *ctx, IGCMD::Meta
   m_MAM.registerPass([pMdUtils, modMD] { return MetaDataUtilsAnalysis(pMdUtils, modMD); });
 }
 
-void IGCNewPassManager::run(Module &M) { m_MPM.run(M, m_MAM); }
+void IGCNewPassManager::run(Module &M) {
+  m_MPM.run(M, m_MAM);
+  if (IGC_IS_FLAG_ENABLED(PrintNPMAnalysisStats))
+    printAnalysisStats();
+}
 
 #else
 
@@ -12,14 +12,17 @@ SPDX-License-Identifier: MIT
 #include <llvm/IR/PassManager.h>
 #include <llvm/Passes/PassBuilder.h>
 #include <llvm/Passes/StandardInstrumentations.h>
+#include <llvm/ADT/StringMap.h>
 #include "common/LLVMWarningsPop.hpp"
 
 #include "common/LLVMUtils.h"
 #include "common/igc_regkeys.hpp"
+#include "visa/include/CompileTrace.h"
 
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -70,6 +73,9 @@ struct IsFunctionPass<T, std::void_t<decltype(std::declval<T &>().run(
 // is applied at add time by addPass(). Passes added through
 // createModuleToFunctionPassAdaptor(...) are dumped once per pass at the module
 // level using the pass name supplied to addPass().
+//
+// With PrintNPMAnalysisStats, run() also prints how many times each analysis
+// was computed and invalidated, to see what imprecise preserved sets cost.
 class IGCNewPassManager {
 public:
   // If `tlii` is provided, a TargetLibraryAnalysis seeded with it is registered (matching a legacy
@@ -130,6 +136,22 @@ private:
   llvm::ModuleAnalysisManager m_MAM;
   llvm::ModulePassManager m_MPM;
 
+  // Analysis name -> number of times it was computed/invalidated, for PrintNPMAnalysisStats.
+  struct AnalysisStats {
+    unsigned runs = 0;
+    unsigned invalidations = 0;
+    unsigned recomputations = 0;
+    // IR units whose result was invalidated and not computed again yet.
+    std::set<const void *> invalidatedUnits;
+  };
+  std::map<std::string, AnalysisStats> m_analysisStats;
+  void printAnalysisStats() const;
+
+  // PassID (after any adaptor remap) -> its compile trace span, so that each
+  // pass name is interned once rather than on every run.
+  llvm::StringMap<vISA::trace::SpanID> m_traceSpanIDs;
+  vISA::trace::SpanID traceSpanFor(llvm::StringRef passID);
+
   std::vector<std::string> m_ModuleToFunctionPassNames;
   std::optional<std::string> m_ActiveModuleToFunctionPassName;
   size_t m_NextModuleToFunctionPassName = 0;
@@ -80,6 +80,8 @@ void KernelModuleSplitter::splitModuleForKernel(const llvm::Function *kernelF) {
   _splittedModule = std::move(kernelM);
 }
 
+std::unique_ptr<llvm::Module> KernelModuleSplitter::takeSplittedModule() { return std::move(_splittedModule); }
+
 void KernelModuleSplitter::retry() {
   if (_splittedModule) {
     restoreOclContextModule();
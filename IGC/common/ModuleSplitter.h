@@ -23,6 +23,8 @@ public:
   void setSplittedModuleInOCLContext();
   void retry();
   void splitModuleForKernel(const llvm::Function *kernelF);
+  // Hands over the split module without setting it in the context.
+  std::unique_ptr<llvm::Module> takeSplittedModule();
 
 private:
   IGC::OpenCLProgramContext &_oclContext;
@@ -25,6 +25,7 @@ SPDX-License-Identifier: MIT
 #include <iomanip>
 #include <sstream>
 #include <iostream>
+#include <vector>
 #include "Probe/Assertion.h"
 
 #if GET_TIME_STATS
@@ -361,6 +362,24 @@ int parentIntervalDepth(COMPILE_TIME_INTERVALS cti) {
   }
 }
 
+void traceTimeInterval(COMPILE_TIME_INTERVALS cti, bool isStart) {
+  static const std::vector<vISA::trace::SpanID> spanIDs = [] {
+    std::vector<vISA::trace::SpanID> ids;
+    for (int i = 0; i < MAX_COMPILE_TIME_INTERVALS; ++i) {
+      ids.push_back(vISA::trace::intern(g_cCompTimeIntervals[i], "igc"));
+    }
+    return ids;
+  }();
+  if (cti >= MAX_COMPILE_TIME_INTERVALS) {
+    return;
+  }
+  if (isStart) {
+    vISA::trace::begin(spanIDs[cti]);
+  } else {
+    vISA::trace::end(spanIDs[cti]);
+  }
+}
+
 #if GET_TIME_STATS
 
 TimeStats::TimeStats() : m_isPostProcessed(false), m_totalShaderCount(0), m_PassTotalTicks(0) {
@@ -23,6 +23,7 @@ SPDX-License-Identifier: MIT
 
 #include "common/Types.hpp"
 #include "common/MemStats.h"
+#include "visa/include/CompileTrace.h"
 
 #include "AdaptorCommon/customApi.hpp"
 
@@ -173,6 +174,8 @@ bool isCoarseTimer(COMPILE_TIME_INTERVALS cti);
 bool isDashboardTimer(COMPILE_TIME_INTERVALS cti);
 COMPILE_TIME_INTERVALS parentInterval(COMPILE_TIME_INTERVALS cti);
 int parentIntervalDepth(COMPILE_TIME_INTERVALS cti);
+/// Open (isStart) or close the compile trace span of a timer
+void traceTimeInterval(COMPILE_TIME_INTERVALS cti, bool isStart);
 
 #if GET_TIME_STATS
 
@@ -262,12 +265,18 @@ private:
 
 #define COMPILER_TIME_START(pointer, compileTimeInterval)                                                              \
   do {                                                                                                                 \
+    if (vISA::trace::isEnabled()) {                                                                                    \
+      traceTimeInterval(compileTimeInterval, true);                                                                    \
+    }                                                                                                                  \
     if ((pointer) && (pointer)->m_compilerTimeStats) {                                                                 \
       (pointer)->m_compilerTimeStats->recordTimerStart(compileTimeInterval);                                           \
     }                                                                                                                  \
   } while (0)
 #define COMPILER_TIME_END(pointer, compileTimeInterval)                                                                \
   do {                                                                                                                 \
+    if (vISA::trace::isEnabled()) {                                                                                    \
+      traceTimeInterval(compileTimeInterval, false);                                                                   \
+    }                                                                                                                  \
     if ((pointer) && (pointer)->m_compilerTimeStats) {                                                                 \
       (pointer)->m_compilerTimeStats->recordTimerEnd(compileTimeInterval);                                             \
     }                                                                                                                  \
@@ -84,6 +84,10 @@ DECLARE_IGC_REGKEY(bool, AddVISADumpDeclarationsToEnd, false,
 DECLARE_IGC_REGKEY(bool, EnableVISABinary, false, "Enable VISA Binary", true)
 DECLARE_IGC_REGKEY(bool, EnableVISAOutput, false, "Enable VISA GenISA output", true)
 DECLARE_IGC_REGKEY(bool, EnableVISASlowpath, false, "Enable VISA Slowpath. Needed to dump .visaasm", true)
+DECLARE_IGC_REGKEY(bool, ParseInlineAsmFragments, true,
+                   "Parse each inline asm block into the vISA kernel being built instead of printing the whole kernel "
+                   "as vISA text and parsing it again",
+                   false)
 DECLARE_IGC_REGKEY(bool, EnableVISADotAll, false, "Enable VISA DotAll. Dumps dot files for intermediate stages", false)
 DECLARE_IGC_REGKEY(bool, EnableVISADebug, false, "Runs VISA in debug mode, all optimizations disabled", false)
 DECLARE_IGC_REGKEY(DWORD, EnableVISAStructurizer, 1,
@@ -231,6 +235,10 @@ DECLARE_IGC_REGKEY(bool, Force32bitConstantGEPLowering, false,
 DECLARE_IGC_REGKEY(bool, GEPLoweringTruncOptEnabled, false,
                    "Enable using truncation to avoid recalculation in GEP lowering", false)
 DECLARE_IGC_REGKEY(bool, NewSpillCostFunction, false, "Use new spill cost function in VISA RA", false)
+DECLARE_IGC_REGKEY(bool, LatencySpillCost, false,
+                   "Pick VISA RA spill candidates by predicted spill/fill cycles weighted by block frequency", false)
+DECLARE_IGC_REGKEY(bool, LoopBoundarySplit, false,
+                   "Split VISA RA spill candidates live through hot loops at the loop boundaries", false)
 DECLARE_IGC_REGKEY(bool, EnableCoalesceScalarMoves, true, "Enable scalar moves to be coalesced into fewer moves", true)
 DECLARE_IGC_REGKEY(DWORD, SpillCompressionThresholdOverride, 0,
                    "Set a threshold number (1K based) to run with spill compression", false)
@@ -798,6 +806,30 @@ DECLARE_IGC_REGKEY(bool, CompileOneAtTime, false,
                    "Compile only one kernel (out of many in llvm::module) at a time. Prints compiled kenrels names to "
                    "stdout. Useful to debug compilation time and crashes - it does not produce valid binary.",
                    false)
+DECLARE_IGC_REGKEY(DWORD, ParallelKernelCompileThreads, 0,
+                   "Compile the kernels of a program on up to N threads, each kernel in its own module and "
+                   "LLVMContext. Programs whose kernels share program-scope variables, indirectly called functions or "
+                   "exported symbols are compiled whole. 0 or 1: whole program on one thread.",
+                   true)
+DECLARE_IGC_REGKEY(bool, PrintParallelKernelCompile, false,
+                   "Print to stderr whether ParallelKernelCompileThreads splits a program, and why not, and which "
+                   "kernels take the result of SpeculativeRetryCompile",
+                   true)
+DECLARE_IGC_REGKEY(bool, SpeculativeRetryCompile, false,
+                   "With ParallelKernelCompileThreads, compile the retry state of every kernel concurrently with its "
+                   "first state instead of after it. The retry result is dropped if the first state does not need it.",
+                   true)
+DECLARE_IGC_REGKEY(debugString, KernelCacheDir, 0,
+                   "Directory of the on-disk cache of compiled OpenCL programs. The directory must exist. Empty: "
+                   "caching is disabled.",
+                   true)
+DECLARE_IGC_REGKEY(DWORD, KernelCacheMaxSizeMB, 1024,
+                   "Size limit of KernelCacheDir in MB. Least recently used entries are removed above it.", true)
+DECLARE_IGC_REGKEY(bool, KernelCacheValidate, false,
+                   "Compile even on a KernelCacheDir hit and report and replace entries that differ from the output.",
+                   true)
+DECLARE_IGC_REGKEY(bool, KernelCachePrintStats, false, "Print KernelCacheDir hit and miss counters after each build.",
+                   true)
 DECLARE_IGC_REGKEY(
     bool, SystemThreadEnable, false,
     "This key forces software to create a system thread. The system thread may still be created by software even \
@@ -976,6 +1008,14 @@ DECLARE_IGC_REGKEY(bool, DumpTimeStats, false, "Timing of translation, code gene
 DECLARE_IGC_REGKEY(bool, DumpTimeStatsCoarse, false,
                    "Only collect/dump coarse level time stats, i.e. skip opt detail timer for now", true)
 DECLARE_IGC_REGKEY(bool, DumpTimeStatsPerPass, false, "Collect Timing of IGC/LLVM passes", true)
+DECLARE_IGC_REGKEY(debugString, CompileTraceFile, 0,
+                   "Write a hierarchical trace of IGC timers, passes and vISA phases to this file "
+                   "in the Chrome trace event format (open in chrome://tracing or Perfetto)",
+                   true)
+DECLARE_IGC_REGKEY(DWORD, CompileTraceSampleRate, 1,
+                   "With CompileTraceFile, trace only every Nth compilation. 0 and 1 trace all of them", true)
+DECLARE_IGC_REGKEY(bool, PrintNPMAnalysisStats, false,
+                   "Print how many times each analysis is computed and invalidated per New Pass Manager run", true)
 DECLARE_IGC_REGKEY(bool, DumpHasNonKernelArgLdSt, false, "Print if hasNonKernelArg load/store to stderr", true)
 DECLARE_IGC_REGKEY(bool, PrintPsoDdiHash, true, "Print psoDDIHash in TimeStats_Shaders.csv file", true)
 DECLARE_IGC_REGKEY(bool, ShaderDataBaseStats, false, "Enable gathering sends' sizes for shader statistics", false)
@@ -1836,6 +1876,13 @@ DECLARE_IGC_REGKEY(bool, FastCompileRA, false, "Provide the fast compilatoin pat
                    false)
 DECLARE_IGC_REGKEY(bool, HybridRAWithSpill, false, "Did Hybrid RA with Spill", false)
 DECLARE_IGC_REGKEY(bool, SelectiveFastRA, false, "Apply fast RA with spills selectively using heuristics", true)
+DECLARE_IGC_REGKEY(DWORD, VISACompileTier, 2,
+                   "Highest vISA compile tier: 0 - linear scan RA without preRA scheduling, 1 - single iteration "
+                   "hybrid RA, 2 - full graph coloring RA",
+                   true)
+DECLARE_IGC_REGKEY(DWORD, VISACompileBudget, 0,
+                   "Compile time budget in ms used by vISA to pick the compile tier of each kernel, 0 - no budget",
+                   true)
 DECLARE_IGC_REGKEY(DWORD, RetryStackCallSpillCostThreshold, 5,
                    "Only retry if the percentage of spills (over total instructions) is more than this value", false)
 DECLARE_IGC_REGKEY(DWORD, AllowStackCallRetry, 2,
@@ -0,0 +1,35 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// REQUIRES: regkeys, dg2-supported
+
+// RUN: ocloc compile -file %s -device dg2 -options "-igc_opts 'VISAOptions=-dumpArenaUsage'" 2>&1 | FileCheck %s
+// RUN: ocloc compile -file %s -device dg2 2>&1 | FileCheck %s --check-prefix=CHECK-OFF
+
+// This test checks that -dumpArenaUsage reports the peak arena memory of the
+// kernel and the arena memory of each vISA pass and of encoding.
+
+// CHECK: Arena usage for arena_usage: peak {{[0-9]+}} KB, current {{[0-9]+}} KB
+// CHECK-NEXT: phase{{ +}}start(KB){{ +}}peak(KB){{ +}}end(KB)
+// CHECK: HWConformityChk{{ +[0-9]+ +[0-9]+ +[0-9]+}}
+// CHECK: regAlloc{{ +[0-9]+ +[0-9]+ +[0-9]+}}
+// CHECK: localSchedule{{ +[0-9]+ +[0-9]+ +[0-9]+}}
+// CHECK: encode{{ +[0-9]+ +[0-9]+ +[0-9]+}}
+// CHECK: Build succeeded.
+
+// CHECK-OFF-NOT: Arena usage for
+// CHECK-OFF: Build succeeded.
+
+__kernel void arena_usage(__global float *dst, __global const float *src,
+                          int n) {
+  int gid = get_global_id(0);
+  float acc = 0.0f;
+  for (int i = 0; i < n; ++i)
+    acc += src[gid * n + i] * src[i];
+  dst[gid] = acc;
+}
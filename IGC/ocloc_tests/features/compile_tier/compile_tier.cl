@@ -0,0 +1,52 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// REQUIRES: pvc-supported, regkeys
+// UNSUPPORTED: release
+
+// RUN: ocloc compile -file %s -device pvc -options "-igc_opts 'TotalGRFNum=32, ForceSIMDRPELimit=2000, VISACompileTier=0, VISAOptions=-asmToConsole'" 2>&1 | grep -v "full_options" > %t.tier0
+// RUN: ocloc compile -file %s -device pvc -options "-igc_opts 'TotalGRFNum=32, ForceSIMDRPELimit=2000, VISACompileBudget=1, VISAOptions=-asmToConsole -compileTierInstsPerMs 1'" 2>&1 | grep -v "full_options" > %t.budget
+// RUN: diff %t.tier0 %t.budget
+// RUN: FileCheck %s --input-file=%t.budget
+// RUN: ocloc compile -file %s -device pvc -options "-igc_opts 'TotalGRFNum=32, ForceSIMDRPELimit=2000, VISACompileTier=0, VISAOptions=-ratrace'" 2>&1 | FileCheck %s --check-prefix=CHECK-TIER0
+// RUN: ocloc compile -file %s -device pvc -options "-igc_opts 'TotalGRFNum=32, ForceSIMDRPELimit=2000, VISACompileTier=1, VISAOptions=-ratrace'" 2>&1 | FileCheck %s --check-prefix=CHECK-TIER1
+// RUN: ocloc compile -file %s -device pvc -options "-igc_opts 'TotalGRFNum=32, ForceSIMDRPELimit=2000, VISAOptions=-ratrace'" 2>&1 | FileCheck %s --check-prefix=CHECK-TIER2
+
+// This test checks that a compile budget too small for the kernel picks
+// tier 0, which gives the same code as asking for tier 0 directly, and that
+// the lower tiers use fast RA and still allocate registers for a kernel that
+// spills. Tier 2, the default, keeps the full graph coloring RA.
+
+// CHECK-LABEL: .kernel spill_kernel
+// CHECK: Build succeeded.
+
+// CHECK-TIER0: --compile tier 0 uses fast RA
+// CHECK-TIER0: Build succeeded.
+
+// CHECK-TIER1: --compile tier 1 uses fast RA
+// CHECK-TIER1: Build succeeded.
+
+// CHECK-TIER2-NOT: uses fast RA
+// CHECK-TIER2: Build succeeded.
+
+#define def(N) float16 v##N = {1+i, 2+i, 3+i, 4+i, 5+i, 6+i, 7+i, 8+i, 9+i, 10+i, 11+i, 12+i, 13+i, 14+i, 15+i, 16+i};
+#define inc(N) v##N += (float16){16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+#define wrt(N) result[N] = v##N;
+
+kernel void spill_kernel(float16 global *result, int n) {
+    int i = get_global_id(0);
+
+    def(0); def(1); def(2); def(3); def(4); def(5); def(6); def(7);
+
+    #pragma nounroll
+    for (int j = 0; j < n; j++) {
+        inc(0); inc(1); inc(2); inc(3); inc(4); inc(5); inc(6); inc(7);
+    }
+
+    wrt(0); wrt(1); wrt(2); wrt(3); wrt(4); wrt(5); wrt(6); wrt(7);
+}
@@ -0,0 +1,31 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// REQUIRES: pvc-supported, regkeys
+// UNSUPPORTED: release
+
+// RUN: ocloc compile -file %s -device pvc -options "-igc_opts 'EnableStackCallFuncCall=1, VISACompileTier=0, VISAOptions=-ratrace'" 2>&1 | FileCheck %s
+// RUN: ocloc compile -file %s -device pvc -options "-igc_opts 'EnableStackCallFuncCall=1, PartitionWithFastHybridRA=1, VISACompileTier=0, VISAOptions=-ratrace'" 2>&1 | FileCheck %s --check-prefix=CHECK-PARTITION
+
+// This test checks that tier 0 keeps the full graph coloring RA for kernels
+// with stack calls unless fast RA can partition them.
+
+// CHECK-NOT: uses fast RA
+// CHECK: Build succeeded.
+
+// CHECK-PARTITION: --compile tier 0 uses fast RA
+// CHECK-PARTITION: Build succeeded.
+
+__attribute__((noinline)) float scale(global float *p, int i) {
+  return p[i] * (float)i + p[i + 1];
+}
+
+kernel void test(global float *p, global float *q) {
+  int i = get_global_id(0);
+  q[i] = scale(p, i);
+}
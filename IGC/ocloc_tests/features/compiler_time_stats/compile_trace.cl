@@ -0,0 +1,24 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// REQUIRES: regkeys, pvc-supported
+
+// RUN: ocloc compile -file %s -options "-igc_opts 'CompileTraceFile=%t.json'" -device pvc
+// RUN: FileCheck %s --input-file=%t.json
+// CHECK: [
+// CHECK-DAG: {"name":"Translate","cat":"igc","ph":"B"
+// CHECK-DAG: {"name":"CodeGen","cat":"igc","ph":"B"
+// CHECK-DAG: "cat":"pass","ph":"B"
+// CHECK-DAG: {"name":"Total_RA","cat":"visa","ph":"B"
+// CHECK-DAG: {"name":"IGA_Encoding","cat":"visa","ph":"E"
+// CHECK-DAG: "args":{"kernel":"foo","hash":"0x{{[0-9a-f]+}}","simd":{{[0-9]+}},"spill_size":0}
+// CHECK: ]
+
+// This test checks that CompileTraceFile writes IGC timers, passes and vISA
+// phases as nested spans in the Chrome trace event format.
+__kernel void foo(int a, int b, __global int *res) { *res = a + b; }
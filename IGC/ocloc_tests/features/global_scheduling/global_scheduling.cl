@@ -0,0 +1,39 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// REQUIRES: regkeys, dg2-supported
+
+// RUN: ocloc compile -file %s -device dg2 -options "-igc_opts 'VISAOptions=-asmToConsole'" 2>&1 | FileCheck %s --check-prefix=CHECK-DEFAULT
+// RUN: ocloc compile -file %s -device dg2 -options "-igc_opts 'VISAOptions=-asmToConsole -globalSched'" 2>&1 | FileCheck %s --check-prefix=CHECK-GLOBAL
+
+// This test checks that global scheduling hoists the load of b[gid] above
+// the branch around the divergent code, so its latency overlaps with it.
+// Without it, only the load of a[gid] is issued before the branch.
+
+// CHECK-DEFAULT-LABEL: .kernel hoist_load
+// CHECK-DEFAULT: {{[[:space:]]send[cs]?[.[:space:]]}}
+// CHECK-DEFAULT-NOT: {{[[:space:]]send[cs]?[.[:space:]]}}
+// CHECK-DEFAULT: {{[[:space:]]goto[.[:space:]]}}
+// CHECK-DEFAULT: Build succeeded.
+
+// CHECK-GLOBAL-LABEL: .kernel hoist_load
+// CHECK-GLOBAL: {{[[:space:]]send[cs]?[.[:space:]]}}
+// CHECK-GLOBAL: {{[[:space:]]send[cs]?[.[:space:]]}}
+// CHECK-GLOBAL: {{[[:space:]]goto[.[:space:]]}}
+// CHECK-GLOBAL: Build succeeded.
+
+__kernel void hoist_load(__global float *a, __global float *b,
+                         __global float *out) {
+  int gid = get_global_id(0);
+  float x = a[gid];
+  if (x > 0.0f) {
+    x = native_sqrt(x) * x + native_exp(x);
+    x = native_log(x) * native_sin(x) + native_cos(x);
+  }
+  out[gid] = x + b[gid];
+}
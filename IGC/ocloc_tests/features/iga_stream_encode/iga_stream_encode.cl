@@ -0,0 +1,43 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// REQUIRES: regkeys, dg2-supported
+
+// vISA options are passed in the environment so that the binaries, which
+// record the build options, can be compared.
+// RUN: rm -rf %t.whole %t.stream %t.whole_nc %t.stream_nc
+// RUN: ocloc compile -file %s -device dg2 -out_dir %t.whole
+// RUN: env IGC_VISAOptions=-igaStreamEncode ocloc compile -file %s -device dg2 -out_dir %t.stream
+// RUN: diff -r %t.whole %t.stream
+// RUN: env IGC_VISAOptions=-nocompaction ocloc compile -file %s -device dg2 -out_dir %t.whole_nc
+// RUN: env "IGC_VISAOptions=-nocompaction -igaStreamEncode" ocloc compile -file %s -device dg2 -out_dir %t.stream_nc
+// RUN: diff -r %t.whole_nc %t.stream_nc
+
+// This test checks that encoding each instruction as it is translated to IGA
+// gives the same binary as the whole-kernel IGA encoder, with and without
+// compaction. The kernel has forward and backward jumps, whose offsets are
+// patched once the blocks they target are placed.
+
+__kernel void stream_encode(__global float *dst, __global const float *src,
+                            int n, int m) {
+  int gid = get_global_id(0);
+  float acc = 0.0f;
+  for (int i = 0; i < n; ++i) {
+    float v = src[gid * n + i];
+    if (v > 0.0f)
+      acc += v * v;
+    else
+      acc -= native_sqrt(-v);
+    if (acc > 1000.0f)
+      break;
+  }
+  if (gid < m)
+    dst[gid] = acc;
+  else
+    dst[gid] = -acc;
+}
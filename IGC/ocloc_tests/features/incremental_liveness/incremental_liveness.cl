@@ -0,0 +1,44 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// REQUIRES: pvc-supported, regkeys
+
+// RUN: ocloc compile -file %s -device pvc -options "-igc_opts 'TotalGRFNum=32, ForceSIMDRPELimit=2000, VISAOptions=-asmToConsole -incrementalra 1 -noIncrementalLiveness'" 2>&1 | grep -v "full_options" > %t.full
+// RUN: ocloc compile -file %s -device pvc -options "-igc_opts 'TotalGRFNum=32, ForceSIMDRPELimit=2000, VISAOptions=-asmToConsole -incrementalra 2'" 2>&1 | grep -v "full_options" > %t.incremental
+// RUN: diff %t.full %t.incremental
+// RUN: FileCheck %s --input-file=%t.incremental
+
+// This test checks that updating liveness incrementally between spill
+// iterations of RA gives the same code as computing it from scratch.
+// Verification mode of incremental RA also asserts that both liveness
+// results match.
+
+// CHECK-LABEL: .kernel spill_kernel
+// CHECK: Build succeeded.
+
+#define def(N) float16 v##N = {1+i, 2+i, 3+i, 4+i, 5+i, 6+i, 7+i, 8+i, 9+i, 10+i, 11+i, 12+i, 13+i, 14+i, 15+i, 16+i};
+#define inc(N) v##N += (float16){16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+#define wrt(N) result[N] = v##N;
+
+kernel void spill_kernel(float16 global *result, int n) {
+    int i = get_global_id(0);
+
+    def(0); def(1); def(2); def(3); def(4); def(5); def(6); def(7);
+
+    #pragma nounroll
+    for (int j = 0; j < n; j++) {
+        inc(0); inc(1); inc(2); inc(3);
+        if (j & 1) {
+            inc(4); inc(5);
+        } else {
+            inc(6); inc(7);
+        }
+    }
+
+    wrt(0); wrt(1); wrt(2); wrt(3); wrt(4); wrt(5); wrt(6); wrt(7);
+}
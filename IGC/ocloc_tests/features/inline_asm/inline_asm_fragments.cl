@@ -0,0 +1,51 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// REQUIRES: regkeys, pvc-supported
+// RUN: ocloc compile -file %s -options "-igc_opts 'DumpVISAASMToConsole=1'" -device pvc | FileCheck %s
+// RUN: ocloc compile -file %s -options "-igc_opts 'DumpVISAASMToConsole=1,ParseInlineAsmFragments=0'" -device pvc | FileCheck %s
+
+// Inline asm blocks are parsed straight into the kernel being built. They must
+// see the variables of the kernel, define their own labels and may hold
+// nothing but comments, just as when the whole kernel is parsed again as text.
+
+// CHECK-LABEL: .kernel
+// CHECK: add (M1, 16) {{.*}} 0x1:d
+// CHECK: [[LABEL:__[0-9_]+]]:
+// CHECK: cmp.lt (M1, 16) {{.*}} 0x10:d
+// CHECK: jmp (M1, 1) [[LABEL]]
+// CHECK: ret (M1, 1)
+
+__attribute__((intel_reqd_sub_group_size(16)))
+kernel void test(global int *a)
+{
+    int i = get_global_id(0);
+    int x = a[i];
+    int y;
+
+    __asm__ ("// nothing to do here");
+
+    __asm__ (
+      "add (M1, 16) %0(0,0)<1> %1(0,0)<1;1,0> 0x1:d\n"
+      : "=rw"(y)
+      : "rw"(x)
+    );
+
+    __asm__ volatile (
+      "{\n"
+      ".decl P1 v_type=P num_elts=16\n"
+      "%=:\n"
+      "add (M1, 16) %0(0,0)<1> %0(0,0)<1;1,0> 0x1:d\n"
+      "cmp.lt (M1, 16) P1 %0(0,0)<1;1,0> 0x10:d\n"
+      "(P1) jmp (M1, 1) %=\n"
+      "}\n"
+      : "+rw"(y)
+    );
+
+    a[i] = y;
+}
@@ -0,0 +1,31 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// UNSUPPORTED: system-windows
+// REQUIRES: regkeys, dg2-supported
+
+// This test checks that a second build of the same program is taken from
+// KernelCacheDir, and that validation finds the cached entry up to date.
+
+// RUN: rm -rf %t.cache && mkdir %t.cache
+// RUN: env IGC_KernelCacheDir=%t.cache IGC_KernelCachePrintStats=1 ocloc compile -file %s -device dg2 2>&1 | FileCheck %s --check-prefix=CHECK-MISS
+// RUN: env IGC_KernelCacheDir=%t.cache IGC_KernelCachePrintStats=1 ocloc compile -file %s -device dg2 2>&1 | FileCheck %s --check-prefix=CHECK-HIT
+// RUN: env IGC_KernelCacheDir=%t.cache IGC_KernelCachePrintStats=1 IGC_KernelCacheValidate=1 ocloc compile -file %s -device dg2 2>&1 | FileCheck %s --check-prefix=CHECK-VALIDATE
+// RUN: rm -rf %t.cache
+
+// CHECK-MISS: IGC kernel cache: hits=0 misses=1 stores=1 evictions=0 mismatches=0
+// CHECK-MISS: Build succeeded.
+
+// CHECK-HIT: IGC kernel cache: hits=1 misses=0 stores=0 evictions=0 mismatches=0
+// CHECK-HIT: Build succeeded.
+
+// CHECK-VALIDATE-NOT: differs from the compiled output
+// CHECK-VALIDATE: IGC kernel cache: hits=1 misses=0 stores=0 evictions=0 mismatches=0
+// CHECK-VALIDATE: Build succeeded.
+
+__kernel void add(int a, int b, __global int *res) { *res = a + b; }
@@ -0,0 +1,53 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// REQUIRES: regkeys, pvc-supported
+// UNSUPPORTED: release
+
+// RUN: ocloc compile -file %s -device pvc \
+// RUN:   -options "-igc_opts 'LatencySpillCost=1, VISAOptions=-ratrace'" \
+// RUN:   2>&1 | FileCheck %s
+// RUN: ocloc compile -file %s -device pvc \
+// RUN:   -options "-igc_opts 'VISAOptions=-ratrace'" \
+// RUN:   2>&1 | FileCheck %s --check-prefix=CHECK-OFF
+
+// This test checks that GRF RA switches to the latency spill cost model under
+// high register pressure. The values in a[] are referenced in the loop, so they
+// should cost far more to spill than the ones in b[], which are only live
+// across it. The default cost weighs each candidate by refCount^3 /
+// (degree + 1)^2 and does not account for where the references are; the
+// cycles the model estimates for its spills, and those it saves over the
+// default choice, must be reported.
+
+// CHECK: --using latency spill cost model
+// CHECK: --spill cost: {{[0-9]+}} cycles, {{[0-9]+}} cycles avoided
+// CHECK: Build succeeded.
+
+// CHECK-OFF-NOT: --using latency spill cost model
+// CHECK-OFF-NOT: --spill cost:
+// CHECK-OFF: Build succeeded.
+
+#define D 64
+
+kernel void hot_loop(global double *p, int n) {
+  double a[D];
+  double b[D];
+  for (int i = 0; i < D; ++i) {
+    a[i] = p[i] * (double)i;
+    b[i] = p[i + D];
+  }
+  for (int k = 0; k < n; ++k) {
+#pragma unroll
+    for (int i = 0; i < D; ++i)
+      a[i] = a[i] * a[(i + 7) % D] + a[(i + 13) % D];
+  }
+  double s = 0;
+  for (int i = 0; i < D; ++i)
+    s += a[i] * b[i];
+  p[get_global_id(0)] = s;
+}
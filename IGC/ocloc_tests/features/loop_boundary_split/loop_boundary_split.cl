@@ -0,0 +1,66 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// REQUIRES: regkeys, pvc-supported
+// UNSUPPORTED: release
+
+// RUN: ocloc compile -file %s -device pvc \
+// RUN:   -options "-igc_opts 'VISAOptions=-ratrace'" &> %t.base.log
+// RUN: ocloc compile -file %s -device pvc \
+// RUN:   -options "-igc_opts 'LoopBoundarySplit=1, VISAOptions=-ratrace'" \
+// RUN:   &> %t.split.log
+// RUN: FileCheck %s --input-file=%t.base.log --check-prefix=CHECK-BASE
+// RUN: FileCheck %s --input-file=%t.split.log --check-prefix=CHECK-SPLIT
+
+// This test checks that GRF RA splits spilled values that are live through a
+// high pressure loop without being referenced in it, so that the loop no
+// longer has to spill the values it uses. The values in b[] are computed
+// before the loop and used many times after it, next to the temporaries in
+// c[], so without the split they cost more to spill than a[], which is only
+// read in the loop. RA then spills some of b[] for the code after the loop and
+// some of a[] for the loop itself, which fills a[] in the loop. With the split,
+// the copies that hold b[] across the loop are the cheapest to spill, and the
+// loop is left without spill code.
+
+// CHECK-BASE-NOT: --split {{[0-9]+}} live range(s) around hot loops
+// CHECK-BASE: --spill/fill in loops: {{[0-9]+}} spills, {{[1-9][0-9]*}} fills
+// CHECK-BASE: Build succeeded.
+
+// CHECK-SPLIT: --split {{[1-9][0-9]*}} live range(s) around hot loops
+// CHECK-SPLIT: --spilled variables: {{.*}}LOOPTHRU
+// CHECK-SPLIT: --spill/fill in loops: 0 spills, 0 fills
+// CHECK-SPLIT: Build succeeded.
+
+#define DA 40
+#define DB 30
+
+kernel void loop_thru(global double *p, global double *q, int n) {
+  double a[DA];
+  double b[DB];
+  double c[DB];
+#pragma unroll
+  for (int i = 0; i < DA; ++i)
+    a[i] = p[i] * (double)i;
+#pragma unroll
+  for (int i = 0; i < DB; ++i)
+    b[i] = q[i] * (double)i;
+  double s = 0;
+#pragma nounroll
+  for (int k = 0; k < n; ++k) {
+#pragma unroll
+    for (int i = 0; i < DA; ++i)
+      s = s * a[i] + a[(i + 7) % DA];
+  }
+#pragma unroll
+  for (int i = 0; i < DB; ++i)
+    c[i] = b[i] * b[(i + 1) % DB] + b[(i + 2) % DB] * s;
+#pragma unroll
+  for (int i = 0; i < DB; ++i)
+    q[i] = c[i] * b[i] + c[(i + 3) % DB] * b[(i + 4) % DB] +
+           c[(i + 5) % DB] * b[(i + 6) % DB];
+}
@@ -0,0 +1,28 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// REQUIRES: regkeys, dg2-supported, llvm-16-plus
+
+// RUN: ocloc compile -file %s -device dg2 -options "-igc_opts 'EnableOCLNewPassManager=1,PrintNPMAnalysisStats=1'" 2>&1 | FileCheck %s
+
+// This test checks that PrintNPMAnalysisStats reports the analyses of the
+// Unify New Pass Manager run, and that the context analyses are computed once
+// and never invalidated. The later stages stay on the legacy pass manager.
+
+// CHECK-LABEL: NPM analysis stats (Unify): runs, invalidations
+// CHECK: CodeGenContextAnalysis: 1, 0
+// CHECK: total: {{[0-9]+}} runs, {{[0-9]+}} recomputations
+// CHECK-NOT: NPM analysis stats (OPTPre)
+// CHECK: Build succeeded.
+
+__kernel void loop(__global int *res, int n) {
+  int sum = 0;
+  for (int i = 0; i < n; ++i)
+    sum += res[i] * i;
+  res[0] = sum;
+}
@@ -0,0 +1,38 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// REQUIRES: regkeys, dg2-supported
+
+// RUN: ocloc compile -file %s -device dg2 -options "-igc_opts 'VISAOptions=-asmToConsole'" 2>&1 | grep -v "full_options" > %t.serial
+// RUN: ocloc compile -file %s -device dg2 -options "-igc_opts 'VISAOptions=-asmToConsole -parallelIntfThreads 4 -parallelIntfMinInsts 0'" 2>&1 | grep -v "full_options" > %t.parallel
+// RUN: diff %t.serial %t.parallel
+// RUN: FileCheck %s --input-file=%t.parallel
+
+// This test checks that building the interference graph on several threads
+// gives the same register assignment as the serial build.
+
+// CHECK-LABEL: .kernel branchy
+// CHECK: Build succeeded.
+
+__kernel void branchy(__global float4 *in, __global float4 *out, int n) {
+  int gid = get_global_id(0);
+  float4 a = in[gid];
+  float4 b = in[gid + 1];
+  float4 c = in[gid + 2];
+  for (int i = 0; i < n; ++i) {
+    if (i & 1) {
+      a = a * b + c;
+    } else {
+      b = b * c - a;
+    }
+    if (i % 3 == 0) {
+      c = c + a * b;
+    }
+  }
+  out[gid] = a + b + c;
+}
@@ -0,0 +1,48 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// REQUIRES: regkeys, dg2-supported
+
+// Regkeys are passed in the environment so that the binaries, which record
+// the build options, can be compared.
+// RUN: rm -rf %t.serial %t.parallel %t.speculative %t.serial_retry
+// RUN: ocloc compile -file %s -device dg2 -out_dir %t.serial
+// RUN: env IGC_ParallelKernelCompileThreads=4 IGC_PrintParallelKernelCompile=1 ocloc compile -file %s -device dg2 -out_dir %t.parallel 2>&1 | FileCheck %s --check-prefix=CHECK-SPLIT
+// RUN: diff -r %t.serial %t.parallel
+// RUN: env IGC_ForceRecompilation=1 ocloc compile -file %s -device dg2 -out_dir %t.serial_retry
+// RUN: env IGC_ParallelKernelCompileThreads=4 IGC_SpeculativeRetryCompile=1 IGC_ForceRecompilation=1 IGC_PrintParallelKernelCompile=1 ocloc compile -file %s -device dg2 -out_dir %t.speculative 2>&1 | FileCheck %s --check-prefix=CHECK-RETRY
+// RUN: diff -r %t.serial_retry %t.speculative
+// RUN: env IGC_ParallelKernelCompileThreads=4 IGC_PrintParallelKernelCompile=1 ocloc compile -file %s -device dg2 -options "-DUSE_GLOBAL" 2>&1 | FileCheck %s --check-prefix=CHECK-WHOLE
+
+// This test checks that compiling the kernels of a program on several threads
+// gives the same binary as compiling the program whole, also when the retry
+// state of each kernel is compiled speculatively next to its first state, and
+// that programs with program-scope variables are not split.
+
+// CHECK-SPLIT: IGC compiles 3 kernels on 4 threads
+// CHECK-SPLIT: Build succeeded.
+
+// CHECK-RETRY: IGC compiles 3 kernels on 4 threads
+// CHECK-RETRY-DAG: IGC takes the retry state of add from its speculative compile
+// CHECK-RETRY-DAG: IGC takes the retry state of sub from its speculative compile
+// CHECK-RETRY-DAG: IGC takes the retry state of mul from its speculative compile
+// CHECK-RETRY: Build succeeded.
+
+// CHECK-WHOLE: IGC compiles the program whole: it has program-scope variables
+// CHECK-WHOLE: Build succeeded.
+
+#ifdef USE_GLOBAL
+__constant int bias = 1;
+#define BIAS bias
+#else
+#define BIAS 1
+#endif
+
+__kernel void add(int a, int b, __global int *res) { *res = a + b + BIAS; }
+__kernel void sub(int a, int b, __global int *res) { *res = a - b; }
+__kernel void mul(int a, int b, __global int *res) { *res = a * b; }
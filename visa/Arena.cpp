@@ -8,6 +8,8 @@ SPDX-License-Identifier: MIT
 
 #include "Arena.h"
 
+#include <iomanip>
+
 #ifdef COLLECT_ALLOCATION_STATS
 int numAllocations = 0;
 int numMallocCalls = 0;
@@ -40,15 +42,109 @@ void *ArenaHeader::AllocSpace(size_t size, size_t al) {
   return allocSpace;
 }
 
-void ArenaManager::FreeArenas() {
-  while (_arenas) {
+void ArenaManager::FreeArena(ArenaHeader *arena) {
 #ifdef COLLECT_ALLOCATION_STATS
-    currentMallocSize -= _arenas->size;
+  currentMallocSize -= arena->size;
 #endif
-    unsigned char *killed = (unsigned char *)_arenas;
+  _reservedBytes -= arena->size;
+  if (_usage)
+    _usage->release(arena->size);
+  delete[] (unsigned char *)arena;
+}
+
+void ArenaManager::FreeArenas() {
+  // Free lists point into the arenas
+  ClearFreeLists();
+  while (_arenas) {
+    ArenaHeader *killed = _arenas;
     _arenas = _arenas->_nextArena;
-    delete[] killed;
+    FreeArena(killed);
   }
 
   _arenas = 0;
 }
+
+void ArenaManager::FreeSpareArena() {
+  if (_spareArena) {
+    FreeArena(_spareArena);
+    _spareArena = nullptr;
+  }
+}
+
+void ArenaManager::Rollback(const Mark &mark) {
+  // Blocks in free lists may lie in space being released
+  ClearFreeLists();
+  while (_arenas != mark.arena) {
+    vASSERT(_arenas);
+    ArenaHeader *killed = _arenas;
+    _arenas = _arenas->_nextArena;
+    if (!_spareArena && killed->size == _defaultArenaSize) {
+      killed->_nextArena = nullptr;
+      _spareArena = killed;
+    } else {
+      FreeArena(killed);
+    }
+  }
+  _arenas->_nextByte = mark.nextByte;
+}
+
+std::shared_ptr<ArenaUsage> &ArenaUsage::current() {
+  static thread_local std::shared_ptr<ArenaUsage> usage;
+  return usage;
+}
+
+ArenaUsage::Scope::Scope(std::shared_ptr<ArenaUsage> usage)
+    : prev(std::move(current())) {
+  current() = std::move(usage);
+}
+
+ArenaUsage::Scope::~Scope() { current() = std::move(prev); }
+
+static void updatePeak(std::atomic<size_t> &peak, size_t bytes) {
+  size_t oldPeak = peak.load();
+  while (bytes > oldPeak && !peak.compare_exchange_weak(oldPeak, bytes))
+    ;
+}
+
+void ArenaUsage::reserve(size_t bytes) {
+  size_t bytesNow = currentBytes.fetch_add(bytes) + bytes;
+  updatePeak(peakBytes, bytesNow);
+  updatePeak(phasePeakBytes, bytesNow);
+}
+
+void ArenaUsage::release(size_t bytes) { currentBytes.fetch_sub(bytes); }
+
+void ArenaUsage::beginPhase(const char *name) {
+  endPhase();
+  Phase phase;
+  phase.name = name;
+  phase.startBytes = currentBytes.load();
+  phases.push_back(phase);
+  phasePeakBytes.store(phase.startBytes);
+  inPhase = true;
+}
+
+void ArenaUsage::endPhase() {
+  if (!inPhase)
+    return;
+  phases.back().endBytes = currentBytes.load();
+  phases.back().peakBytes = phasePeakBytes.load();
+  inPhase = false;
+}
+
+void ArenaUsage::dump(std::ostream &os, const char *kernelName) const {
+  auto toKB = [](size_t bytes) { return (bytes + 1023) / 1024; };
+  os << "Arena usage for " << kernelName << ": peak " << toKB(getPeakBytes())
+     << " KB, current " << toKB(getCurrentBytes()) << " KB\n";
+  if (phases.empty())
+    return;
+  os << "  " << std::left << std::setw(32) << "phase" << std::right
+     << std::setw(12) << "start(KB)" << std::setw(12) << "peak(KB)"
+     << std::setw(12) << "end(KB)" << "\n";
+  for (auto &phase : phases) {
+    os << "  " << std::left << std::setw(32) << phase.name << std::right
+       << std::setw(12) << toKB(phase.startBytes) << std::setw(12)
+       << toKB(phase.peakBytes) << std::setw(12) << toKB(phase.endBytes)
+       << "\n";
+  }
+}
@@ -14,9 +14,13 @@ SPDX-License-Identifier: MIT
 #define _ARENA_H_
 
 #include <assert.h>
+#include <atomic>
 #include <cstddef>
 #include <iostream>
+#include <memory>
 #include <stdlib.h>
+#include <string>
+#include <vector>
 
 #include "Assertions.h"
 #include "Option.h"
@@ -35,6 +39,57 @@ extern int currentMallocSize;
 
 namespace vISA {
 class Mem_Manager;
+
+// Tracks the bytes reserved by every arena attached to it, and their peak.
+// One instance is used per kernel when -dumpArenaUsage is given. Arenas
+// created while an ArenaUsage::Scope is active on a thread are attached to
+// its instance. Counters are atomic as arenas of one kernel may be used by
+// several threads.
+class ArenaUsage {
+public:
+  struct Phase {
+    std::string name;
+    size_t startBytes = 0;
+    size_t endBytes = 0;
+    size_t peakBytes = 0;
+  };
+
+  // Make usage the tracker for arenas created on this thread, for the
+  // lifetime of the Scope.
+  class Scope {
+    std::shared_ptr<ArenaUsage> prev;
+
+  public:
+    explicit Scope(std::shared_ptr<ArenaUsage> usage);
+    ~Scope();
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+  };
+
+  // Tracker for arenas created on this thread, may be null.
+  static std::shared_ptr<ArenaUsage> &current();
+
+  void reserve(size_t bytes);
+  void release(size_t bytes);
+
+  size_t getCurrentBytes() const { return currentBytes.load(); }
+  size_t getPeakBytes() const { return peakBytes.load(); }
+
+  // Phases are sequential; beginning a phase ends the previous one.
+  void beginPhase(const char *name);
+  void endPhase();
+  const std::vector<Phase> &getPhases() const { return phases; }
+
+  void dump(std::ostream &os, const char *kernelName) const;
+
+private:
+  std::atomic<size_t> currentBytes{0};
+  std::atomic<size_t> peakBytes{0};
+  std::atomic<size_t> phasePeakBytes{0};
+  std::vector<Phase> phases;
+  bool inPhase = false;
+};
+
 class ArenaHeader {
   friend class ArenaManager;
 
@@ -99,15 +154,39 @@ private:
 class ArenaManager {
   friend class Mem_Manager;
 
+public:
+  // Allocation state of an ArenaManager that it can be rolled back to.
+  struct Mark {
+    ArenaHeader *arena;
+    unsigned char *nextByte;
+  };
+
 private:
+  // Freed blocks of up to MaxSizeClassBytes are kept in per-size free lists
+  // and handed out again by later allocations of the same size class.
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+  static constexpr size_t MaxSizeClassBytes = 256;
+  static constexpr size_t NumSizeClasses =
+      MaxSizeClassBytes / ArenaHeader::defaultAlign;
+
+  static size_t GetSizeClass(size_t size) {
+    return ArenaHeader::DefaultAlign(size) / ArenaHeader::defaultAlign - 1;
+  }
+
   // Functions
 
   ArenaManager(size_t defaultArenaSize)
-      : _arenas(0), _defaultArenaSize(defaultArenaSize) {
+      : _arenas(0), _defaultArenaSize(defaultArenaSize),
+        _usage(ArenaUsage::current()) {
     CreateArena(_defaultArenaSize);
   }
 
-  ~ArenaManager() { FreeArenas(); }
+  ~ArenaManager() {
+    FreeArenas();
+    FreeSpareArena();
+  }
   ArenaManager(const ArenaManager&) = delete;
   ArenaManager& operator=(const ArenaManager&) = delete;
 
@@ -120,6 +199,15 @@ private:
     void *space = nullptr;
 
     if (size) {
+      if (size <= MaxSizeClassBytes && al <= ArenaHeader::defaultAlign) {
+        FreeBlock *&freeList = _freeLists[GetSizeClass(size)];
+        if (freeList) {
+          space = freeList;
+          freeList = freeList->next;
+          return space;
+        }
+      }
+
       space = _arenas->AllocSpace(size, al);
 
       if (space == 0) {
@@ -138,18 +226,48 @@ private:
     return space;
   }
 
+  // Return a block of given size allocated from this ArenaManager so that
+  // a later allocation can reuse it. Large blocks are only reclaimed when
+  // the arenas are freed.
+  void FreeDataSpace(void *space, size_t size) {
+#if !defined(NDEBUG) && defined(vISA_DEBUG_MEM_ALLOC)
+    free(space);
+    return;
+#endif
+    if (!space || size == 0 || size > MaxSizeClassBytes)
+      return;
+    FreeBlock *block = static_cast<FreeBlock *>(space);
+    FreeBlock *&freeList = _freeLists[GetSizeClass(size)];
+    block->next = freeList;
+    freeList = block;
+  }
+
+  Mark GetMark() const { return {_arenas, _arenas->_nextByte}; }
+
+  // Release everything allocated since mark was taken. Arenas created since
+  // then are freed, except that one of default size is kept for reuse.
+  void Rollback(const Mark &mark);
+
   ArenaHeader *CreateArena(size_t size) {
     size_t arenaDataSize =
         (size > _defaultArenaSize) ? size : _defaultArenaSize;
     arenaDataSize = ArenaHeader::DefaultAlign(arenaDataSize);
-    unsigned char *arena =
-        new unsigned char[ArenaHeader::GetArenaSize(arenaDataSize)];
 
-    ArenaHeader *newArena = new (arena) ArenaHeader(arenaDataSize, _arenas);
-    // Add new arena to the head of queue
-    if (_arenas != NULL) {
-      newArena->_nextArena = _arenas;
+    ArenaHeader *newArena = nullptr;
+    if (_spareArena && _spareArena->size >= arenaDataSize) {
+      newArena = _spareArena;
+      _spareArena = nullptr;
+      newArena->_nextByte = newArena->GetArenaData();
+    } else {
+      unsigned char *arena =
+          new unsigned char[ArenaHeader::GetArenaSize(arenaDataSize)];
+      newArena = new (arena) ArenaHeader(arenaDataSize, _arenas);
+      _reservedBytes += arenaDataSize;
+      if (_usage)
+        _usage->reserve(arenaDataSize);
     }
+    // Add new arena to the head of queue
+    newArena->_nextArena = _arenas;
 
     _arenas = newArena;
 
@@ -174,11 +292,23 @@ private:
   }
 
   void FreeArenas();
+  void FreeArena(ArenaHeader *arena);
+  void FreeSpareArena();
+  void ClearFreeLists() {
+    for (auto &freeList : _freeLists)
+      freeList = nullptr;
+  }
 
   // Data
 
   ArenaHeader *_arenas;
+  // Arena released by Rollback that is reused by next CreateArena
+  ArenaHeader *_spareArena = nullptr;
+  FreeBlock *_freeLists[NumSizeClasses] = {};
   const size_t _defaultArenaSize;
+  // Bytes reserved from system, including spare arena
+  size_t _reservedBytes = 0;
+  std::shared_ptr<ArenaUsage> _usage;
 };
 } // namespace vISA
 #endif
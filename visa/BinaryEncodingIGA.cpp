@@ -15,8 +15,11 @@ SPDX-License-Identifier: MIT
 
 #include <fstream>
 #include <map>
+#include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 using namespace iga;
 using namespace vISA;
@@ -35,6 +38,8 @@ class BinaryEncodingIGA {
   Kernel *IGAKernel = nullptr;
   const Model *platformModel;
   const TARGET_PLATFORM platform;
+  // Sizes the IGA kernel's arenas and the G4-to-IGA instruction map.
+  size_t numG4Insts = 0;
 
 public:
   BinaryEncodingIGA(vISA::G4_Kernel &k, const std::string& fname);
@@ -62,7 +67,7 @@ private:
   BinaryEncodingIGA(const BinaryEncodingIGA &other);
   BinaryEncodingIGA &operator=(const BinaryEncodingIGA &other);
 
-  std::map<G4_Label *, Block *> labelToBlockMap;
+  std::unordered_map<G4_Label *, Block *> labelToBlockMap;
 
 public:
   static ExecSize getIGAExecSize(int execSize);
@@ -410,7 +415,9 @@ BinaryEncodingIGA::getIGAInternalPlatform(TARGET_PLATFORM genxPlatform) {
 BinaryEncodingIGA::BinaryEncodingIGA(vISA::G4_Kernel &k, const std::string& fname)
     : kernel(k), fileName(fname), platform(k.fg.builder->getPlatform()) {
   platformModel = Model::LookupModel(getIGAInternalPlatform(platform));
-  IGAKernel = new Kernel(*platformModel);
+  for (auto bb : kernel.fg)
+    numG4Insts += bb->size();
+  IGAKernel = new Kernel(*platformModel, numG4Insts);
 }
 
 SWSB_ENCODE_MODE BinaryEncodingIGA::getIGASWSBEncodeMode() const {
@@ -1282,18 +1289,69 @@ void BinaryEncodingIGA::Encode() {
     }
   }
 
+  bool autoCompact = kernel.getOption(vISA_Compaction);
+  if (platform == Xe_PVC)
+    autoCompact = false; // PVC-A0 compaction is off (IGA only does B0+)
+  bool compactRestrict = autoCompact &&
+                         (platform == TARGET_PLATFORM::Xe3P_CRI ||
+                          platform == TARGET_PLATFORM::Xe3P_Graphics ||
+                          platform == TARGET_PLATFORM::Xe2);
+  int dumpJSON = kernel.fg.builder->getuint32Option(vISA_dumpIgaJson);
+  SWSB_ENCODE_MODE swsbEncodeMode = getIGASWSBEncodeMode();
+
+  if (m_kernelBuffer) {
+    m_kernelBufferSize = 0;
+    delete static_cast<uint8_t *>(m_kernelBuffer);
+    m_kernelBuffer = nullptr;
+  }
+
+  // With -igaStreamEncode each instruction is encoded right after it is
+  // translated, and the IGA kernel never holds the blocks. The passes that
+  // need the whole kernel (IGA swsb, compaction restriction, JSON dump) use
+  // the regular encoder.
+  std::unique_ptr<KernelStreamEncoder> streamEncoder;
+  size_t numStreamedInsts = 0;
+  if (kernel.getOption(vISA_IGAStreamEncode) && !compactRestrict &&
+      !kernel.getOption(vISA_EnableIGASWSB) && !dumpJSON) {
+    size_t maxInsts = 0;
+    for (auto bb : kernel.fg) {
+      for (auto inst : *bb) {
+        if (inst->isLabel())
+          continue;
+        maxInsts += 1 + (inst->requireNopAfter() ? 1 : 0) +
+                    (inst->isCachelineAligned() ? 2 : 0);
+      }
+    }
+    streamEncoder = std::make_unique<KernelStreamEncoder>(
+        IGAKernel, autoCompact, swsbEncodeMode, maxInsts);
+  }
+  auto appendBlock = [&](Block *blk) {
+    if (streamEncoder)
+      streamEncoder->startBlock(blk);
+    else
+      IGAKernel->appendBlock(blk);
+  };
+  auto appendInstruction = [&](Block *blk, Instruction *igaInst) {
+    if (streamEncoder) {
+      streamEncoder->encode(igaInst);
+      numStreamedInsts++;
+    } else {
+      blk->appendInstruction(igaInst);
+    }
+  };
+
   if (!isFirstInstLabel()) {
     // create a new BB if kernel does not start with label
     currBB = IGAKernel->createBlock();
-    IGAKernel->appendBlock(currBB);
+    appendBlock(currBB);
   }
 
   auto platformGen = kernel.getPlatformGeneration();
-  std::list<std::pair<Instruction *, G4_INST *>> encodedInsts;
+  std::vector<std::pair<Instruction *, G4_INST *>> encodedInsts;
+  if (!streamEncoder)
+    encodedInsts.reserve(numG4Insts);
   Block *bbNew = nullptr;
 
-  SWSB_ENCODE_MODE swsbEncodeMode = getIGASWSBEncodeMode();
-
   for (auto bb : this->kernel.fg) {
     for (auto inst : *bb) {
       bbNew = nullptr;
@@ -1303,7 +1361,7 @@ void BinaryEncodingIGA::Encode() {
         // (e.g., multiple endifs)
         G4_Label *label = inst->getLabel();
         currBB = lookupIGABlock(label, *IGAKernel);
-        IGAKernel->appendBlock(currBB);
+        appendBlock(currBB);
         continue;
       }
 
@@ -1339,45 +1397,46 @@ void BinaryEncodingIGA::Encode() {
       igaInst->validate();
 #endif
       vASSERT(currBB);
-      currBB->appendInstruction(igaInst);
+      appendInstruction(currBB, igaInst);
+      // the PC of a streamed instruction is final once it is encoded
+      if (streamEncoder)
+        inst->setGenOffset(igaInst->getPC());
 
       if (inst->requireNopAfter()) {
         Instruction *igaInst = IGAKernel->createNopInstruction();
-        currBB->appendInstruction(igaInst);
+        appendInstruction(currBB, igaInst);
       }
 
       if (bbNew) {
         // Fall through block is created.
         // So the new block needs to become current block
         // so that jump offsets can be calculated correctly
+        appendBlock(bbNew);
         currBB = bbNew;
       }
       // If, in future, we generate multiple binary inst
       // for a single G4_INST, then it should be safe to
       // make pair between the G4_INST and first encoded
       // binary inst.
-      encodedInsts.emplace_back(igaInst, inst);
+      if (!streamEncoder)
+        encodedInsts.emplace_back(igaInst, inst);
     }
   }
 
-  kernel.setAsmCount(IGAKernel->getInstructionCount());
-
-  if (m_kernelBuffer) {
-    m_kernelBufferSize = 0;
-    delete static_cast<uint8_t *>(m_kernelBuffer);
-    m_kernelBuffer = nullptr;
-  }
-
-  { // time the encoding
+  if (streamEncoder) {
+    kernel.setAsmCount(numStreamedInsts);
     TIME_SCOPE(IGA_ENCODER);
-    bool autoCompact = kernel.getOption(vISA_Compaction);
-    if (platform == Xe_PVC)
-      autoCompact = false; // PVC-A0 compaction is off (IGA only does B0+)
+    streamEncoder->finish(kernel.fg.builder->criticalMsgStream());
+    m_kernelBufferSize = streamEncoder->getBinarySize();
+    m_kernelBuffer = allocCodeBlock(m_kernelBufferSize);
+    memcpy_s(m_kernelBuffer, m_kernelBufferSize, streamEncoder->getBinary(),
+             m_kernelBufferSize);
+  } else { // time the encoding
+    kernel.setAsmCount(IGAKernel->getInstructionCount());
 
+    TIME_SCOPE(IGA_ENCODER);
     KernelEncoder encoder(IGAKernel, autoCompact);
-    if (autoCompact && (platform == TARGET_PLATFORM::Xe3P_CRI ||
-                        platform == TARGET_PLATFORM::Xe3P_Graphics ||
-                        platform == TARGET_PLATFORM::Xe2))
+    if (compactRestrict)
       encoder.enableCompactRestrict();
     encoder.setSWSBEncodingMode(swsbEncodeMode);
 
@@ -1435,7 +1494,6 @@ void BinaryEncodingIGA::Encode() {
         kernel.getComputeFFIDGP1NextOff();
   }
 
-  int dumpJSON = kernel.fg.builder->getuint32Option(vISA_dumpIgaJson);
   if (dumpJSON) {
     EmitJSON(dumpJSON);
   }
@@ -1652,9 +1710,9 @@ void BinaryEncodingIGA::translateInstructionBranchSrcs(G4_INST *inst,
                             Type::UD);
   } else {
     // Creating a fall through block
+    // Encode() starts it after this instruction
     bbNew = IGAKernel->createBlock();
     igaInst->setLabelSource(SourceIndex::SRC0, bbNew, Type::UD);
-    IGAKernel->appendBlock(bbNew);
   }
 }
 
@@ -93,28 +93,12 @@ void BitSet::invert(void) {
   }
 }
 
-template <typename T>
-void vector_and(T *__restrict p1, const T *const p2, unsigned n) {
-  for (unsigned i = 0; i < n; ++i) {
-    p1[i] &= p2[i];
-  }
-}
-
-template <typename T>
-void vector_or(T *__restrict p1, const T *const p2, unsigned n) {
-  for (unsigned i = 0; i < n; ++i) {
-    p1[i] |= p2[i];
-  }
-}
-
-template <typename T>
-void vector_minus(T *__restrict p1, const T *const p2, unsigned n) {
-  for (unsigned i = 0; i < n; ++i) {
-    p1[i] &= ~p2[i];
-  }
+BitSet &BitSet::operator|=(const BitSet &other) {
+  unionWith(other);
+  return *this;
 }
 
-BitSet &BitSet::operator|=(const BitSet &other) {
+bool BitSet::unionWith(const BitSet &other) {
   unsigned size = other.m_Size;
 
   // grow the set to the size of the other set if necessary
@@ -124,16 +108,16 @@ BitSet &BitSet::operator|=(const BitSet &other) {
   }
 
   unsigned arraySize = (size + NUM_BITS_PER_ELT - 1) / NUM_BITS_PER_ELT;
-  vector_or(m_BitSetArray, other.m_BitSetArray, arraySize);
-
-  return *this;
+  return vISA::BitSetOps::unionWith(m_BitSetArray, other.m_BitSetArray,
+                                    arraySize);
 }
 
 BitSet &BitSet::operator-=(const BitSet &other) {
   // do not grow the set for subtract
   unsigned size = m_Size < other.m_Size ? m_Size : other.m_Size;
   unsigned arraySize = (size + NUM_BITS_PER_ELT - 1) / NUM_BITS_PER_ELT;
-  vector_minus(m_BitSetArray, other.m_BitSetArray, arraySize);
+  vISA::BitSetOps::intersectWithComplement(m_BitSetArray, other.m_BitSetArray,
+                                           arraySize);
   return *this;
 }
 
@@ -141,7 +125,7 @@ BitSet &BitSet::operator&=(const BitSet &other) {
   // do not grow the set for and
   unsigned size = m_Size < other.m_Size ? m_Size : other.m_Size;
   unsigned arraySize = (size + NUM_BITS_PER_ELT - 1) / NUM_BITS_PER_ELT;
-  vector_and(m_BitSetArray, other.m_BitSetArray, arraySize);
+  vISA::BitSetOps::intersectWith(m_BitSetArray, other.m_BitSetArray, arraySize);
 
   // zero out the leftover bits if there are any
   unsigned myArraySize = (m_Size + NUM_BITS_PER_ELT - 1) / NUM_BITS_PER_ELT;
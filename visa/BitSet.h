@@ -9,6 +9,7 @@ SPDX-License-Identifier: MIT
 #ifndef _BITSET_H_
 #define _BITSET_H_
 
+#include "BitSetOps.h"
 #include "Mem_Manager.h"
 #include <cstdlib>
 #include <cstring>
@@ -296,6 +297,8 @@ public:
   }
 
   BitSet &operator|=(const BitSet &other);
+  // Same as operator|=, but returns true if this set changed.
+  bool unionWith(const BitSet &other);
   BitSet &operator&=(const BitSet &other);
   BitSet &operator-=(const BitSet &other);
 
@@ -378,20 +381,17 @@ public:
   }
 
   FixedBitSet &operator&=(const FixedBitSet &Other) {
-    for (unsigned i = 0; i < NumWords; ++i)
-      Bits[i] &= Other.Bits[i];
+    vISA::BitSetOps::intersectWith(Bits, Other.Bits, NumWords);
     return *this;
   }
 
   FixedBitSet &operator|=(const FixedBitSet &Other) {
-    for (unsigned i = 0; i < NumWords; ++i)
-      Bits[i] |= Other.Bits[i];
+    vISA::BitSetOps::unionWith(Bits, Other.Bits, NumWords);
     return *this;
   }
 
   FixedBitSet &operator-=(const FixedBitSet &Other) {
-    for (unsigned i = 0; i < NumWords; ++i)
-      Bits[i] &= ~Other.Bits[i];
+    vISA::BitSetOps::intersectWithComplement(Bits, Other.Bits, NumWords);
     return *this;
   }
 };
@@ -0,0 +1,215 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "BitSetOps.h"
+
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||           \
+    defined(_M_IX86)
+#define VISA_BITSET_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define VISA_TARGET(x)
+#else
+#define VISA_TARGET(x) __attribute__((target(x)))
+#endif
+#endif
+
+using namespace vISA;
+using namespace vISA::BitSetOps;
+
+namespace {
+
+// The scalar kernels work on 8-byte chunks and finish with a 4-byte one, so
+// they serve both the 32-bit BitSet words and the 64-bit sparse words.
+#define VISA_SCALAR_KERNEL(Name, Combine)                                      \
+  bool Name##Scalar(void *dst, const void *src, size_t numBytes) {             \
+    auto *d = static_cast<unsigned char *>(dst);                               \
+    auto *s = static_cast<const unsigned char *>(src);                         \
+    uint64_t changed = 0;                                                      \
+    size_t i = 0;                                                              \
+    for (; i + sizeof(uint64_t) <= numBytes; i += sizeof(uint64_t)) {          \
+      uint64_t a, b;                                                           \
+      memcpy(&a, d + i, sizeof(a));                                            \
+      memcpy(&b, s + i, sizeof(b));                                            \
+      uint64_t r = Combine(a, b);                                              \
+      changed |= a ^ r;                                                        \
+      memcpy(d + i, &r, sizeof(r));                                            \
+    }                                                                          \
+    if (i < numBytes) {                                                        \
+      uint32_t a, b;                                                           \
+      memcpy(&a, d + i, sizeof(a));                                            \
+      memcpy(&b, s + i, sizeof(b));                                            \
+      uint32_t r = Combine(a, b);                                              \
+      changed |= a ^ r;                                                        \
+      memcpy(d + i, &r, sizeof(r));                                            \
+    }                                                                          \
+    return changed != 0;                                                       \
+  }
+
+#define SCALAR_OR(a, b) ((a) | (b))
+#define SCALAR_AND(a, b) ((a) & (b))
+#define SCALAR_ANDNOT(a, b) ((a) & ~(b))
+
+VISA_SCALAR_KERNEL(unionWith, SCALAR_OR)
+VISA_SCALAR_KERNEL(intersectWith, SCALAR_AND)
+VISA_SCALAR_KERNEL(intersectWithComplement, SCALAR_ANDNOT)
+
+const Kernels ScalarKernels = {unionWithScalar, intersectWithScalar,
+                               intersectWithComplementScalar};
+
+#ifdef VISA_BITSET_X86
+#define VISA_AVX2_KERNEL(Name, Combine)                                        \
+  VISA_TARGET("avx2")                                                          \
+  bool Name##AVX2(void *dst, const void *src, size_t numBytes) {               \
+    auto *d = static_cast<unsigned char *>(dst);                               \
+    auto *s = static_cast<const unsigned char *>(src);                         \
+    __m256i changed = _mm256_setzero_si256();                                  \
+    size_t i = 0;                                                              \
+    for (; i + sizeof(__m256i) <= numBytes; i += sizeof(__m256i)) {            \
+      __m256i a = _mm256_loadu_si256(reinterpret_cast<__m256i *>(d + i));     \
+      __m256i b =                                                              \
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));        \
+      __m256i r = Combine(a, b);                                               \
+      changed = _mm256_or_si256(changed, _mm256_xor_si256(a, r));              \
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(d + i), r);              \
+    }                                                                          \
+    bool tailChanged = Name##Scalar(d + i, s + i, numBytes - i);               \
+    return !_mm256_testz_si256(changed, changed) || tailChanged;               \
+  }
+
+#define AVX2_OR(a, b) _mm256_or_si256(a, b)
+#define AVX2_AND(a, b) _mm256_and_si256(a, b)
+#define AVX2_ANDNOT(a, b) _mm256_andnot_si256(b, a)
+
+VISA_AVX2_KERNEL(unionWith, AVX2_OR)
+VISA_AVX2_KERNEL(intersectWith, AVX2_AND)
+VISA_AVX2_KERNEL(intersectWithComplement, AVX2_ANDNOT)
+
+const Kernels AVX2Kernels = {unionWithAVX2, intersectWithAVX2,
+                             intersectWithComplementAVX2};
+
+#define VISA_AVX512_KERNEL(Name, Combine)                                      \
+  VISA_TARGET("avx512f")                                                       \
+  bool Name##AVX512(void *dst, const void *src, size_t numBytes) {             \
+    auto *d = static_cast<unsigned char *>(dst);                               \
+    auto *s = static_cast<const unsigned char *>(src);                         \
+    __m512i changed = _mm512_setzero_si512();                                  \
+    size_t i = 0;                                                              \
+    for (; i + sizeof(__m512i) <= numBytes; i += sizeof(__m512i)) {            \
+      __m512i a = _mm512_loadu_si512(d + i);                                   \
+      __m512i b = _mm512_loadu_si512(s + i);                                   \
+      __m512i r = Combine(a, b);                                               \
+      changed = _mm512_or_si512(changed, _mm512_xor_si512(a, r));              \
+      _mm512_storeu_si512(d + i, r);                                           \
+    }                                                                          \
+    bool tailChanged = Name##Scalar(d + i, s + i, numBytes - i);               \
+    return _mm512_test_epi64_mask(changed, changed) != 0 || tailChanged;       \
+  }
+
+#define AVX512_OR(a, b) _mm512_or_si512(a, b)
+#define AVX512_AND(a, b) _mm512_and_si512(a, b)
+// a & ~b, spelled without _mm512_andnot_si512, whose undefined pass-through
+// operand makes some GCC versions warn.
+#define AVX512_ANDNOT(a, b) _mm512_xor_si512(a, _mm512_and_si512(a, b))
+
+VISA_AVX512_KERNEL(unionWith, AVX512_OR)
+VISA_AVX512_KERNEL(intersectWith, AVX512_AND)
+VISA_AVX512_KERNEL(intersectWithComplement, AVX512_ANDNOT)
+
+const Kernels AVX512Kernels = {unionWithAVX512, intersectWithAVX512,
+                               intersectWithComplementAVX512};
+
+ISA detectHostISA() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+    return ISA::Scalar;
+  __cpuid(info, 1);
+  // The OS must save the wider registers on context switch.
+  if ((info[2] & (1 << 27)) == 0)
+    return ISA::Scalar;
+  unsigned long long xcr0 = _xgetbv(0);
+  if ((xcr0 & 0x6) != 0x6)
+    return ISA::Scalar;
+  __cpuidex(info, 7, 0);
+  if ((info[1] & (1 << 16)) && (xcr0 & 0xe0) == 0xe0)
+    return ISA::AVX512;
+  if (info[1] & (1 << 5))
+    return ISA::AVX2;
+  return ISA::Scalar;
+#else
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    return ISA::AVX512;
+  if (__builtin_cpu_supports("avx2"))
+    return ISA::AVX2;
+  return ISA::Scalar;
+#endif
+}
+#else
+ISA detectHostISA() { return ISA::Scalar; }
+#endif // VISA_BITSET_X86
+
+const Kernels &getKernelsFor(ISA isa) {
+  switch (isa) {
+#ifdef VISA_BITSET_X86
+  case ISA::AVX512:
+    return AVX512Kernels;
+  case ISA::AVX2:
+    return AVX2Kernels;
+#endif
+  default:
+    return ScalarKernels;
+  }
+}
+
+std::atomic<ISA> &currentISA() {
+  static std::atomic<ISA> isa(getHostISA());
+  return isa;
+}
+
+std::atomic<const Kernels *> &currentKernels() {
+  static std::atomic<const Kernels *> kernels(&getKernelsFor(getHostISA()));
+  return kernels;
+}
+
+} // namespace
+
+ISA BitSetOps::getHostISA() {
+  static const ISA hostISA = detectHostISA();
+  return hostISA;
+}
+
+ISA BitSetOps::getISA() { return currentISA().load(std::memory_order_relaxed); }
+
+void BitSetOps::setISA(ISA isa) {
+  if (static_cast<int>(isa) > static_cast<int>(getHostISA()))
+    isa = getHostISA();
+  currentISA().store(isa, std::memory_order_relaxed);
+  currentKernels().store(&getKernelsFor(isa), std::memory_order_relaxed);
+}
+
+const char *BitSetOps::getISAName(ISA isa) {
+  switch (isa) {
+  case ISA::AVX512:
+    return "avx512";
+  case ISA::AVX2:
+    return "avx2";
+  default:
+    return "scalar";
+  }
+}
+
+const Kernels &BitSetOps::getKernels() {
+  return *currentKernels().load(std::memory_order_relaxed);
+}
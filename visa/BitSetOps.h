@@ -0,0 +1,91 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// Word-array kernels for the set operations of BitSet, SparseBitSet and
+// FastSparseBitVector. The AVX2 and AVX-512 versions are selected at runtime
+// from what the host supports; other hosts use the scalar version.
+
+#ifndef _BITSETOPS_H_
+#define _BITSETOPS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vISA {
+namespace BitSetOps {
+
+enum class ISA { Scalar, AVX2, AVX512 };
+
+// Returns the kernels currently in use.
+ISA getISA();
+// Returns the best kernels the host supports.
+ISA getHostISA();
+// Selects the kernels to use, clamped to what the host supports. Meant for
+// benchmarks; it is not safe to call while other threads use the kernels.
+void setISA(ISA isa);
+const char *getISAName(ISA isa);
+
+// Every kernel updates dst in place over numBytes bytes, which must be a
+// multiple of 4, and returns true if dst changed.
+using Kernel = bool (*)(void *dst, const void *src, size_t numBytes);
+
+struct Kernels {
+  Kernel unionWith;               // dst |= src
+  Kernel intersectWith;           // dst &= src
+  Kernel intersectWithComplement; // dst &= ~src
+};
+
+const Kernels &getKernels();
+
+// Arrays shorter than this are not worth a call through the dispatch table.
+constexpr size_t MinDispatchBytes = 64;
+
+template <typename T>
+inline bool unionWith(T *dst, const T *src, size_t numWords) {
+  if (numWords * sizeof(T) >= MinDispatchBytes)
+    return getKernels().unionWith(dst, src, numWords * sizeof(T));
+  T changed = 0;
+  for (size_t i = 0; i < numWords; ++i) {
+    T old = dst[i];
+    dst[i] |= src[i];
+    changed |= old ^ dst[i];
+  }
+  return changed != 0;
+}
+
+template <typename T>
+inline bool intersectWith(T *dst, const T *src, size_t numWords) {
+  if (numWords * sizeof(T) >= MinDispatchBytes)
+    return getKernels().intersectWith(dst, src, numWords * sizeof(T));
+  T changed = 0;
+  for (size_t i = 0; i < numWords; ++i) {
+    T old = dst[i];
+    dst[i] &= src[i];
+    changed |= old ^ dst[i];
+  }
+  return changed != 0;
+}
+
+template <typename T>
+inline bool intersectWithComplement(T *dst, const T *src, size_t numWords) {
+  if (numWords * sizeof(T) >= MinDispatchBytes)
+    return getKernels().intersectWithComplement(dst, src,
+                                                numWords * sizeof(T));
+  T changed = 0;
+  for (size_t i = 0; i < numWords; ++i) {
+    T old = dst[i];
+    dst[i] &= ~src[i];
+    changed |= old ^ dst[i];
+  }
+  return changed != 0;
+}
+
+} // namespace BitSetOps
+} // namespace vISA
+
+#endif // _BITSETOPS_H_
@@ -97,6 +97,11 @@ public:
   VISA_BUILDER_API int ParseVISAText(const std::string &visaText,
                                      const std::string &visaTextFile) override;
   VISA_BUILDER_API int ParseVISAText(const std::string &visaFile) override;
+  VISA_BUILDER_API int
+  ParseLinkedVISAText(const std::vector<const char *> &visaTexts,
+                      unsigned &failedText) override;
+  VISA_BUILDER_API int ParseVISAFragment(VISAKernel *kernel,
+                                         const std::string &visaText) override;
   VISA_BUILDER_API std::stringstream &GetAsmTextStream() override {
     return m_ssIsaAsm;
   }
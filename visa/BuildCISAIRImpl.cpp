@@ -244,6 +244,16 @@ int CISA_IR_Builder::CreateBuilder(CISA_IR_Builder *&builder,
   builder->m_options.getOptionsFromEV();
 #endif
 
+  // IGC enables the compile trace before it creates a builder. Otherwise the
+  // trace starts here, so open the spans of the timers started above.
+  const char *tracePath =
+      builder->m_options.getOptionCstr(vISA_CompileTraceFile);
+  if (tracePath && !vISA::trace::isEnabled()) {
+    vISA::trace::enable(tracePath, 1);
+    traceTimer(TimerID::TOTAL, true);
+    traceTimer(TimerID::BUILDER, true);
+  }
+
 #if !defined(NDEBUG) && !defined(DLL_MODE)
   auto debugPassesCstr = builder->m_options.getOptionCstr(vISA_DebugOnly);
   if (debugPassesCstr) {
@@ -1536,6 +1546,17 @@ extern int CISAlex_destroy(void);
 static std::mutex mtx;
 extern void resetGlobalVariables();
 
+// Lexes and parses one null-terminated vISA text. The caller holds mtx.
+static int parseVISABuffer(CISA_IR_Builder *builder, const char *visaText) {
+  resetGlobalVariables();
+  YY_BUFFER_STATE visaBuf = CISA_scan_string(visaText);
+  int status = CISAparse(builder) != 0 ? VISA_FAILURE : VISA_SUCCESS;
+  CISA_delete_buffer(visaBuf);
+  CISAlex_destroy();
+  resetGlobalVariables();
+  return status;
+}
+
 int CISA_IR_Builder::ParseVISAText(const std::string &visaText,
                                    const std::string &visaTextFile) {
   const std::lock_guard<std::mutex> lock(mtx);
@@ -1557,9 +1578,7 @@ int CISA_IR_Builder::ParseVISAText(const std::string &visaText,
     }
   }
 
-  resetGlobalVariables();
-  YY_BUFFER_STATE visaBuf = CISA_scan_string(visaText.c_str());
-  if (CISAparse(this) != 0) {
+  if (parseVISABuffer(this, visaText.c_str()) != VISA_SUCCESS) {
 #ifndef DLL_MODE
     std::cerr << "Parsing visa text failed.";
     if (!visaTextFile.empty()) {
@@ -1569,12 +1588,9 @@ int CISA_IR_Builder::ParseVISAText(const std::string &visaText,
 #endif // DLL_MODE
     status = VISA_FAILURE;
   }
-  CISA_delete_buffer(visaBuf);
   if (CISAout) {
     fclose(CISAout);
   }
-  CISAlex_destroy();
-  resetGlobalVariables();
 
   // run vISA verifier to cath any additional errors.
   // the subsequent vISABuilder::Compile() call is assumed to always succeed
@@ -1586,6 +1602,104 @@ int CISA_IR_Builder::ParseVISAText(const std::string &visaText,
   return status;
 }
 
+// Parses the modules of a link one after another. Verifying after each of
+// them would check the earlier modules again, so the verifier runs once.
+int CISA_IR_Builder::ParseLinkedVISAText(
+    const std::vector<const char *> &visaTexts, unsigned &failedText) {
+  const std::lock_guard<std::mutex> lock(mtx);
+  // Direct output of parser to null
+#if defined(_WIN32)
+  CISAout = fopen("nul", "w");
+#else
+  CISAout = fopen("/dev/null", "w");
+#endif
+
+  int status = VISA_SUCCESS;
+  failedText = 0;
+  for (unsigned i = 0, e = (unsigned)visaTexts.size(); i != e; ++i) {
+    failedText = i;
+    if (parseVISABuffer(this, visaTexts[i]) != VISA_SUCCESS) {
+#ifndef DLL_MODE
+      std::cerr << "Parsing visa text " << i << " of the link failed.\n"
+                << criticalMsg.str();
+#endif // DLL_MODE
+      status = VISA_FAILURE;
+      break;
+    }
+  }
+  if (CISAout) {
+    fclose(CISAout);
+  }
+
+  if (status == VISA_SUCCESS) {
+    status = verifyVISAIR();
+    if (status != VISA_SUCCESS)
+      failedText = ~0u;
+  }
+
+  return status;
+}
+
+// Parses a fragment of vISA text, such as one inline asm block, and appends
+// its instructions to kernel. Only the new instructions are verified, so the
+// kernel may still be under construction.
+int CISA_IR_Builder::ParseVISAFragment(VISAKernel *kernel,
+                                       const std::string &visaText) {
+  const std::lock_guard<std::mutex> lock(mtx);
+  vISA_ASSERT(m_options.getOption(vISA_InlineVISAFragments),
+              "variable names of the kernel are not recorded");
+  // Direct output of parser to null
+#if defined(_WIN32)
+  CISAout = fopen("nul", "w");
+#else
+  CISAout = fopen("/dev/null", "w");
+#endif
+
+  auto *fragmentKernel = static_cast<VISAKernelImpl *>(kernel);
+  auto lastInst = fragmentKernel->getInstructionListEnd();
+  const bool hadInsts = fragmentKernel->getInstructionListBegin() != lastInst;
+  if (hadInsts)
+    lastInst = std::prev(lastInst);
+
+  // The grammar expects a whole listing: a version followed by at least one
+  // statement. The trailing empty scope covers fragments that are only
+  // comments.
+  std::string listing =
+      printBuildVersion(getMajorVersion(), getMinorVersion()) + "\n" +
+      visaText + "\n{}\n";
+
+  VISAKernelImpl *savedKernel = m_kernel;
+  m_kernel = fragmentKernel;
+  m_options.setOptionInternally(vISA_isParseMode, true);
+  int status = parseVISABuffer(this, listing.c_str());
+  m_options.setOptionInternally(vISA_isParseMode, false);
+  m_kernel = savedKernel;
+  if (CISAout) {
+    fclose(CISAout);
+  }
+
+#ifndef IS_RELEASE_DLL
+  if (status == VISA_SUCCESS) {
+    VISAKernel_format_provider fmt(fragmentKernel);
+    vISAVerifier verifier(&fmt, getOptions(), fragmentKernel->getIRBuilder());
+    for (auto iter = hadInsts ? std::next(lastInst)
+                              : fragmentKernel->getInstructionListBegin(),
+              iterEnd = fragmentKernel->getInstructionListEnd();
+         iter != iterEnd; ++iter) {
+      verifier.verifyInstruction((*iter)->getCISAInst());
+    }
+    if (verifier.hasErrors()) {
+      criticalMsgStream() << "Found " << verifier.getNumErrors()
+                          << " errors in vISA fragment, the last one is:\n"
+                          << verifier.getLastErrorFound().value_or("") << "\n";
+      status = VISA_FAILURE;
+    }
+  }
+#endif // IS_RELEASE_DLL
+
+  return status;
+}
+
 // Parses inline asm file from ShaderOverride
 int CISA_IR_Builder::ParseVISAText(const std::string &visaFile) {
   // Direct output of parser to null
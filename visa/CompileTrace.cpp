@@ -0,0 +1,310 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "CompileTrace.h"
+
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace vISA::trace;
+
+std::atomic<bool> vISA::trace::detail::Enabled(false);
+
+namespace {
+
+// Events are written out once this many have been recorded on a thread.
+constexpr size_t MAX_BUFFERED_EVENTS = 16 * 1024;
+
+struct Arg {
+  const char *key;
+  std::string str;
+  uint64_t num;
+  bool isNum;
+};
+
+struct Event {
+  uint64_t ns; // since the tracer was created
+  SpanID id;
+  bool isBegin;
+  // The args of an end event are args[argBegin, argEnd) of its buffer.
+  uint32_t argBegin;
+  uint32_t argEnd;
+};
+
+struct EventBuffer {
+  std::vector<Event> events;
+  std::vector<Arg> args;
+};
+
+struct SpanName {
+  std::string name;
+  const char *category;
+};
+
+class Tracer {
+  std::mutex mtx;
+  std::deque<SpanName> names;
+  std::unordered_map<std::string, SpanID> ids;
+  std::ofstream os;
+  bool configured = false;
+  bool wroteEvent = false;
+  int pid;
+
+  void writeEscaped(const std::string &str);
+
+public:
+  const std::chrono::steady_clock::time_point start;
+  std::atomic<unsigned> sampleRate{1};
+  std::atomic<uint64_t> numSamples{0};
+  std::atomic<int> activeSamples{0};
+  std::atomic<uint32_t> nextTid{1};
+
+  Tracer() : start(std::chrono::steady_clock::now()) {
+#ifdef _WIN32
+    pid = _getpid();
+#else
+    pid = getpid();
+#endif
+  }
+  ~Tracer() {
+    if (os.is_open())
+      os << (wroteEvent ? "\n]\n" : "[]\n");
+  }
+
+  bool enable(const char *path, unsigned rate);
+  SpanID intern(const std::string &name, const char *category);
+  void write(uint32_t tid, const EventBuffer &buf);
+
+  uint64_t now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  }
+};
+
+Tracer &getTracer() {
+  static Tracer T;
+  return T;
+}
+
+bool Tracer::enable(const char *path, unsigned rate) {
+  std::lock_guard<std::mutex> lock(mtx);
+  if (configured)
+    return false;
+  configured = true;
+  os.open(path, std::ios::out | std::ios::trunc);
+  if (!os)
+    return false;
+  sampleRate = rate;
+  return true;
+}
+
+SpanID Tracer::intern(const std::string &name, const char *category) {
+  std::string key = std::string(category) + '\0' + name;
+  std::lock_guard<std::mutex> lock(mtx);
+  auto it = ids.find(key);
+  if (it != ids.end())
+    return it->second;
+  SpanID id = (SpanID)names.size();
+  names.push_back({name, category});
+  ids.emplace(std::move(key), id);
+  return id;
+}
+
+void Tracer::writeEscaped(const std::string &str) {
+  for (char c : str) {
+    if (c == '"' || c == '\\')
+      os << '\\' << c;
+    else if ((unsigned char)c < 0x20)
+      os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c
+         << std::dec;
+    else
+      os << c;
+  }
+}
+
+// Writes the events in the JSON array format, which viewers accept without
+// the closing bracket. This lets a trace be read while it is still written.
+void Tracer::write(uint32_t tid, const EventBuffer &buf) {
+  std::lock_guard<std::mutex> lock(mtx);
+  if (!os.is_open())
+    return;
+  for (const Event &E : buf.events) {
+    os << (wroteEvent ? ",\n" : "[\n");
+    wroteEvent = true;
+    const SpanName &N = names[E.id];
+    os << "{\"name\":\"";
+    writeEscaped(N.name);
+    os << "\",\"cat\":\"" << N.category << "\",\"ph\":\""
+       << (E.isBegin ? 'B' : 'E') << "\",\"ts\":" << E.ns / 1000 << '.'
+       << std::setw(3) << std::setfill('0') << E.ns % 1000
+       << ",\"pid\":" << pid << ",\"tid\":" << tid;
+    if (E.argBegin != E.argEnd) {
+      os << ",\"args\":{";
+      for (uint32_t i = E.argBegin; i != E.argEnd; ++i) {
+        const Arg &A = buf.args[i];
+        os << (i == E.argBegin ? "\"" : ",\"") << A.key << "\":";
+        if (A.isNum) {
+          os << A.num;
+        } else {
+          os << '"';
+          writeEscaped(A.str);
+          os << '"';
+        }
+      }
+      os << '}';
+    }
+    os << '}';
+  }
+  os.flush();
+}
+
+struct OpenSpan {
+  SpanID id;
+  // Args added while the span is innermost are pendingArgs[firstArg, ...).
+  size_t firstArg;
+};
+
+struct ThreadState {
+  const uint32_t tid;
+  EventBuffer buf;
+  std::vector<OpenSpan> open;
+  std::vector<Arg> pendingArgs;
+  // Nesting depth of Sample scopes, and whether the outermost one is sampled.
+  int sampleDepth = 0;
+  bool sampled = false;
+
+  ThreadState() : tid(getTracer().nextTid++) {}
+  ~ThreadState() { writeOut(); }
+
+  bool isRecording() const {
+    if (sampleDepth > 0)
+      return sampled;
+    const Tracer &T = getTracer();
+    return T.sampleRate <= 1 || T.activeSamples > 0;
+  }
+
+  void writeOut() {
+    if (buf.events.empty())
+      return;
+    getTracer().write(tid, buf);
+    buf.events.clear();
+    buf.args.clear();
+  }
+
+  void record(SpanID id, bool isBegin, uint32_t argBegin, uint32_t argEnd) {
+    buf.events.push_back({getTracer().now(), id, isBegin, argBegin, argEnd});
+    // Keep open spans on one side of a write so that their args, which are
+    // still pending, are not affected.
+    if (buf.events.size() >= MAX_BUFFERED_EVENTS)
+      writeOut();
+  }
+};
+
+ThreadState &getThreadState() {
+  static thread_local ThreadState TS;
+  return TS;
+}
+
+} // namespace
+
+void vISA::trace::enable(const char *path, unsigned sampleRate) {
+  if (getTracer().enable(path, sampleRate))
+    detail::Enabled.store(true, std::memory_order_release);
+}
+
+SpanID vISA::trace::intern(const std::string &name, const char *category) {
+  return getTracer().intern(name, category);
+}
+
+bool vISA::trace::detail::isRecording() {
+  return getThreadState().isRecording();
+}
+
+void vISA::trace::detail::begin(SpanID id) {
+  ThreadState &TS = getThreadState();
+  if (!TS.isRecording())
+    return;
+  TS.open.push_back({id, TS.pendingArgs.size()});
+  TS.record(id, true, 0, 0);
+}
+
+void vISA::trace::detail::end(SpanID id) {
+  ThreadState &TS = getThreadState();
+  size_t pos = TS.open.size();
+  while (pos > 0 && TS.open[pos - 1].id != id)
+    --pos;
+  // The span was opened while this thread did not record.
+  if (pos == 0)
+    return;
+  while (TS.open.size() >= pos) {
+    OpenSpan span = TS.open.back();
+    TS.open.pop_back();
+    uint32_t argBegin = (uint32_t)TS.buf.args.size();
+    for (size_t i = span.firstArg; i < TS.pendingArgs.size(); ++i)
+      TS.buf.args.push_back(std::move(TS.pendingArgs[i]));
+    TS.pendingArgs.resize(span.firstArg);
+    TS.record(span.id, false, argBegin, (uint32_t)TS.buf.args.size());
+  }
+}
+
+void vISA::trace::detail::addArg(const char *key, uint64_t value) {
+  ThreadState &TS = getThreadState();
+  if (!TS.open.empty())
+    TS.pendingArgs.push_back({key, std::string(), value, true});
+}
+
+void vISA::trace::detail::addArg(const char *key, const std::string &value) {
+  ThreadState &TS = getThreadState();
+  if (!TS.open.empty())
+    TS.pendingArgs.push_back({key, value, 0, false});
+}
+
+void vISA::trace::flush() {
+  if (isEnabled())
+    getThreadState().writeOut();
+}
+
+Sample::Sample() {
+  if (!isEnabled())
+    return;
+  ThreadState &TS = getThreadState();
+  entered = true;
+  if (TS.sampleDepth++ > 0)
+    return;
+  Tracer &T = getTracer();
+  unsigned rate = T.sampleRate;
+  sampled = rate <= 1 || T.numSamples++ % rate == 0;
+  TS.sampled = sampled;
+  if (sampled)
+    ++T.activeSamples;
+}
+
+Sample::~Sample() {
+  if (!entered)
+    return;
+  ThreadState &TS = getThreadState();
+  if (--TS.sampleDepth > 0)
+    return;
+  TS.sampled = false;
+  if (sampled) {
+    --getTracer().activeSamples;
+    TS.writeOut();
+  }
+}
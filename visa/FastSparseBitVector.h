@@ -13,6 +13,8 @@ SPDX-License-Identifier: MIT
 
 #if defined(_WIN64) || defined(_WIN32)
 
+#include "BitSetOps.h"
+
 // Following implementation of sparse bitvector is inspired from llvm's
 // SparseBitVector. There are some changes made to make it faster.
 // llvm's version stores SparseBitVectorElement instances as a linked
@@ -155,11 +157,10 @@ public:
     return -1;
   }
 
-  // Union (bitwise OR) this element with RHS
-  void unionWith(const SparseBitVectorElement &RHS) {
-    for (unsigned i = 0; i < BITWORDS_PER_ELEMENT; ++i) {
-      Bits[i] |= RHS.Bits[i];
-    }
+  // Union (bitwise OR) this element with RHS and return true if this one
+  // changed.
+  bool unionWith(const SparseBitVectorElement &RHS) {
+    return vISA::BitSetOps::unionWith(Bits, RHS.Bits, BITWORDS_PER_ELEMENT);
   }
 
   // Return true if we have any bits in common with RHS
@@ -175,21 +176,9 @@ public:
   // BecameZero is set to true if this element became all-zero bits.
   bool intersectWith(const SparseBitVectorElement<ElementSize> &RHS,
                      bool &BecameZero) {
-    bool changed = false;
-    bool allzero = true;
-
-    BecameZero = false;
-    for (unsigned i = 0; i < BITWORDS_PER_ELEMENT; ++i) {
-      BitWord old = changed ? 0 : Bits[i];
-
-      Bits[i] &= RHS.Bits[i];
-      if (Bits[i] != 0)
-        allzero = false;
-
-      if (!changed && old != Bits[i])
-        changed = true;
-    }
-    BecameZero = allzero;
+    bool changed =
+        vISA::BitSetOps::intersectWith(Bits, RHS.Bits, BITWORDS_PER_ELEMENT);
+    BecameZero = empty();
     return changed;
   }
 
@@ -198,21 +187,9 @@ public:
   // bits.
   bool intersectWithComplement(const SparseBitVectorElement &RHS,
                                bool &BecameZero) {
-    bool changed = false;
-    bool allzero = true;
-
-    BecameZero = false;
-    for (unsigned i = 0; i < BITWORDS_PER_ELEMENT; ++i) {
-      BitWord old = changed ? 0 : Bits[i];
-
-      Bits[i] &= ~RHS.Bits[i];
-      if (Bits[i] != 0)
-        allzero = false;
-
-      if (!changed && old != Bits[i])
-        changed = true;
-    }
-    BecameZero = allzero;
+    bool changed = vISA::BitSetOps::intersectWithComplement(
+        Bits, RHS.Bits, BITWORDS_PER_ELEMENT);
+    BecameZero = empty();
     return changed;
   }
 
@@ -221,15 +198,10 @@ public:
   void intersectWithComplement(const SparseBitVectorElement &RHS1,
                                const SparseBitVectorElement &RHS2,
                                bool &BecameZero) {
-    bool allzero = true;
-
-    BecameZero = false;
-    for (unsigned i = 0; i < BITWORDS_PER_ELEMENT; ++i) {
-      Bits[i] = RHS1.Bits[i] & ~RHS2.Bits[i];
-      if (Bits[i] != 0)
-        allzero = false;
-    }
-    BecameZero = allzero;
+    memcpy(&Bits[0], &RHS1.Bits[0], sizeof(BitWord) * BITWORDS_PER_ELEMENT);
+    vISA::BitSetOps::intersectWithComplement(Bits, RHS2.Bits,
+                                             BITWORDS_PER_ELEMENT);
+    BecameZero = empty();
   }
 };
 
@@ -510,11 +482,12 @@ public:
     return true;
   }
 
-  // Union our bitmap with the RHS
-  void operator|=(const FastSparseBitVector &RHS) {
+  // Union our bitmap with the RHS and return true if it changed
+  bool operator|=(const FastSparseBitVector &RHS) {
     if (this == &RHS)
-      return;
+      return false;
 
+    bool changed = false;
     auto maxSize = std::max(Elements.size(), RHS.Elements.size());
     for (unsigned int i = 0; i != maxSize; ++i) {
       if (Elements.size() <= i) {
@@ -522,6 +495,7 @@ public:
           Elements.resize(i + 1);
           Elements[i] = std::make_unique<SparseBitVectorElement<ElementSize>>(
               *RHS.Elements[i]);
+          changed = true;
         }
         continue;
       }
@@ -531,11 +505,15 @@ public:
       if (!RHSElem)
         continue;
       auto &LHSElem = Elements[i];
-      if (!LHSElem)
+      if (!LHSElem) {
         LHSElem =
             std::make_unique<SparseBitVectorElement<ElementSize>>(*RHSElem);
-      LHSElem->unionWith(*RHSElem);
+        changed = true;
+      } else {
+        changed |= LHSElem->unionWith(*RHSElem);
+      }
     }
+    return changed;
   }
 
   // Intersect our bitmap with the RHS
@@ -58,6 +58,8 @@ public:
                              const RPE *rpe);
   void sortBasedOnFreq(std::vector<LiveRange *> &lrs);
   bool hasFreqMetaData(G4_INST *i);
+  // Returns zero when the block has no profile data.
+  llvm::ScaledNumber<uint64_t> getBlockFreqInfo(G4_BB *bb);
   void deriveRefFreq(G4_BB *bb);
   void dump() const {}
   void initForRegAlloc(LivenessAnalysis *l);
@@ -115,8 +117,6 @@ private:
   std::unordered_map<LiveRange *, unsigned> staticRefCnts;
 
 
-  llvm::ScaledNumber<uint64_t> getBlockFreqInfo(G4_BB *bb);
-
   void setBlockFreqInfo(G4_BB *bb, llvm::ScaledNumber<uint64_t> freq) {
     BlockFreqInfo[bb] = freq;
     return;
@@ -571,6 +571,8 @@ private:
   const uint32_t m_function_id;
 
   RA_Type RAType;
+  // RA and scheduling effort, see Optimizer::selectCompileTier.
+  unsigned compileTier = 2;
   std::shared_ptr<KernelDebugInfo> kernelDbgInfo = nullptr;
   std::shared_ptr<gtPinData> gtPinInfo = nullptr;
 
@@ -788,6 +790,9 @@ public:
   void setRAType(RA_Type type) { RAType = type; }
   RA_Type getRAType() const { return RAType; }
 
+  void setCompileTier(unsigned tier) { compileTier = tier; }
+  unsigned getCompileTier() const { return compileTier; }
+
   bool hasKernelDebugInfo() const { return kernelDbgInfo != nullptr; }
   void updateKernelDebugInfo(G4_Kernel& kernel) {
     setKernelDebugInfoSharedPtr(kernel.getKernelDebugInfoSharedPtr());
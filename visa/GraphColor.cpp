@@ -32,6 +32,7 @@ SPDX-License-Identifier: MIT
 #include <list>
 #include <sstream>
 #include <optional>
+#include <thread>
 
 #include "common/LLVMWarningsPush.hpp"
 #include <llvm/ADT/SmallString.h>
@@ -71,6 +72,19 @@ Interference::Interference(const LivenessAnalysis *l, GlobalRA &g)
   incRA.registerNextIter((G4_RegFileKind)l->getSelectedRF(), l, this);
 }
 
+Interference::Interference(const Interference &parent,
+                           std::vector<SparseBitVector> &rows,
+                           std::vector<SparseBitVector> &clearedRows)
+    : gra(parent.gra), kernel(parent.kernel), lrs(parent.lrs),
+      builder(parent.builder), maxId(parent.maxId), rowSize(parent.rowSize),
+      splitStartId(parent.splitStartId), splitNum(parent.splitNum),
+      liveAnalysis(parent.liveAnalysis),
+      aug(*this, *parent.liveAnalysis, parent.gra), incRA(parent.incRA),
+      sparseIntf(parent.sparseIntf), sparseMatrix(rows),
+      clearedMatrix(&clearedRows) {
+  // denseMatrixLimit stays 0, so the worker always uses the sparse rows.
+}
+
 criticalCmpForEndInterval::criticalCmpForEndInterval(GlobalRA &g) : gra(g) {}
 bool criticalCmpForEndInterval::operator()(const QueueEntry &A, const QueueEntry &B) const {
   return A.interval.end->getLexicalId() > B.interval.end->getLexicalId();
@@ -2425,8 +2439,10 @@ void Interference::buildInterferenceWithinBB(G4_BB *bb, SparseBitVector &live) {
       }
     }
 
+    // Workers must not touch live ranges; the parallel build sets these
+    // after joining.
     if (inst->isSend() && inst->asSendInst()->isSVMScatterRW() &&
-        inst->getExecSize() < g4::SIMD8) {
+        inst->getExecSize() < g4::SIMD8 && !isParallelWorker()) {
       setForbiddenGRFNumForSVMScatter(inst);
     }
 
@@ -2747,38 +2763,159 @@ void Interference::setupLRs(G4_BB *bb) {
   }
 }
 
+unsigned Interference::getNumParallelIntfThreads() const {
+  unsigned numThreads = builder.getuint32Option(vISA_ParallelIntfThreads);
+  if (numThreads == 0) {
+    numThreads = std::thread::hardware_concurrency();
+  }
+  // Debug info intervals are updated from the walk itself, and the dense
+  // matrix is only used for kernels small enough to not be worth it.
+  if (numThreads <= 1 || useDenseMatrix() ||
+      builder.getOption(vISA_GenerateDebugInfo)) {
+    return 1;
+  }
+  size_t numInsts = 0;
+  for (const G4_BB *bb : kernel.fg) {
+    numInsts += bb->size();
+  }
+  if (numInsts < builder.getuint32Option(vISA_ParallelIntfMinInsts)) {
+    return 1;
+  }
+  return std::min(numThreads, kernel.fg.getNumBB());
+}
+
+// Build interference for all BBs on numThreads threads. BBs are split into
+// contiguous ranges of similar instruction count and each range is walked by
+// a worker with its own rows. The per-BB walk mostly sets edges, but it also
+// clears edges between split variables, so a worker records for every edge
+// whether it was last set or cleared. Applying the ranges in BB order then
+// gives exactly the matrix of the serial walk.
+void Interference::buildInterferenceInParallel(unsigned numThreads) {
+  std::vector<G4_BB *> bbs;
+  size_t numInsts = 0;
+  for (G4_BB *bb : kernel.fg) {
+    if (incRA.intfNeededForBB(bb)) {
+      bbs.push_back(bb);
+      numInsts += bb->size();
+    }
+  }
+
+  std::vector<size_t> rangeStart = {0};
+  size_t rangeInsts = 0;
+  for (size_t i = 0; i + 1 < bbs.size() && rangeStart.size() < numThreads;
+       ++i) {
+    rangeInsts += bbs[i]->size();
+    if (rangeInsts * numThreads >= numInsts * rangeStart.size()) {
+      rangeStart.push_back(i + 1);
+    }
+  }
+  rangeStart.push_back(bbs.size());
+  const unsigned numRanges = (unsigned)rangeStart.size() - 1;
+
+  struct WorkerRows {
+    std::vector<SparseBitVector> set;
+    std::vector<SparseBitVector> cleared;
+  };
+  std::vector<WorkerRows> rows(numRanges);
+
+  // All operand bounds were computed by liveness, so the walk only reads the
+  // IR and the per-range state below.
+  auto walkRange = [&](unsigned r) {
+    rows[r].set.resize(maxId);
+    rows[r].cleared.resize(maxId);
+    Interference worker(*this, rows[r].set, rows[r].cleared);
+    SparseBitVector live;
+    for (size_t i = rangeStart[r]; i < rangeStart[r + 1]; ++i) {
+      live.clear();
+      worker.buildInterferenceAtBBExit(bbs[i], live);
+      worker.buildInterferenceWithinBB(bbs[i], live);
+    }
+  };
+  // Rows are independent, so merging is split by row instead of by range.
+  auto mergeRows = [&](unsigned t) {
+    unsigned first = (unsigned)((uint64_t)maxId * t / numRanges);
+    unsigned last = (unsigned)((uint64_t)maxId * (t + 1) / numRanges);
+    for (unsigned v = first; v < last; ++v) {
+      for (const WorkerRows &worker : rows) {
+        if (!worker.cleared[v].empty()) {
+          sparseMatrix[v].intersectWithComplement(worker.cleared[v]);
+        }
+        if (!worker.set[v].empty()) {
+          sparseMatrix[v] |= worker.set[v];
+        }
+      }
+    }
+  };
+  auto runOnThreads = [numRanges](auto &&fn) {
+    std::vector<std::thread> threads;
+    threads.reserve(numRanges - 1);
+    for (unsigned i = 1; i < numRanges; ++i) {
+      threads.emplace_back(fn, i);
+    }
+    fn(0);
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  };
+
+  runOnThreads(walkRange);
+
+  startTimer(TimerID::INTERFERENCE_MERGE);
+  runOnThreads(mergeRows);
+  rows.clear();
+
+  // The only live range property set by the walk.
+  for (G4_BB *bb : bbs) {
+    for (auto i = bb->rbegin(); i != bb->rend(); ++i) {
+      G4_INST *inst = *i;
+      if (inst->isSend() && inst->asSendInst()->isSVMScatterRW() &&
+          inst->getExecSize() < g4::SIMD8) {
+        setForbiddenGRFNumForSVMScatter(inst);
+      }
+    }
+  }
+  stopTimer(TimerID::INTERFERENCE_MERGE);
+}
+
 void Interference::computeInterference() {
   startTimer(TimerID::INTERFERENCE);
 
+  startTimer(TimerID::INTERFERENCE_SETUP_LRS);
   for (auto bb : kernel.fg) {
     // Initialize LR properties like ref count and forbidden here.
     // This method is invoked for all BBs even with incremental RA.
     setupLRs(bb);
   }
+  stopTimer(TimerID::INTERFERENCE_SETUP_LRS);
 
-  //
-  // create bool vector, live, to track live ranges that are currently live
-  //
-  SparseBitVector live;
-
+  startTimer(TimerID::INTERFERENCE_BUILD);
   buildInterferenceAmongLiveOuts();
 
-  for (G4_BB *bb : kernel.fg) {
-    if (!incRA.intfNeededForBB(bb)) {
-      continue;
-    }
-    //
-    // mark all live ranges dead
-    //
-    live.clear();
-    //
-    // start with all live ranges that are live at the exit of BB
-    //
-    buildInterferenceAtBBExit(bb, live);
+  if (unsigned numThreads = getNumParallelIntfThreads(); numThreads > 1) {
+    buildInterferenceInParallel(numThreads);
+  } else {
     //
-    // traverse inst in the reverse order
+    // create bool vector, live, to track live ranges that are currently live
     //
-    buildInterferenceWithinBB(bb, live);
+    SparseBitVector live;
+
+    for (G4_BB *bb : kernel.fg) {
+      if (!incRA.intfNeededForBB(bb)) {
+        continue;
+      }
+      //
+      // mark all live ranges dead
+      //
+      live.clear();
+      //
+      // start with all live ranges that are live at the exit of BB
+      //
+      buildInterferenceAtBBExit(bb, live);
+      //
+      // traverse inst in the reverse order
+      //
+      buildInterferenceWithinBB(bb, live);
+    }
   }
 
   buildInterferenceAmongLiveIns();
@@ -2791,6 +2928,7 @@ void Interference::computeInterference() {
       buildInterferenceWithLocalRA(curBB);
     }
   }
+  stopTimer(TimerID::INTERFERENCE_BUILD);
 
   RA_TRACE({
     RPE rpe(gra, liveAnalysis);
@@ -2805,11 +2943,15 @@ void Interference::computeInterference() {
   }
 
   // Augment interference graph to accomodate non-default masks
+  startTimer(TimerID::INTERFERENCE_AUGMENT);
   aug.augmentIntfGraph();
+  stopTimer(TimerID::INTERFERENCE_AUGMENT);
 
+  startTimer(TimerID::INTERFERENCE_SPARSE_GRAPH);
   generateSparseIntfGraph();
 
   countNeighbors();
+  stopTimer(TimerID::INTERFERENCE_SPARSE_GRAPH);
 
   if (IncrementalRA::isEnabled(kernel)) {
     // Incremental interference was computed for current iteration.
@@ -6594,6 +6736,10 @@ GraphColor::GraphColor(LivenessAnalysis &live, bool hybrid, bool forceSpill_)
 // lrs[i] gives the live range whose id is i
 //
 void GraphColor::createLiveRanges() {
+  // Live-ranges of earlier iterations are replaced here, and the GraphColor
+  // instances that used them are gone. Free them instead of growing the
+  // allocator every iteration.
+  gra.incRA.destroyLiveRanges();
   lrs.resize(numVar);
   for (auto dcl : gra.kernel.Declares) {
     G4_RegVar *var = dcl->getRegVar();
@@ -6711,12 +6857,25 @@ void GraphColor::computeSpillCosts(bool useSplitLLRHeuristic, const RPE *rpe) {
       !(gra.getIterNo() == 0 &&
           (float)rpe->getMaxRP() < (float)kernel.getNumRegTotal() * 0.90f);
 
+  SpillCostModel *costModel =
+      gra.spillCostModel && liveAnalysis.livenessClass(G4_GRF) &&
+              !useSplitLLRHeuristic &&
+              !(rpe && gra.getIterNo() == 0 &&
+                (float)rpe->getMaxRP() <
+                    (float)kernel.getNumRegTotal() * 0.90f)
+          ? gra.spillCostModel.get()
+          : nullptr;
+  if (costModel)
+    costModel->startColoring();
+
   RA_TRACE({
     if (useNewSpillCost)
       std::cout << "\t--using new spill cost function\n";
+    if (costModel)
+      std::cout << "\t--using latency spill cost model\n";
   });
 
-  if (useNewSpillCost && liveAnalysis.livenessClass(G4_GRF)) {
+  if ((useNewSpillCost || costModel) && liveAnalysis.livenessClass(G4_GRF)) {
     // gather all instructions with indirect operands
     // for ref count computation once.
     for (auto bb : kernel.fg.getBBList()) {
@@ -6930,6 +7089,20 @@ void GraphColor::computeSpillCosts(bool useSplitLLRHeuristic, const RPE *rpe) {
         }
       }
 
+      if (costModel) {
+        auto indirectRefsIt = indirectRefs.find(dcl);
+        float cycles = costModel->getSpillFillCycles(
+            dcl, directRefs,
+            dcl->getAddressed() && indirectRefsIt != indirectRefs.end()
+                ? &indirectRefsIt->second
+                : nullptr);
+        costModel->addCandidate(dcl, spillCost, cycles);
+        // Cycles per GRF freed, so that spilling one large variable is
+        // weighed against spilling several small ones that free as much.
+        spillCost = cycles / ((float)(lrs[i]->getDegree() + 1) *
+                              (float)std::max<unsigned>(1, dcl->getNumRows()));
+      }
+
       lrs[i]->setSpillCost(spillCost);
       // Track address sensitive live range.
       if (liveAnalysis.isAddressSensitive(i) && incSpillCostCandidate(lrs[i])) {
@@ -11210,7 +11383,20 @@ void GlobalRA::removeSplitDecl() {
 
 void GlobalRA::fastRADecision()
 {
-  if (builder.getOption(vISA_SelectiveFastRA)) {
+  bool hasStackCall =
+      kernel.fg.getHasStackCalls() || kernel.fg.getIsStackCallFunc();
+  // Like -fastCompileRA and -hybridRAWithSpill, the lower tiers only use fast
+  // RA with stack calls when partitioning supports it.
+  if (kernel.getCompileTier() < 2 &&
+      (!hasStackCall ||
+       builder.getOption(vISA_PartitionWithFastHybridRA))) {
+    // Tier 0 prefers linear scan, which only 3D kernels support, so both
+    // tiers fall back to the single iteration hybrid RA.
+    useFastRA = true;
+    useHybridRAwithSpill = true;
+    RA_TRACE(std::cout << "\t--compile tier " << kernel.getCompileTier()
+                       << " uses fast RA\n");
+  } else if (builder.getOption(vISA_SelectiveFastRA)) {
     unsigned instNum = 0;
     for (auto bb : kernel.fg) {
       instNum += (int)bb->size();
@@ -11842,6 +12028,26 @@ bool GlobalRA::setupFailSafeIfNeeded(bool fastCompile, bool hasStackCall,
   return reserveSpillReg;
 }
 
+std::pair<bool, bool>
+GlobalRA::loopBoundarySplit(bool fastCompile, bool loopBoundarySplitDone,
+                            GraphColor &coloring,
+                            LivenessAnalysis &liveAnalysis, RPE &rpe) {
+  if (kernel.getOption(vISA_LoopBoundarySplit) &&
+      !kernel.getOption(vISA_Debug) && !kernel.getOption(vISA_FastSpill) &&
+      !fastCompile && getIterNo() == 0 && !loopBoundarySplitDone) {
+    LoopBoundarySplit split(*this, coloring, liveAnalysis, rpe);
+    split.run();
+    RA_TRACE(std::cout << "\t--split " << split.getNumSplits()
+                       << " live range(s) around hot loops\n");
+    kernel.dumpToFile("after.Loop_Boundary_Split." +
+                      std::to_string(getIterNo()));
+
+    // Re-run GRA loop so that spill decisions are made on the split ranges
+    return std::make_pair(split.getNumSplits() > 0, true);
+  }
+  return std::make_pair(false, loopBoundarySplitDone);
+}
+
 void GlobalRA::undefinedUses(bool rematDone, LivenessAnalysis& liveAnalysis) {
   if (builder.getOption(vISA_DumpUndefUsesFromLiveness) && getIterNo() == 0 &&
       !rematDone) {
@@ -12171,6 +12377,9 @@ GlobalRA::insertSpillCode(bool enableSpillSpaceCompression,
   if (kernel.getOption(vISA_SpillAnalysis)) {
     spillAnalysis->Do(&liveAnalysis, &coloring, &spillGRF);
   }
+  if (spillCostModel) {
+    spillCostModel->recordSpills(coloring.getSpilledLiveRanges());
+  }
 
   verifyNoInfCostSpill(coloring, reserveSpillReg);
 
@@ -12309,6 +12518,9 @@ int GlobalRA::coloringRegAlloc() {
   if (kernel.getOption(vISA_SpillAnalysis)) {
     spillAnalysis = std::make_unique<SpillAnalysis>();
   }
+  if (kernel.getOption(vISA_LatencySpillCost)) {
+    spillCostModel = std::make_unique<SpillCostModel>(*this);
+  }
 
   if (kernel.fg.getIsStackCallFunc()) {
     // Allocate space to store Frame Descriptor
@@ -12322,7 +12534,7 @@ int GlobalRA::coloringRegAlloc() {
   }
 
   // Global linear scan RA
-  if (builder.getOption(vISA_LinearScan) &&
+  if ((builder.getOption(vISA_LinearScan) || kernel.getCompileTier() == 0) &&
       builder.kernel.getInt32KernelAttr(Attributes::ATTR_Target) == VISA_3D) {
     int success = doGlobalLinearScanRA();
     if (success == VISA_SUCCESS)
@@ -12393,6 +12605,7 @@ int GlobalRA::coloringRegAlloc() {
   }
 
   bool rematDone = false, alignedScalarSplitDone = false;
+  bool loopBoundarySplitDone = false;
   bool loadSplitTryDone = false;
   bool reserveSpillReg = false;
   VarSplit splitPass(*this);
@@ -12547,7 +12760,15 @@ int GlobalRA::coloringRegAlloc() {
 
       rerunGRA3 = globalSplit(splitPass, coloring);
 
-      if (rerunGRAIter(rerunGRA1 || rerunGRA2 || rerunGRA3))
+      // Liveness is stale once any of the above changed the program, so
+      // wait for the rerun to split around loops.
+      bool rerunGRA4 = false;
+      if (!rerunGRA1 && !rerunGRA2 && !rerunGRA3)
+        std::tie(rerunGRA4, loopBoundarySplitDone) =
+            loopBoundarySplit(fastCompile, loopBoundarySplitDone, coloring,
+                              liveAnalysis, rpe);
+
+      if (rerunGRAIter(rerunGRA1 || rerunGRA2 || rerunGRA3 || rerunGRA4))
         continue;
 
       // When there are spills and -abortonspill is set, vISA will bump up the
@@ -12659,6 +12880,21 @@ int GlobalRA::coloringRegAlloc() {
         perfModel.run();
       }
 
+      RA_TRACE({
+        unsigned int numLoopSpills = 0;
+        unsigned int numLoopFills = 0;
+        for (auto bb : kernel.fg) {
+          if (!kernel.fg.getLoops().getInnerMostLoop(bb))
+            continue;
+          for (auto inst : *bb) {
+            numLoopSpills += inst->isSpillIntrinsic() ? 1 : 0;
+            numLoopFills += inst->isFillIntrinsic() ? 1 : 0;
+          }
+        }
+        std::cout << "\t--spill/fill in loops: " << numLoopSpills
+                  << " spills, " << numLoopFills << " fills\n";
+      });
+
       expandSpillFillIntrinsics(nextSpillOffset);
 
       VISA_DEBUG_VERBOSE(detectUndefinedUses(liveAnalysis, kernel));
@@ -51,6 +51,7 @@ enum BankConflict {
 
 class VarSplit;
 class SpillAnalysis;
+class SpillCostModel;
 class PhyRegAllocationState;
 
 class BankConflictPass {
@@ -644,6 +645,7 @@ struct InterferenceMatrixStorage {
 // instances.
 class IncrementalRA {
   friend Interference;
+  friend LivenessAnalysis;
 
   const SparseBitVector &getSparseMatrix(unsigned int id) {
     return sparseMatrix[id];
@@ -657,6 +659,7 @@ private:
   std::vector<std::vector<unsigned>>& sparseIntf;
   G4_RegFileKind selectedRF = G4_RegFileKind::G4_UndefinedRF;
   unsigned int level = 0;
+  bool incLiveness = false;
   std::unordered_set<G4_Declare *> needIntfUpdate;
   std::unordered_set<G4_Declare *> evenAlignCache;
   unsigned int maxDclId = 0;
@@ -693,8 +696,16 @@ public:
 
   IncrementalRA(GlobalRA &g);
 
+  // Frees all LiveRange objects. Only safe when nothing refers to them,
+  // i.e. when a GraphColor instance is about to create all of its
+  // live-ranges anew.
+  void destroyLiveRanges();
+
   bool isEnabled() const { return level > 0; }
   bool isEnabledWithVerification() const { return level == 2; }
+  // When enabled, liveness sets of previous iteration seed the fixed point
+  // computed by LivenessAnalysis in next iteration.
+  bool isLivenessEnabled() const { return level > 0 && incLiveness; }
 
   static bool isEnabled(G4_Kernel &kernel) {
     // 0 - disabled
@@ -803,7 +814,8 @@ public:
   void evenAlignUpdate(G4_Declare *dcl) { evenAlignCache.insert(dcl); }
 
 private:
-  // For verification only
+  // Liveness sets of previous iteration. Used for verification and for
+  // incremental liveness.
   std::vector<SparseBitVector> def_in;
   std::vector<SparseBitVector> def_out;
   std::vector<SparseBitVector> use_in;
@@ -811,6 +823,22 @@ private:
   std::vector<SparseBitVector> use_gen;
   std::vector<SparseBitVector> use_kill;
 
+  // Following fields are recorded only for incremental liveness.
+  // def_out of each BB before the fixed point was computed.
+  std::vector<SparseBitVector> def_gen;
+  SparseBitVector inputDefs;
+  SparseBitVector outputUses;
+  // G4_RegVar assigned to each id, and successor ids of each BB. Liveness
+  // sets can be reused only if these match with current iteration.
+  std::vector<G4_RegVar *> vars;
+  std::vector<std::vector<unsigned int>> succs;
+  unsigned char livenessRF = 0;
+
+  bool hasPrevLiveness(unsigned char rf) const {
+    return livenessRF == rf && !def_gen.empty();
+  }
+  void clearLiveness();
+
   std::unique_ptr<VarReferences> prevIterRefs;
 
   // Return true if verification passes, false otherwise
@@ -860,6 +888,11 @@ class Interference {
   // cache behavior
   std::vector<SparseBitVector>& sparseMatrix;
 
+  // Set only for the workers of a parallel build. Records the edges that
+  // were last cleared rather than set, so the worker's rows can be merged
+  // into the shared matrix in BB order.
+  std::vector<SparseBitVector> *clearedMatrix = nullptr;
+
   unsigned int denseMatrixLimit = 0;
 
   static void updateLiveness(SparseBitVector &live, uint32_t id, bool val) {
@@ -880,6 +913,9 @@ class Interference {
       matrix[v1 * rowSize + col] |= 1 << (v2 % BITS_DWORD);
     } else {
       sparseMatrix[v1].set(v2);
+      if (clearedMatrix) {
+        (*clearedMatrix)[v1].reset(v2);
+      }
     }
   }
 
@@ -890,6 +926,9 @@ class Interference {
       matrix[v1 * rowSize + col] &= ~(1 << (v2 % BITS_DWORD));
     } else {
       sparseMatrix[v1].reset(v2);
+      if (clearedMatrix) {
+        (*clearedMatrix)[v1].set(v2);
+      }
     }
   }
 
@@ -923,6 +962,8 @@ class Interference {
 
   void buildInterferenceAtBBExit(const G4_BB *bb, SparseBitVector &live);
   void buildInterferenceWithinBB(G4_BB *bb, SparseBitVector &live);
+  unsigned getNumParallelIntfThreads() const;
+  void buildInterferenceInParallel(unsigned numThreads);
   void buildInterferenceForDst(G4_BB *bb, SparseBitVector &live, G4_INST *inst,
                                std::list<G4_INST *>::reverse_iterator i,
                                G4_DstRegRegion *dst);
@@ -957,6 +998,12 @@ class Interference {
 
   void setupLRs(G4_BB *bb);
 
+  // Worker of buildInterferenceInParallel(). It shares everything with
+  // parent except the matrix rows, and is not registered with incremental RA.
+  Interference(const Interference &parent, std::vector<SparseBitVector> &rows,
+               std::vector<SparseBitVector> &clearedRows);
+  bool isParallelWorker() const { return clearedMatrix != nullptr; }
+
 public:
   Interference(const LivenessAnalysis *l, GlobalRA &g);
 
@@ -1430,6 +1477,7 @@ public:
   std::unique_ptr<VerifyAugmentation> verifyAugmentation;
   std::unique_ptr<RegChartDump> regChart;
   std::unique_ptr<SpillAnalysis> spillAnalysis;
+  std::unique_ptr<SpillCostModel> spillCostModel;
   static bool useGenericAugAlign(PlatformGen gen) {
     if (gen == PlatformGen::GEN9 || gen == PlatformGen::GEN8)
       return false;
@@ -2266,6 +2314,12 @@ private:
                                                   bool alignedScalarSplitDone,
                                                   GraphColor &coloring);
   bool globalSplit(VarSplit &splitPass, GraphColor &coloring);
+  // return <whether split modified program, loopBoundarySplitDone>
+  std::pair<bool, bool> loopBoundarySplit(bool fastCompile,
+                                          bool loopBoundarySplitDone,
+                                          GraphColor &coloring,
+                                          LivenessAnalysis &liveAnalysis,
+                                          RPE &rpe);
   int localSplit(bool fastCompile, VarSplit &splitPass);
   // return <doBCReduction, highInternalConflict>
   std::pair<bool, bool> bankConflict();
@@ -2423,6 +2477,63 @@ private:
   GetIntervalBBs(G4_INST *Start, G4_INST *End,
                  std::unordered_map<G4_INST *, G4_BB *> &InstBBMap);
 };
+
+// Estimates the cycles the spill and fill code of a GRF variable would add to
+// one run of the kernel (-latencyspillcost). Each def costs a scratch write and
+// each use a scratch read, weighted by how often its block runs: the profile
+// frequency relative to the entry when FrequencyInfo has one, or otherwise an
+// assumed trip count per enclosing loop, as KernelCost estimates.
+//
+// Block weights and per-variable cycles are cached until the IR changes, i.e.
+// across the colorings attempted within one RA iteration.
+class SpillCostModel {
+public:
+  using IndirectRefs = std::list<std::pair<G4_INST *, G4_BB *>>;
+
+  SpillCostModel(GlobalRA &g);
+  SpillCostModel(const SpillCostModel &) = delete;
+  SpillCostModel &operator=(const SpillCostModel &) = delete;
+
+  // Called before spill costs are computed for a new coloring.
+  void startColoring();
+
+  float getSpillFillCycles(G4_Declare *dcl, VarReferences &refs,
+                           const IndirectRefs *indirectRefs);
+
+  // Records a spill candidate along with the cost the default heuristic gave
+  // it, to estimate what the heuristic would have spilled instead.
+  void addCandidate(G4_Declare *dcl, float legacyCost, float cycles);
+  // Accounts for the spills RA settled on and updates the kernel stats.
+  void recordSpills(const LIVERANGE_LIST &spilled);
+
+private:
+  GlobalRA &gra;
+  G4_Kernel &kernel;
+  const unsigned loopTripCount;
+  // Scratch latencies from the LatencyTable.
+  float spillLatency = 0.0f;
+  float fillLatency = 0.0f;
+
+  // The IR the caches were computed for.
+  unsigned cachedIterNo = ~0u;
+  size_t cachedNumInsts = 0;
+  // Expected runs per kernel run, indexed by BB id.
+  std::vector<float> blockFreq;
+  std::unordered_map<const G4_Declare *, float> dclCycles;
+
+  struct Candidate {
+    const G4_Declare *dcl;
+    float legacyCost;
+    float cycles;
+  };
+  std::vector<Candidate> candidates;
+
+  uint64_t spillCycles = 0;
+  uint64_t cyclesAvoided = 0;
+
+  void computeBlockFreqs();
+  float getBlockFreq(G4_BB *bb) const { return blockFreq[bb->getId()]; }
+};
 } // namespace vISA
 
 #endif // __GRAPHCOLOR_H__
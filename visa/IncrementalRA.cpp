@@ -18,6 +18,7 @@ IncrementalRA::IncrementalRA(GlobalRA &g)
     : gra(g), kernel(g.kernel), sparseMatrix(g.intfStorage.sparseMatrix),
       sparseIntf(g.intfStorage.sparseIntf) {
   level = kernel.getOptions()->getuInt32Option(vISA_IncrementalRA);
+  incLiveness = kernel.getOption(vISA_IncrementalLiveness);
 }
 
 void IncrementalRA::reset() {
@@ -30,15 +31,28 @@ void IncrementalRA::reset() {
   updateIntfForBB.clear();
   updateIntfForBBValid = false;
 
-  if (isEnabledWithVerification()) {
-    def_in.clear();
-    def_out.clear();
-    use_in.clear();
-    use_out.clear();
-    use_gen.clear();
-    use_kill.clear();
-    prevIterRefs.reset();
-  }
+  clearLiveness();
+  prevIterRefs.reset();
+}
+
+void IncrementalRA::destroyLiveRanges() {
+  lrs.clear();
+  mem.DestroyAll();
+}
+
+void IncrementalRA::clearLiveness() {
+  def_in.clear();
+  def_out.clear();
+  use_in.clear();
+  use_out.clear();
+  use_gen.clear();
+  use_kill.clear();
+  def_gen.clear();
+  inputDefs.clear();
+  outputUses.clear();
+  vars.clear();
+  succs.clear();
+  livenessRF = 0;
 }
 
 void IncrementalRA::eraseLiveOutsFromIncrementalUpdate() {
@@ -158,9 +172,11 @@ void IncrementalRA::registerNextIter(G4_RegFileKind rf,
 
   maxDclId = kernel.Declares.size();
 
-  if (isEnabledWithVerification()) {
-    // copy over liveness sets
+  // copy over liveness sets
+  if (isEnabledWithVerification() || isLivenessEnabled())
     copyLiveness(liveness);
+
+  if (isEnabledWithVerification()) {
     // force compute var refs
     prevIterRefs =
         std::unique_ptr<VarReferences>(new VarReferences(gra.kernel));
@@ -301,6 +317,22 @@ void IncrementalRA::copyLiveness(const LivenessAnalysis* liveness) {
   use_out = liveness->use_out;
   use_gen = liveness->use_gen;
   use_kill = liveness->use_kill;
+
+  // def_gen is empty when liveness didn't record state for incremental
+  // update. Next iteration computes liveness from scratch in that case.
+  def_gen = liveness->def_gen;
+  inputDefs = liveness->kernelInputDefs;
+  outputUses = liveness->kernelOutputUses;
+  vars = liveness->vars;
+  livenessRF = liveness->getSelectedRF();
+  succs.clear();
+  if (!def_gen.empty()) {
+    succs.resize(kernel.fg.size());
+    for (auto bb : kernel.fg) {
+      for (auto succ : bb->Succs)
+        succs[bb->getId()].push_back(succ->getId());
+    }
+  }
 }
 
 std::pair<bool, unsigned int>
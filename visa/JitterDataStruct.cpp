@@ -53,6 +53,14 @@ llvm::json::Value toJSON(const PERF_STATS_VERBOSE &p) {
     jsonObject.insert({"normIntfNum", p.normIntfNum});
     jsonObject.insert({"augIntfNum", p.augIntfNum});
   }
+  if (p.globalSchedHoistedSends) {
+    jsonObject.insert({"globalSchedHoistedSends", p.globalSchedHoistedSends});
+    jsonObject.insert({"globalSchedCycleGain", p.globalSchedCycleGain});
+  }
+  if (p.spillCostCycles) {
+    jsonObject.insert({"spillCostCycles", p.spillCostCycles});
+    jsonObject.insert({"spillCostCyclesAvoided", p.spillCostCyclesAvoided});
+  }
 
   return jsonObject;
 }
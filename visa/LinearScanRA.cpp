@@ -1783,7 +1783,8 @@ static inline void printLiveInterval(LSLiveRange *lr, bool assign,
 globalLinearScan::globalLinearScan(
     GlobalRA &g, LivenessAnalysis *l, std::vector<LSLiveRange *> &lv,
     std::vector<LSLiveRange *> *assignedLiveIntervals,
-    std::list<LSInputLiveRange *, std_arena_based_allocator<LSInputLiveRange *>>
+    std::list<LSInputLiveRange *,
+              std_arena_recycling_allocator<LSInputLiveRange *>>
         &inputLivelIntervals,
     PhyRegsManager &pregMgr, unsigned int numReg, unsigned int numEOT,
     unsigned int lastLexID, bool bankConflict, bool internalConflict, Mem_Manager* GLSMem)
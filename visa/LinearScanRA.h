@@ -83,7 +83,8 @@ private:
   bool doSplitLLR = false;
   // Bump allocator for linear scan live ranges and their forbidden GRF vector.
   Mem_Manager LSMem;
-  std::list<LSInputLiveRange *, std_arena_based_allocator<LSInputLiveRange *>>
+  std::list<LSInputLiveRange *,
+            std_arena_recycling_allocator<LSInputLiveRange *>>
       inputIntervals;
   BankConflictPass &bc;
   GlobalRA &gra;
@@ -366,7 +367,8 @@ private:
   PhyRegsManager &pregManager;
   std::vector<LSLiveRange *> &liveIntervals;
   std::vector<LSLiveRange *> *preAssignedIntervals;
-  std::list<LSInputLiveRange *, std_arena_based_allocator<LSInputLiveRange *>>
+  std::list<LSInputLiveRange *,
+            std_arena_recycling_allocator<LSInputLiveRange *>>
       &inputIntervals;
   std::list<LSLiveRange *> active;
   std::vector<ACTIVE_GRFS> activeGRF;
@@ -403,8 +405,8 @@ public:
                    std::vector<LSLiveRange *> &liveIntervals,
                    std::vector<LSLiveRange *> *eotLiveIntervals,
                    std::list<LSInputLiveRange *,
-                             std_arena_based_allocator<LSInputLiveRange *>>
-                       &inputLivelIntervals,
+                             std_arena_recycling_allocator<
+                                 LSInputLiveRange *>> &inputLivelIntervals,
                    PhyRegsManager &pregMgr, unsigned int numReg,
                    unsigned int numEOT, unsigned int lastLexID,
                    bool bankConflict, bool internalConflict, Mem_Manager* GLSMem);
@@ -28,6 +28,7 @@ public:
   uint16_t getOccupancy(const G4_INST *Inst) const override;
   uint16_t getDPASLatency(uint8_t repeatCount) const override;
   uint16_t getSendSrcReadLatency(const G4_INST *Inst) const override;
+  uint16_t getScratchLatency(bool isWrite) const override;
 };
 
 template <PlatformGen Gen>
@@ -50,6 +51,7 @@ public:
   // implementation can be specialized if needed.
   uint16_t getDPASLatency(uint8_t repeatCount) const override;
   uint16_t getSendSrcReadLatency(const G4_INST *Inst) const override;
+  uint16_t getScratchLatency(bool isWrite) const override;
 
 private:
   uint16_t getMsgLatency(const G4_INST *Inst) const;
@@ -161,6 +163,12 @@ uint16_t LatencyTableLegacy::getSendSrcReadLatency(const G4_INST *inst) const {
   return LegacyLatencies::UNCOMPR_LATENCY;
 }
 
+// A spill only stalls until its payload has been read.
+uint16_t LatencyTableLegacy::getScratchLatency(bool isWrite) const {
+  return isWrite ? LegacyLatencies::EDGE_LATENCY_SEND_WAR
+                 : LegacyFFLatency[4]; // SFID_DP_READ
+}
+
 // General template implementations for XE+.
 template<PlatformGen Gen>
 uint16_t LatencyTableXe<Gen>::getLatency(const G4_INST *Inst) const {
@@ -202,6 +210,15 @@ uint16_t LatencyTableXe<Gen>::getSendSrcReadLatency(const G4_INST *Inst) const {
   return value_of(LI::SEND_ARB) + src0RegSize + src1RegSize;
 }
 
+// Scratch is cached in L1 on LSC platforms.
+template <PlatformGen Gen>
+uint16_t LatencyTableXe<Gen>::getScratchLatency(bool isWrite) const {
+  if (isWrite)
+    return value_of(LI::SEND_ARB);
+  return m_builder.supportsLSC() ? value_of(LI::LSC_UNTYPED_L1)
+                                 : value_of(LI::DP_L3);
+}
+
 template<PlatformGen Gen>
 uint16_t LatencyTableXe<Gen>::getMsgLatency(const G4_INST *Inst) const {
   vASSERT(Inst->isSend());
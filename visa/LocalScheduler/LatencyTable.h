@@ -112,6 +112,8 @@ public:
   // Implement different platform overrides for DPAS
   virtual uint16_t getDPASLatency(uint8_t repeatCount) const = 0;
   virtual uint16_t getSendSrcReadLatency(const G4_INST *Inst) const = 0;
+  // Cycles a thread waits on a spill (isWrite) or a fill to scratch.
+  virtual uint16_t getScratchLatency(bool isWrite) const = 0;
 
 protected:
   const IR_Builder &m_builder;
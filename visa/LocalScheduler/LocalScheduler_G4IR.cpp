@@ -14,14 +14,57 @@ SPDX-License-Identifier: MIT
 #include "visa_wa.h"
 #include "../KernelCost.hpp"
 
+#include <atomic>
 #include <fstream>
 #include <functional>
 #include <queue>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 using namespace vISA;
 
+namespace {
+// A block, or a section of a block above the scheduler window, scheduled on
+// its own. Sections are split off up front so that scheduling never changes
+// the CFG.
+struct ScheduleUnit {
+  G4_BB *bb;
+  size_t bbInfoIdx;
+  unsigned sequentialCycle = 0;
+  unsigned sendStallCycle = 0;
+};
+} // namespace
+
+// Operand bounds are computed lazily, and some operands like immediates are
+// shared between blocks, so compute them before scheduling in parallel.
+static void computeOperandBounds(G4_INST *inst) {
+  for (unsigned i = 0; i < Opnd_total_num; ++i) {
+    G4_Operand *opnd = inst->getOperand((Gen4_Operand_Number)i);
+    if (opnd)
+      opnd->getRightBound();
+  }
+}
+
+// Returns the number of threads to schedule the given units on.
+static unsigned getNumSchedulingThreads(FlowGraph &fg,
+                                        const std::vector<ScheduleUnit> &units) {
+  const Options *options = fg.builder->getOptions();
+  unsigned numThreads = options->getuInt32Option(vISA_LocalSchedulingThreads);
+  if (numThreads == 0)
+    numThreads = std::thread::hardware_concurrency();
+  // Dumps are written per block and would interleave.
+  if (numThreads <= 1 || options->getOption(vISA_DumpSchedule) ||
+      options->getOption(vISA_DumpDot) || options->getOption(vISA_DumpDagDot))
+    return 1;
+  size_t numInsts = 0;
+  for (const ScheduleUnit &unit : units)
+    numInsts += unit.bb->size();
+  if (numInsts < options->getuInt32Option(vISA_LocalSchedulingParallelMinInsts))
+    return 1;
+  return std::min(numThreads, (unsigned)units.size());
+}
+
 /* Entry to the local scheduling. */
 void LocalScheduler::localScheduling() {
   // This is controlled by options for debugging
@@ -45,6 +88,10 @@ void LocalScheduler::localScheduling() {
       options->getuInt32Option(vISA_LocalSchedulingStartBB);
   uint32_t shceduleEndBBId =
       options->getuInt32Option(vISA_LocalSchedulingEndBB);
+  unsigned schedulerWindowSize =
+      options->getuInt32Option(vISA_SchedulerWindowSize);
+  std::vector<ScheduleUnit> units;
+  std::vector<std::pair<G4_BB *, std::vector<G4_BB *>>> splitBBs;
   for (G4_BB *bb : fg) {
     if (bb->getId() < scheduleStartBBId || bb->getId() > shceduleEndBBId)
       continue;
@@ -58,20 +105,19 @@ void LocalScheduler::localScheduling() {
 
       bbInfo.push_back({(int)bb->getId(), sequentialCycles, 0,
           (unsigned char)bb->getNestLevel()});
-      totalCycles += sequentialCycles;
       continue;
     }
 
-    unsigned schedulerWindowSize =
-        options->getuInt32Option(vISA_SchedulerWindowSize);
+    // The cycles are summed up once the units are scheduled.
+    const size_t bbInfoIdx = bbInfo.size();
+    bbInfo.push_back({(int)bb->getId(), 0, 0,
+        (unsigned char)bb->getNestLevel()});
     if (schedulerWindowSize > 0 && instCountBefore > schedulerWindowSize) {
       // If BB has a lot of instructions then when recursively
       // traversing DAG in list scheduler, stack overflow occurs.
       // So artificially breakup inst list here to reduce size
       // of scheduler problem size.
       unsigned int count = 0;
-      unsigned int sequentialCycles = 0;
-      unsigned int sendStallCycles = 0;
       std::vector<G4_BB *> sections;
 
       for (auto inst_it = bb->begin(); ; ++inst_it) {
@@ -79,9 +125,7 @@ void LocalScheduler::localScheduling() {
           G4_BB *tempBB = fg.createNewBB(false);
           sections.push_back(tempBB);
           tempBB->splice(tempBB->begin(), bb, bb->begin(), inst_it);
-          G4_BB_Schedule schedule(fg.getKernel(), tempBB, *LT, p);
-          sequentialCycles += schedule.sequentialCycle;
-          sendStallCycles += schedule.sendStallCycle;
+          units.push_back({tempBB, bbInfoIdx});
           count = 0;
         }
         count++;
@@ -89,21 +133,61 @@ void LocalScheduler::localScheduling() {
         if (inst_it == bb->end())
           break;
       }
-
-      for (G4_BB *section : sections) {
-        bb->splice(bb->end(), section, section->begin(), section->end());
-      }
-      bbInfo.push_back({(int)bb->getId(), sequentialCycles, sendStallCycles,
-          (unsigned char)bb->getNestLevel()});
-      totalCycles += sequentialCycles;
+      splitBBs.emplace_back(bb, std::move(sections));
     } else {
-      G4_BB_Schedule schedule(fg.getKernel(), bb, *LT, p);
-      bbInfo.push_back({(int)bb->getId(), schedule.sequentialCycle,
-          schedule.sendStallCycle, (unsigned char)bb->getNestLevel()});
-      totalCycles += schedule.sequentialCycle;
+      units.push_back({bb, bbInfoIdx});
     }
   }
 
+  auto scheduleUnit = [&](ScheduleUnit &unit, Mem_Manager &dddMem) {
+    G4_BB_Schedule schedule(fg.getKernel(), unit.bb, *LT, p, dddMem);
+    unit.sequentialCycle = schedule.sequentialCycle;
+    unit.sendStallCycle = schedule.sendStallCycle;
+  };
+
+  unsigned numThreads = getNumSchedulingThreads(fg, units);
+  if (numThreads <= 1) {
+    // Shared by the DDDs of all blocks
+    Mem_Manager dddMem(4096);
+    for (ScheduleUnit &unit : units)
+      scheduleUnit(unit, dddMem);
+  } else {
+    for (const ScheduleUnit &unit : units) {
+      for (G4_INST *inst : *unit.bb)
+        computeOperandBounds(inst);
+    }
+
+    // Units are handed out in order to workers with their own DDD memory.
+    // Every unit is scheduled on its own, so the result does not depend on
+    // which worker takes it.
+    std::atomic<size_t> nextUnit(0);
+    const std::shared_ptr<ArenaUsage> arenaUsage = ArenaUsage::current();
+    auto worker = [&]() {
+      ArenaUsage::Scope usageScope(arenaUsage);
+      Mem_Manager dddMem(4096);
+      for (size_t i = nextUnit++; i < units.size(); i = nextUnit++)
+        scheduleUnit(units[i], dddMem);
+    };
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < numThreads; ++t)
+      threads.emplace_back(worker);
+    worker();
+    for (std::thread &t : threads)
+      t.join();
+  }
+
+  for (auto &[bb, sections] : splitBBs) {
+    for (G4_BB *section : sections) {
+      bb->splice(bb->end(), section, section->begin(), section->end());
+    }
+  }
+  for (const ScheduleUnit &unit : units) {
+    bbInfo[unit.bbInfoIdx].staticCycle += unit.sequentialCycle;
+    bbInfo[unit.bbInfoIdx].sendStallCycle += unit.sendStallCycle;
+  }
+  for (const VISA_BB_INFO &info : bbInfo)
+    totalCycles += info.staticCycle;
+
   // Sum up the cycles for each BB.
   unsigned sendStallCycle = 0;
   unsigned staticCycle = 0;
@@ -204,13 +288,16 @@ void G4_BB_Schedule::dumpSchedule(G4_BB *bb) {
 //      - creates a new instruction listing within a BBB
 //
 G4_BB_Schedule::G4_BB_Schedule(G4_Kernel *k, G4_BB *block,
-                               const LatencyTable &LT, PointsToAnalysis &p)
+                               const LatencyTable &LT, PointsToAnalysis &p,
+                               Mem_Manager &mem)
     : bb(block), kernel(k), pointsToAnalysis(p) {
   // we use local id in the scheduler for determining two instructions' original
   // ordering
   bb->resetLocalIds();
 
-  DDD ddd(bb, LT, k, p);
+  // DDD memory is released once this block is scheduled.
+  Mem_Manager::Scope memScope(mem);
+  DDD ddd(bb, LT, k, p, mem);
   // Generate pairs of TypedWrites
   bool doMessageFuse =
       (k->fg.builder->fuseTypedWrites() && k->getSimdSize() >= g4::SIMD16) ||
@@ -711,9 +798,23 @@ public:
                        numOfBuckets, ALL_BUCKETS);
   }
 
+  static bool isWrite(Gen4_Operand_Number opndNum) {
+    return opndNum == Opnd_dst || opndNum == Opnd_condMod ||
+           opndNum == Opnd_implAccDst;
+  }
+
+  // Bucket nodes are given back to the DDD memory once they are no longer
+  // live, so memory follows the live accesses rather than all accesses.
+  void freeBucketNode(BucketNode *BNode) {
+    ddd->get_mem()->free(BNode, sizeof(BucketNode));
+  }
+
   void clearLive(int bucket) {
     BucketHeadNode &BHNode = nodeBucketsArray[bucket];
+    for (BucketNode *BNode : BHNode.bucketVec)
+      freeBucketNode(BNode);
     BHNode.bucketVec.clear();
+    BHNode.numLiveWrites = 0;
   }
 
   void clearAllLive() {
@@ -728,10 +829,17 @@ public:
     return !BV.empty();
   }
 
+  bool hasLiveWrite(int bucket) const {
+    return nodeBucketsArray[bucket].numLiveWrites != 0;
+  }
+
   void kill(Mask mask, BN_iterator &bn_it) {
     BucketHeadNode &BHNode = nodeBucketsArray[bn_it.bucket];
     BUCKET_VECTOR &vec = BHNode.bucketVec;
     BUCKET_VECTOR_ITER &node_it = bn_it.node_it;
+    if (isWrite((*node_it)->opndNum))
+      BHNode.numLiveWrites--;
+    freeBucketNode(*node_it);
     if (*node_it == vec.back()) {
       vec.pop_back();
       node_it = vec.end();
@@ -751,6 +859,8 @@ public:
     BucketNode *newNode =
         new (allocedMem) BucketNode(node, BD.mask, BD.operand);
     nodeVec.push_back(newNode);
+    if (isWrite(BD.operand))
+      BHNode.numLiveWrites++;
     // If it is a write to a subreg, mark the NODE accordingly
     if (BD.operand == Opnd_dst) {
       node->setWritesToSubreg(BD.bucket);
@@ -1407,8 +1517,9 @@ bool DDD::canInSameDPASMacro(G4_INST *curInst, G4_INST *nextInst,
 // dependencies with all insts in live set. After analyzing dependencies and
 // creating necessary edges, current inst is inserted in all buckets it
 // touches.
-DDD::DDD(G4_BB *bb, const LatencyTable &lt, G4_Kernel *k, PointsToAnalysis &p)
-    : DDDMem(4096), LT(lt), kernel(k), pointsToAnalysis(p) {
+DDD::DDD(G4_BB *bb, const LatencyTable &lt, G4_Kernel *k, PointsToAnalysis &p,
+         Mem_Manager &mem)
+    : DDDMem(mem), LT(lt), kernel(k), pointsToAnalysis(p) {
   Node *lastBarrier = nullptr;
   HWthreadsPerEU = k->getNumThreads();
   useMTLatencies = getBuilder()->useMultiThreadLatency();
@@ -1436,6 +1547,8 @@ DDD::DDD(G4_BB *bb, const LatencyTable &lt, G4_Kernel *k, PointsToAnalysis &p)
   TOTAL_BUCKETS = OTHER_ARF_BUCKET + 1;
 
   LiveBuckets LB(this, GRF_BUCKET, TOTAL_BUCKETS);
+  newEdgePred.resize(bb->size(), nullptr);
+  newEdgeIdx.resize(bb->size());
   for (int i = 0; i < PIPE_ALL; i++) {
     latestInstOfEachPipe[i] = nullptr;
   }
@@ -1576,12 +1689,12 @@ DDD::DDD(G4_BB *bb, const LatencyTable &lt, G4_Kernel *k, PointsToAnalysis &p)
         BucketNode *BNode = *it;
         Node *liveNode = BNode->node;
         if (liveNode->preds.empty()) {
-          createAddEdge(node, liveNode, depType);
+          addEdgeFromNewNode(node, liveNode, depType);
         }
       }
       LB.clearAllLive();
       if (lastBarrier) {
-        createAddEdge(node, lastBarrier, lastBarrier->isBarrier());
+        addEdgeFromNewNode(node, lastBarrier, lastBarrier->isBarrier());
       }
 
       lastBarrier = node;
@@ -1597,6 +1710,12 @@ DDD::DDD(G4_BB *bb, const LatencyTable &lt, G4_Kernel *k, PointsToAnalysis &p)
         if (!LB.hasLive(curMask, curBucket)) {
           continue;
         }
+        // Reads only depend on live writes in the buckets tracked by
+        // operand; send buckets compare the messages instead.
+        if (!LiveBuckets::isWrite(curOpnd) && curBucket != SEND_BUCKET &&
+            curBucket != SCRATCH_SEND_BUCKET && !LB.hasLiveWrite(curBucket)) {
+          continue;
+        }
         // Kill type 1: When the current destination region completely
         //              covers the whole register from the first bit
         //              to the last bit.
@@ -1656,7 +1775,7 @@ DDD::DDD(G4_BB *bb, const LatencyTable &lt, G4_Kernel *k, PointsToAnalysis &p)
 
           // 2. Create Edge if there is overlap and RAW/WAW/WAR
           if (dep != NODEP && hasOverlap) {
-            createAddEdge(node, curLiveNode, dep);
+            addEdgeFromNewNode(node, curLiveNode, dep);
             transitiveEdgeToBarrier |= curLiveNode->hasTransitiveEdgeToBarrier;
           }
 
@@ -1674,7 +1793,7 @@ DDD::DDD(G4_BB *bb, const LatencyTable &lt, G4_Kernel *k, PointsToAnalysis &p)
 
       if (transitiveEdgeToBarrier == false && lastBarrier != nullptr) {
         // Insert edge to barrier and set flag
-        createAddEdge(node, lastBarrier, lastBarrier->isBarrier());
+        addEdgeFromNewNode(node, lastBarrier, lastBarrier->isBarrier());
         node->hasTransitiveEdgeToBarrier = true;
       }
     }
@@ -2107,21 +2226,41 @@ void DDD::createAddEdge(Node *pred, Node *succ, DepType d) {
   // Check whether an edge already exists
   for (int i = 0; i < (int)(pred->succs.size()); i++) {
     Edge &curSucc = pred->succs[i];
-    // Keep the deptype that has the highest latency
     if (curSucc.getNode() == succ) {
-      uint32_t newEdgeLatency = getEdgeLatency(pred, succ, d);
-      if (newEdgeLatency > curSucc.getLatency()) {
-        // Update with the dep type that causes the highest latency
-        curSucc.setType(d);
-        curSucc.setLatency(newEdgeLatency);
-        // Set the node priority
-        setPriority(pred, curSucc);
-      }
+      updateEdge(pred, curSucc, d);
       return;
     }
   }
 
   // No edge with the same successor exists. Append this edge.
+  appendEdge(pred, succ, d);
+}
+
+// Same as createAddEdge, for edges from the node being added to the DAG.
+void DDD::addEdgeFromNewNode(Node *pred, Node *succ, DepType d) {
+  unsigned succId = succ->getNodeID();
+  if (newEdgePred[succId] == pred) {
+    updateEdge(pred, pred->succs[newEdgeIdx[succId]], d);
+    return;
+  }
+  newEdgePred[succId] = pred;
+  newEdgeIdx[succId] = (unsigned)pred->succs.size();
+  appendEdge(pred, succ, d);
+}
+
+void DDD::updateEdge(Node *pred, Edge &edge, DepType d) {
+  // Keep the deptype that has the highest latency
+  uint32_t newEdgeLatency = getEdgeLatency(pred, edge.getNode(), d);
+  if (newEdgeLatency > edge.getLatency()) {
+    // Update with the dep type that causes the highest latency
+    edge.setType(d);
+    edge.setLatency(newEdgeLatency);
+    // Set the node priority
+    setPriority(pred, edge);
+  }
+}
+
+void DDD::appendEdge(Node *pred, Node *succ, DepType d) {
   uint32_t edgeLatency = getEdgeLatency(pred, succ, d);
   pred->succs.emplace_back(succ, d, edgeLatency);
 
@@ -216,6 +216,10 @@ struct BucketHeadNode {
   // This is for future use. We can use it as an aggregate mask to avoid
   // searching through the list.
   Mask mask;
+  // Number of live nodes in bucketVec that write the bucket. A read only
+  // depends on live writes, so the reads of a register that is read many
+  // times before it is written do not need to search each other.
+  unsigned numLiveWrites = 0;
 };
 
 // Describes a single bucket access
@@ -290,9 +294,10 @@ public:
 
 class DDD {
   std::vector<Node *> allNodes;
-  // Used to allocate BucketNode, which is POD.
+  // Used to allocate BucketNode, which is POD. Owned by the scheduler and
+  // reset after each block.
   // TODO: investigate whether dynamic allocation is actually necessary.
-  Mem_Manager DDDMem;
+  Mem_Manager &DDDMem;
   Edge_Allocator depEdgeAllocator;
   int HWthreadsPerEU;
   bool useMTLatencies;
@@ -318,8 +323,17 @@ class DDD {
   G4_Kernel *kernel;
   PointsToAnalysis &pointsToAnalysis;
 
+  // The edges from the node being added to the DAG, by successor node ID.
+  // Wide operands touch many buckets with the same live nodes, so this
+  // avoids searching the successors of the new node for every bucket.
+  std::vector<Node *> newEdgePred;
+  std::vector<unsigned> newEdgeIdx;
+
   // Gather all initial ready nodes.
   void collectRoots();
+  void addEdgeFromNewNode(Node *pred, Node *succ, DepType d);
+  void updateEdge(Node *pred, Edge &edge, DepType d);
+  void appendEdge(Node *pred, Node *succ, DepType d);
 
 public:
   typedef std::pair<Node *, Node *> instrPair_t;
@@ -347,7 +361,8 @@ private:
   bool canFwdDPAS(const G4_INST &curInst, const G4_INST &nextInst) const;
 
 public:
-  DDD(G4_BB *bb, const LatencyTable &lt, G4_Kernel *k, PointsToAnalysis &p);
+  DDD(G4_BB *bb, const LatencyTable &lt, G4_Kernel *k, PointsToAnalysis &p,
+      Mem_Manager &mem);
   ~DDD() = default;
   void dumpNodes(G4_BB *bb);
   void dumpDagDot(G4_BB *bb);
@@ -388,7 +403,7 @@ public:
   unsigned sequentialCycle = 0;
 
   G4_BB_Schedule(G4_Kernel *kernel, G4_BB *bb, const LatencyTable &LT,
-                 PointsToAnalysis &p);
+                 PointsToAnalysis &p, Mem_Manager &mem);
   // Dumps the schedule
   void emit(std::ostream &);
   void dumpSchedule(G4_BB *bb);
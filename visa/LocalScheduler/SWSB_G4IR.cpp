@@ -11,8 +11,10 @@ SPDX-License-Identifier: MIT
 #include "../PointsToAnalysis.h"
 #include "Dependencies_G4IR.h"
 #include "visa_wa.h"
+#include "../Timer.h"
 
 #include <algorithm>
+#include <deque>
 #include <limits>
 #include <sstream>
 
@@ -1689,6 +1691,7 @@ void SWSB::SWSBBuildSIMDCFG() {
 void SWSB::SWSBDepDistanceGenerator(PointsToAnalysis &p, LiveGRFBuckets &LB,
                                     LiveGRFBuckets &globalSendsLB,
                                     LiveGRFBuckets &GRFAlignedGlobalSendsLB) {
+  TIME_SCOPE(SWSB_DEP_DISTANCE);
   BB_LIST_ITER ib(fg.begin()), bend(fg.end());
 
   // Initialize global data
@@ -1930,14 +1933,18 @@ void SWSB::SWSBGlobalTokenGenerator(PointsToAnalysis &p, LiveGRFBuckets &LB,
   }
 
   // SWSB token allocation with linear scan algorithm.
-  if (enableGlobalTokenAllocation) {
-    tokenAllocationGlobal();
-  } else if (enableDistPropTokenAllocation) {
-    tokenAllocationGlobalWithPropogation();
-  } else if (fg.builder->getOptions()->getOption(vISA_QuickTokenAllocation)) {
-    quickTokenAllocation();
-  } else {
-    tokenAllocation();
+  {
+    TIME_SCOPE(SWSB_TOKEN_ALLOCATION);
+    if (enableGlobalTokenAllocation) {
+      tokenAllocationGlobal();
+    } else if (enableDistPropTokenAllocation) {
+      tokenAllocationGlobalWithPropogation();
+    } else if (fg.builder->getOptions()->getOption(
+                   vISA_QuickTokenAllocation)) {
+      quickTokenAllocation();
+    } else {
+      tokenAllocation();
+    }
   }
 
   // Insert sync instruction in case the dependences are more than token field
@@ -3000,10 +3007,10 @@ void SWSB::addToLiveList(SBNode *node) {
 }
 
 //
-//  Global reaching define analysis for tokens
+//  Global reaching define analysis for tokens.
+//  Returns true if the live out of the BB changed.
 //
 bool SWSB::globalTokenReachAnalysis(G4_BB *bb) {
-  bool changed = false;
   unsigned bbID = bb->getId();
 
   // Do nothing for the entry BB
@@ -3031,7 +3038,6 @@ bool SWSB::globalTokenReachAnalysis(G4_BB *bb) {
 
   // Changed? Yes, get the new live in, other wise do nothing
   if (temp_live_in != BBVector[bbID]->liveInTokenNodes) {
-    changed = true;
     BBVector[bbID]->liveInTokenNodes = temp_live_in;
   }
 
@@ -3048,45 +3054,58 @@ bool SWSB::globalTokenReachAnalysis(G4_BB *bb) {
   // Original, we only have local live out.
   // should we separate the local live out vs total live out?
   // Not necessary, can live out, will always be live out.
-  BBVector[bbID]->liveOutTokenNodes |= temp_live_in;
-
-  return changed;
+  return BBVector[bbID]->liveOutTokenNodes.unionWith(temp_live_in);
 }
 
-void SWSB::SWSBGlobalTokenAnalysis() {
-  bool change = true;
-  while (change) {
-    change = false;
-    for (G4_BB *bb : fg) {
-      if (globalTokenReachAnalysis(bb)) {
-        change = true;
-      }
+//
+// Runs a reach analysis to a fixed point. Every BB is visited once in layout
+// order; after that, a BB is only visited again when the live out of one of
+// its predecessors changed, so the cost follows the blocks that change rather
+// than the kernel size.
+//
+void SWSB::solveGlobalReachAnalysis(bool (SWSB::*transfer)(G4_BB *),
+                                    bool scalarSuccs, bool SIMDSuccs) {
+  TIME_SCOPE(SWSB_GLOBAL_ANALYSIS);
+  std::vector<bool> queued(BBVector.size(), true);
+  std::deque<G4_BB_SB *> worklist(BBVector.begin(), BBVector.end());
+  auto enqueue = [&](G4_BB_SB *succ) {
+    if (!queued[succ->getBB()->getId()]) {
+      queued[succ->getBB()->getId()] = true;
+      worklist.push_back(succ);
+    }
+  };
+
+  while (!worklist.empty()) {
+    G4_BB_SB *sbBB = worklist.front();
+    worklist.pop_front();
+    G4_BB *bb = sbBB->getBB();
+    queued[bb->getId()] = false;
+    if (!(this->*transfer)(bb))
+      continue;
+
+    if (scalarSuccs) {
+      for (G4_BB *succ : bb->Succs)
+        enqueue(BBVector[succ->getId()]);
+    }
+    if (SIMDSuccs) {
+      for (G4_BB_SB *succ : sbBB->Succs)
+        enqueue(succ);
     }
   }
 }
 
+void SWSB::SWSBGlobalTokenAnalysis() {
+  solveGlobalReachAnalysis(&SWSB::globalTokenReachAnalysis, true, true);
+}
+
 void SWSB::SWSBGlobalScalarCFGReachAnalysis() {
-  bool change = true;
-  while (change) {
-    change = false;
-    for (G4_BB *bb : fg) {
-      if (globalDependenceDefReachAnalysis(bb)) {
-        change = true;
-      }
-    }
-  }
+  solveGlobalReachAnalysis(&SWSB::globalDependenceDefReachAnalysis, true,
+                           false);
 }
 
 void SWSB::SWSBGlobalSIMDCFGReachAnalysis() {
-  bool change = true;
-  while (change) {
-    change = false;
-    for (G4_BB *bb : fg) {
-      if (globalDependenceUseReachAnalysis(bb)) {
-        change = true;
-      }
-    }
-  }
+  solveGlobalReachAnalysis(&SWSB::globalDependenceUseReachAnalysis, false,
+                           true);
 }
 
 void SWSB::setTopTokenIndex() {
@@ -4747,6 +4766,7 @@ void SWSB::insertSync(G4_BB *bb, SBNode *node, G4_INST *inst,
 //                                others - Reserved
 // clang-format on
 void SWSB::insertTokenSync() {
+  TIME_SCOPE(SWSB_SYNC_INSERTION);
   SBNODE_VECT_ITER node_it = SBNodes.begin();
   int newInstID = 0;
 
@@ -5540,9 +5560,9 @@ void SWSB::buildLiveIntervals() {
 //
 // live_in(BBi) = Union(def_out(BBj)) // BBj is predecessor of BBi
 // live_out(BBi) += live_in(BBi) - may_kill(BBi)
+// Returns true if live_out(BBi) changed.
 //
 bool SWSB::globalDependenceDefReachAnalysis(G4_BB *bb) {
-  bool changed = false;
   unsigned bbID = bb->getId();
 
   if (bb->Preds.empty()) {
@@ -5565,7 +5585,6 @@ bool SWSB::globalDependenceDefReachAnalysis(G4_BB *bb) {
   }
 
   if (temp_live_in != BBVector[bbID]->send_live_in) {
-    changed = true;
     BBVector[bbID]->send_live_in = temp_live_in;
   }
 
@@ -5584,17 +5603,15 @@ bool SWSB::globalDependenceDefReachAnalysis(G4_BB *bb) {
   temp_live_in -= BBVector[bbID]->send_may_kill;
   temp_live_in.src = temp_live_in.src - BBVector[bbID]->send_may_kill.dst;
 
-  BBVector[bbID]->send_live_out |= temp_live_in;
-
-  return changed;
+  return BBVector[bbID]->send_live_out.unionWith(temp_live_in);
 }
 
 //
 // live_in(BBi) = Union(def_out(BBj)) // BBj is predecessor of BBi
 // live_out(BBi) += live_in(BBi) - may_kill(BBi)
+// Returns true if live_out(BBi) changed.
 //
 bool SWSB::globalDependenceUseReachAnalysis(G4_BB *bb) {
-  bool changed = false;
   unsigned bbID = bb->getId();
 
   if (bb->Preds.empty()) {
@@ -5619,7 +5636,6 @@ bool SWSB::globalDependenceUseReachAnalysis(G4_BB *bb) {
   }
 
   if (temp_live_in != BBVector[bbID]->send_live_in) {
-    changed = true;
     BBVector[bbID]->send_live_in = temp_live_in;
   }
 
@@ -5628,9 +5644,7 @@ bool SWSB::globalDependenceUseReachAnalysis(G4_BB *bb) {
   temp_live_in.src = temp_live_in.src - BBVector[bbID]->send_may_kill.src;
   temp_live_in.dst = temp_live_in.dst - BBVector[bbID]->send_WAW_may_kill;
 
-  BBVector[bbID]->send_live_out |= temp_live_in;
-
-  return changed;
+  return BBVector[bbID]->send_live_out.unionWith(temp_live_in);
 }
 
 void SWSB::tokenEdgePrune(unsigned &prunedEdgeNum,
@@ -8458,6 +8472,7 @@ void SWSB::addGlobalDependence(unsigned globalSendNum,
                                SBBUCKET_VECTOR *globalSendOpndList,
                                SBNODE_VECT &SBNodes, PointsToAnalysis &p,
                                bool afterWrite) {
+  TIME_SCOPE(SWSB_GLOBAL_DEPS);
   const bool enableDPASTokenReduction =
       fg.builder->getOption(vISA_EnableDPASTokenReduction);
 
@@ -8800,6 +8815,7 @@ void SWSB::addReachingUseSet(SBNode *node, SBNode *use) {
 void SWSB::addGlobalDependenceWithReachingDef(
     unsigned globalSendNum, SBBUCKET_VECTOR *globalSendOpndList,
     SBNODE_VECT &SBNodes, PointsToAnalysis &p, bool afterWrite) {
+  TIME_SCOPE(SWSB_GLOBAL_DEPS);
   for (size_t i = 0; i < BBVector.size(); i++) {
     // Get global send operands killed by current BB
     SBBitSets send_kill;
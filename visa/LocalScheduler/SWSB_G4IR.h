@@ -235,6 +235,13 @@ struct SBBitSets {
     return *this;
   }
 
+  // Same as operator|=, but returns true if either set changed.
+  bool unionWith(const SBBitSets &other) {
+    bool changed = dst |= other.dst;
+    changed |= src |= other.src;
+    return changed;
+  }
+
   SBBitSets &operator&=(const SBBitSets &other) {
     dst &= other.dst;
     src &= other.src;
@@ -1151,6 +1158,8 @@ class SWSB {
   void addSIMDEdge(G4_BB_SB *pred, G4_BB_SB *succ);
   void SWSBGlobalScalarCFGReachAnalysis();
   void SWSBGlobalSIMDCFGReachAnalysis();
+  void solveGlobalReachAnalysis(bool (SWSB::*transfer)(G4_BB *),
+                                bool scalarSuccs, bool SIMDSuccs);
 
   void setTopTokenIndex();
 
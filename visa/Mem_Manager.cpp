@@ -13,6 +13,6 @@ SPDX-License-Identifier: MIT
 #include "Mem_Manager.h"
 using namespace vISA;
 Mem_Manager::Mem_Manager(size_t defaultArenaSize)
-    : _arenaManager(defaultArenaSize) {}
+    : _arenaManager(defaultArenaSize), _start(_arenaManager.GetMark()) {}
 
 Mem_Manager::~Mem_Manager() {}
@@ -33,15 +33,44 @@ public:
     return _arenaManager.AllocDataSpace(size, static_cast<size_t>(al));
   }
 
+  // Give back a block returned by alloc(size). Small blocks are reused by
+  // later allocations of same size; callers must not touch it afterwards.
+  void free(void *p, size_t size) { _arenaManager.FreeDataSpace(p, size); }
+
   // Free all arenas and reinitialize; used to release memory after
   // Phase 1 compilation of a stack-call function.
   void releaseMemory() {
     _arenaManager.FreeArenas();
     _arenaManager.CreateArena(_arenaManager._defaultArenaSize);
+    _start = _arenaManager.GetMark();
   }
 
+  // Release everything allocated so far but keep one arena for reuse.
+  // Cheaper than destroying and creating a Mem_Manager for transient data
+  // that's rebuilt over and over, eg per BB or per RA iteration.
+  void reset() { _arenaManager.Rollback(_start); }
+
+  // Everything allocated from the Mem_Manager during the lifetime of a Scope
+  // is released when the Scope ends. Objects allocated in the scope must not
+  // be used afterwards and their destructors are not run. Scopes may nest
+  // but must end in reverse order.
+  class Scope {
+    Mem_Manager &mem;
+    const ArenaManager::Mark mark;
+
+  public:
+    explicit Scope(Mem_Manager &m) : mem(m), mark(m._arenaManager.GetMark()) {}
+    ~Scope() { mem._arenaManager.Rollback(mark); }
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+  };
+
+  // Bytes reserved from the system by this Mem_Manager
+  size_t getReservedBytes() const { return _arenaManager._reservedBytes; }
+
 private:
   vISA::ArenaManager _arenaManager;
+  ArenaManager::Mark _start;
 };
 
 template <class T> class std_arena_based_allocator {
@@ -117,5 +146,54 @@ public:
 
   void resetMem() { mem_manager_ptr->releaseMemory(); }
 };
+
+// An std_arena_based_allocator whose deallocate() gives small blocks back to
+// the Mem_Manager's free lists, for containers whose elements churn. Unlike
+// std_arena_based_allocator, two allocators compare equal only if they share
+// the Mem_Manager, so a block is never recycled by another arena.
+template <class T>
+class std_arena_recycling_allocator : public std_arena_based_allocator<T> {
+  using Base = std_arena_based_allocator<T>;
+
+public:
+  typedef typename Base::size_type size_type;
+
+  explicit std_arena_recycling_allocator(
+      std::shared_ptr<Mem_Manager> _other_ptr)
+      : Base(_other_ptr) {}
+
+  explicit std_arena_recycling_allocator() : Base() {}
+
+  std_arena_recycling_allocator(const std_arena_recycling_allocator &other)
+      : Base(other) {}
+
+  template <class U>
+  std_arena_recycling_allocator(const std_arena_recycling_allocator<U> &other)
+      : Base(other.mem_manager_ptr) {}
+
+  std_arena_recycling_allocator &
+  operator=(const std_arena_recycling_allocator &other) {
+    this->mem_manager_ptr = other.mem_manager_ptr;
+    return *this;
+  }
+
+  template <class U> struct rebind {
+    typedef std_arena_recycling_allocator<U> other;
+  };
+
+  template <class U> friend class std_arena_recycling_allocator;
+
+  void deallocate(void *p, size_type n) {
+    this->mem_manager_ptr->free(p, n * sizeof(T));
+  }
+
+  bool operator==(const std_arena_recycling_allocator &a) const {
+    return this->mem_manager_ptr == a.mem_manager_ptr;
+  }
+
+  bool operator!=(const std_arena_recycling_allocator &a) const {
+    return !operator==(a);
+  }
+};
 } // namespace vISA
 #endif
@@ -16,6 +16,7 @@ SPDX-License-Identifier: MIT
 #include "DebugInfo.h"
 #include "FlowGraph.h"
 #include "Passes/AccSubstitution.hpp"
+#include "Passes/GlobalSchedule.hpp"
 #include "Passes/InsertS0Movs.hpp"
 #include "Passes/InstCombine.hpp"
 #include "Passes/LVN.hpp"
@@ -659,7 +660,7 @@ void Optimizer::runPass(PassIndex Index) {
 
   // Do not execute.
   if ((PI.Option != vISA_EnableAlways && !builder.getOption(PI.Option)) ||
-      EarlyExited)
+      kernel.getCompileTier() < PI.MinTier || EarlyExited)
     return;
 
   std::string Name = PI.Name;
@@ -679,9 +680,16 @@ void Optimizer::runPass(PassIndex Index) {
 
   kernel.dumpToFile("before." + Name);
 
+  auto &arenaUsage = ArenaUsage::current();
+  if (arenaUsage)
+    arenaUsage->beginPhase(PI.Name);
+
   // Execute pass.
   (this->*(PI.Pass))();
 
+  if (arenaUsage)
+    arenaUsage->endPhase();
+
   if (PI.Timer != TimerID::NUM_TIMERS)
     stopTimer(PI.Timer);
 
@@ -718,6 +726,8 @@ void Optimizer::initOptimizations() {
   // The third argument is the intended timer for this pass. If no timing
   // is necessary, then TIMER_NUM_TIMERS can be used.
   //
+  OPT_INITIALIZE_PASS(selectCompileTier, vISA_EnableAlways,
+                      TimerID::OPTIMIZER);
   OPT_INITIALIZE_PASS(cleanMessageHeader, vISA_LocalCleanMessageHeader,
                       TimerID::OPTIMIZER);
   OPT_INITIALIZE_PASS(forceNoMaskOnM0, vISA_forceNoMaskOnM0,
@@ -743,8 +753,13 @@ void Optimizer::initOptimizations() {
                       TimerID::HW_CONFORMITY);
   OPT_INITIALIZE_PASS(computeDynamicSpillThreshold, vISA_DynamicSpillThreshold,
                       TimerID::MISC_OPTS);
+  OPT_INITIALIZE_PASS(globalSchedule, vISA_GlobalScheduling,
+                      TimerID::GLOBAL_SCHEDULING);
+  Passes[PI_globalSchedule].MinTier = 1;
   OPT_INITIALIZE_PASS(preRA_Schedule, vISA_preRA_Schedule,
                       TimerID::PRERA_SCHEDULING);
+  // Tier 0 trades the schedule for the fastest possible compile.
+  Passes[PI_preRA_Schedule].MinTier = 1;
   OPT_INITIALIZE_PASS(preRA_HWWorkaround, vISA_EnableAlways,
                       TimerID::MISC_OPTS);
   OPT_INITIALIZE_PASS(preRegAlloc, vISA_EnableAlways, TimerID::MISC_OPTS);
@@ -980,6 +995,9 @@ int Optimizer::optimization() {
   }
 #endif // DLL_MODE
 
+  // Pick the RA and scheduling effort before any pass depends on it.
+  runPass(PI_selectCompileTier);
+
   // remove redundant message headers.
   runPass(PI_cleanMessageHeader);
 
@@ -1044,6 +1062,9 @@ int Optimizer::optimization() {
   // (consumes it via GraphColor).
   runPass(PI_computeDynamicSpillThreshold);
 
+  // Hoist sends across BBs, so preRA scheduling sees them in their new blocks.
+  runPass(PI_globalSchedule);
+
   // PreRA scheduling
   runPass(PI_preRA_Schedule);
 
@@ -6090,6 +6111,46 @@ void Optimizer::messageHeaderReport(size_t ic_before, size_t ic_after,
   });
 }
 
+void Optimizer::globalSchedule() {
+  GlobalSchedule sched(kernel);
+  sched.run();
+
+  auto &stats = builder.getJitInfo()->statsVerbose;
+  stats.globalSchedHoistedSends += sched.getNumHoistedSends();
+  stats.globalSchedCycleGain += (uint32_t)sched.getCycleGain();
+}
+
+//
+// Pick the compile tier of the kernel:
+//   tier 0: linear scan RA (hybrid RA with spill for non-3D) and no preRA
+//           scheduling, to get a binary as fast as possible.
+//   tier 1: single iteration hybrid RA, spilling what does not fit.
+//   tier 2: full graph coloring RA.
+// -compileTier is the highest tier allowed. With -compileBudget, the highest
+// tier whose estimated time fits in the budget is used instead, and the
+// runtime may later recompile the kernel at a higher tier in the background.
+//
+void Optimizer::selectCompileTier() {
+  constexpr unsigned MaxTier = 2;
+  unsigned tier = std::min(builder.getuint32Option(vISA_CompileTier), MaxTier);
+  unsigned budget = builder.getuint32Option(vISA_CompileBudget);
+  if (budget != 0 && tier > 0) {
+    unsigned numInsts = 0;
+    for (G4_BB *bb : kernel.fg)
+      numInsts += (unsigned)bb->size();
+    // Each lower tier is assumed to be about 4x faster than the one above.
+    uint64_t instsInBudget =
+        (uint64_t)budget * builder.getuint32Option(vISA_CompileTierInstsPerMs);
+    while (tier > 0 && numInsts > instsInBudget) {
+      --tier;
+      instsInBudget *= 4;
+    }
+  }
+  kernel.setCompileTier(tier);
+  VISA_DEBUG_VERBOSE(std::cout << "compile tier " << tier << " for "
+                               << kernel.getName() << "\n");
+}
+
 //
 // optimizer for removal of redundant message header instructions
 //
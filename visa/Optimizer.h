@@ -105,6 +105,7 @@ class Optimizer {
   // optimization phases
   //
   G4_SrcModifier mergeModifier(G4_Operand *def, G4_Operand *use);
+  void selectCompileTier();
   void cleanMessageHeader();
   void forceNoMaskOnM0();
   void sendFusion();
@@ -162,6 +163,8 @@ class Optimizer {
     Sched.run();
   }
 
+  void globalSchedule();
+
   void preRA_Schedule() {
     unsigned KernelPressure = 0;
     preRA_Scheduler Sched(kernel);
@@ -360,13 +363,16 @@ private:
     /// timer i.e. TIMER_NUM_TIMERS, then no time will be recorded.
     TimerID Timer;
 
+    /// The lowest compile tier that runs this pass, see selectCompileTier.
+    unsigned MinTier;
+
     PassInfo(PassType P, const char *N, vISAOptions O,
-             TimerID T = TimerID::NUM_TIMERS)
-        : Pass(P), Name(N), Option(O), Timer(T) {}
+             TimerID T = TimerID::NUM_TIMERS, unsigned MT = 0)
+        : Pass(P), Name(N), Option(O), Timer(T), MinTier(MT) {}
 
     PassInfo()
         : Pass(0), Name(0), Option(vISA_EnableAlways),
-          Timer(TimerID::NUM_TIMERS) {}
+          Timer(TimerID::NUM_TIMERS), MinTier(0) {}
   };
 
   bool foldPseudoAndOr(G4_BB *bb, INST_LIST_ITER &iter);
@@ -374,7 +380,8 @@ private:
 public:
   /// Index enum for each pass in the pass array.
   enum PassIndex {
-    PI_cleanMessageHeader = 0,
+    PI_selectCompileTier = 0, // always
+    PI_cleanMessageHeader,
     PI_forceNoMaskOnM0,
     PI_sendFusion,
     PI_renameRegister,
@@ -390,6 +397,7 @@ public:
     PI_preRA_HWWorkaround,  // always, each WA under specific control
     PI_postRA_HWWorkaround, // always, each WA under specific control
     PI_computeDynamicSpillThreshold, // always
+    PI_globalSchedule,
     PI_preRA_Schedule,
     PI_preRegAlloc,           // always
     PI_regAlloc,              // always
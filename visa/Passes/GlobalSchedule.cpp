@@ -0,0 +1,279 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "GlobalSchedule.hpp"
+#include "../FrequencyInfo.h"
+#include "../LoopAnalysis.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+using namespace vISA;
+
+using Scaled64 = llvm::ScaledNumber<uint64_t>;
+
+GlobalSchedule::GlobalSchedule(G4_Kernel &k)
+    : kernel(k), builder(*k.fg.builder),
+      LT(LatencyTable::createLatencyTable(*k.fg.builder)),
+      maxRegionInsts(k.getOptions()->getuInt32Option(
+          vISA_GlobalSchedMaxRegionInsts)),
+      maxSendsPerRegion(
+          k.getOptions()->getuInt32Option(vISA_GlobalSchedMaxSends)) {}
+
+static bool endsRegion(const G4_INST *inst) {
+  return inst->isCall() || inst->isFCall() || inst->isReturn() ||
+         inst->isFReturn() || inst->isEOT();
+}
+
+void GlobalSchedule::Barrier::add(G4_INST *inst) {
+  if (inst->isSend()) {
+    const G4_SendDesc *desc = inst->getMsgDesc();
+    if (!desc || desc->isWrite() || desc->isAtomic() || desc->isFence() ||
+        desc->isBarrier())
+      writesMemory = true;
+  } else if ((inst->isIntrinsic() && !inst->isPseudoKill() &&
+              !inst->isLifeTimeEnd()) ||
+             inst->isWait()) {
+    writesMemory = true;
+  }
+
+  for (unsigned i = 0; i < Opnd_total_num; ++i) {
+    auto opndNum = (Gen4_Operand_Number)i;
+    const G4_Operand *opnd = inst->getOperand(opndNum);
+    if (!opnd || !opnd->getTopDcl())
+      continue;
+    const G4_Declare *root = opnd->getTopDcl()->getRootDeclare();
+    refs.insert(root);
+    if (opndNum == Opnd_dst || opndNum == Opnd_condMod ||
+        opndNum == Opnd_implAccDst)
+      defs.insert(root);
+  }
+}
+
+// Finds the region whose blocks all run exactly when join runs. The region is
+// rejected if it has a cycle, leaves the loop of its head, or calls out.
+bool GlobalSchedule::findRegion(G4_BB *join, Region &R) {
+  if (join->Preds.size() < 2)
+    return false;
+  G4_BB *head = kernel.fg.getImmDominator().getIDoms()[join->getId()];
+  if (!head || head == join || head->empty() ||
+      layoutPos[head->getId()] >= layoutPos[join->getId()] ||
+      endsRegion(head->back()))
+    return false;
+  if (!kernel.fg.getPostDominator().getPostDom(head).count(join))
+    return false;
+  LoopDetection &loops = kernel.fg.getLoops();
+  if (loops.getInnerMostLoop(head) != loops.getInnerMostLoop(join))
+    return false;
+
+  const unsigned headPos = layoutPos[head->getId()];
+  const unsigned joinPos = layoutPos[join->getId()];
+  std::unordered_set<G4_BB *> visited;
+  std::vector<G4_BB *> worklist(head->Succs.begin(), head->Succs.end());
+  unsigned numInsts = 0;
+  R.body.clear();
+  while (!worklist.empty()) {
+    G4_BB *bb = worklist.back();
+    worklist.pop_back();
+    if (bb == join || !visited.insert(bb).second)
+      continue;
+    const unsigned pos = layoutPos[bb->getId()];
+    if (pos <= headPos || pos >= joinPos)
+      return false;
+    numInsts += (unsigned)bb->size();
+    if (numInsts > maxRegionInsts)
+      return false;
+    for (auto inst : *bb) {
+      if (endsRegion(inst))
+        return false;
+    }
+    for (auto succ : bb->Succs) {
+      if (succ != join && layoutPos[succ->getId()] <= pos)
+        return false;
+      worklist.push_back(succ);
+    }
+    R.body.push_back(bb);
+  }
+  if (R.body.empty())
+    return false;
+
+  std::sort(R.body.begin(), R.body.end(), [this](G4_BB *a, G4_BB *b) {
+    return layoutPos[a->getId()] < layoutPos[b->getId()];
+  });
+  R.head = head;
+  R.join = join;
+  return true;
+}
+
+// Returns the cycles the region body is expected to issue per run of its
+// head, which bounds the latency a hoisted send can hide. Block probabilities
+// come from the profile when there is one. Otherwise they are propagated the
+// way KernelCost does: a uniform branch splits evenly among its successors,
+// while both sides of a divergent branch run.
+float GlobalSchedule::getExpectedCycles(const Region &R) {
+  FrequencyInfo &freqInfo = builder.getFreqInfoManager();
+  Scaled64 headFreq = freqInfo.getBlockFreqInfo(R.head);
+
+  std::unordered_map<G4_BB *, float> prob;
+  prob[R.head] = 1.0f;
+  auto getEdgeProb = [&prob](G4_BB *pred) {
+    auto it = prob.find(pred);
+    if (it == prob.end())
+      return 0.0f;
+    G4_InstCF *br = pred->getLastCFInst();
+    if (pred->Succs.size() == 1 || (br && !br->isUniform()))
+      return it->second;
+    return it->second / pred->Succs.size();
+  };
+
+  float cycles = 0;
+  for (G4_BB *bb : R.body) {
+    float p = 0;
+    if (!headFreq.isZero()) {
+      Scaled64 ratio =
+          freqInfo.getBlockFreqInfo(bb) * Scaled64::get(1024) / headFreq;
+      p = ratio.toInt<uint64_t>() / 1024.0f;
+    } else {
+      for (G4_BB *pred : bb->Preds)
+        p += getEdgeProb(pred);
+    }
+    p = std::min(p, 1.0f);
+    prob[bb] = p;
+
+    unsigned bbCycles = 0;
+    for (auto inst : *bb) {
+      if (!inst->isLabel() && !inst->isPseudoKill() && !inst->isLifeTimeEnd())
+        bbCycles += LT->getOccupancy(inst);
+    }
+    cycles += p * bbCycles;
+  }
+  return cycles;
+}
+
+bool GlobalSchedule::canHoist(G4_INST *send, const Barrier &B) const {
+  if (!send->isSend() || send->isSendg() || send->isSendConditional() ||
+      send->isEOT() || send->getPredicate() || B.writesMemory)
+    return false;
+  const G4_SendDesc *desc = send->getMsgDesc();
+  if (!desc || !desc->isRead() || desc->isWrite() || desc->isAtomic() ||
+      desc->isFence() || desc->isBarrier())
+    return false;
+  // Register descriptors are set up right before the send.
+  G4_InstSend *sendInst = send->asSendInst();
+  if (!sendInst->getMsgDescOperand()->isImm())
+    return false;
+  if (sendInst->isSplitSend()) {
+    G4_Operand *exDesc = sendInst->getMsgExtDescOperand();
+    if (exDesc && !exDesc->isImm())
+      return false;
+  }
+
+  G4_DstRegRegion *dst = send->getDst();
+  if (!dst || dst->isNullReg() || dst->isIndirect() || !dst->getTopDcl())
+    return false;
+  const G4_Declare *dstDcl = dst->getTopDcl()->getRootDeclare();
+  if (dstDcl->getAddressed() || B.refs.count(dstDcl))
+    return false;
+
+  for (unsigned i = 0, numSrc = sendInst->getNumSrcPayloads(); i < numSrc;
+       ++i) {
+    G4_Operand *src = send->getSrc(i);
+    if (!src || src->isNullReg())
+      continue;
+    if (!src->isSrcRegRegion() || src->asSrcRegRegion()->isIndirect() ||
+        !src->getTopDcl())
+      return false;
+    const G4_Declare *srcDcl = src->getTopDcl()->getRootDeclare();
+    if (srcDcl->getAddressed() || B.defs.count(srcDcl))
+      return false;
+  }
+  return true;
+}
+
+void GlobalSchedule::scheduleRegion(Region &R) {
+  const float expectedCycles = getExpectedCycles(R);
+  if (expectedCycles < 1.0f)
+    return;
+
+  Barrier B;
+  INST_LIST_ITER insertPos = R.head->end();
+  if (R.head->back()->isFlowControl()) {
+    insertPos = std::prev(insertPos);
+    B.add(*insertPos);
+  }
+  for (G4_BB *bb : R.body) {
+    for (auto inst : *bb)
+      B.add(inst);
+  }
+
+  // A pseudo_kill of a hoisted send's dst moves with it; it is only added to
+  // the barrier once something else references the variable.
+  std::unordered_map<const G4_Declare *, INST_LIST_ITER> pendingKills;
+  unsigned numHoisted = 0;
+  G4_BB *join = R.join;
+  for (auto it = join->begin(); it != join->end() && !B.writesMemory &&
+                                numHoisted < maxSendsPerRegion;) {
+    G4_INST *inst = *it;
+    if (inst->isLabel()) {
+      ++it;
+      continue;
+    }
+    if (inst->isFlowControl() && inst->opcode() != G4_join &&
+        inst->opcode() != G4_endif)
+      break;
+    if (inst->isPseudoKill() && inst->getDst()->getTopDcl()) {
+      pendingKills[inst->getDst()->getTopDcl()->getRootDeclare()] = it++;
+      continue;
+    }
+    if (!canHoist(inst, B)) {
+      for (unsigned i = 0; i < Opnd_total_num; ++i) {
+        G4_Operand *opnd = inst->getOperand((Gen4_Operand_Number)i);
+        if (opnd && opnd->getTopDcl())
+          pendingKills.erase(opnd->getTopDcl()->getRootDeclare());
+      }
+      B.add(inst);
+      ++it;
+      continue;
+    }
+
+    auto next = std::next(it);
+    auto kill = pendingKills.find(inst->getDst()->getTopDcl()->getRootDeclare());
+    if (kill != pendingKills.end()) {
+      R.head->splice(insertPos, join, kill->second);
+      pendingKills.erase(kill);
+    }
+    // Def-use links are local to a BB.
+    inst->removeAllDefs();
+    inst->removeAllUses();
+    R.head->splice(insertPos, join, it);
+    it = next;
+
+    ++numHoisted;
+    cycleGain += (uint64_t)std::min<float>(LT->getLatency(inst),
+                                           expectedCycles);
+  }
+  numHoistedSends += numHoisted;
+}
+
+void GlobalSchedule::run() {
+  unsigned maxId = 0;
+  for (auto bb : kernel.fg)
+    maxId = std::max(maxId, bb->getId());
+  layoutPos.assign(maxId + 1, 0);
+  unsigned pos = 0;
+  for (auto bb : kernel.fg)
+    layoutPos[bb->getId()] = pos++;
+
+  // Joins are visited in layout order, so a send hoisted into a head that is
+  // itself the join of an enclosing region is not considered again.
+  for (auto bb : kernel.fg) {
+    Region R;
+    if (findRegion(bb, R))
+      scheduleRegion(R);
+  }
+}
@@ -0,0 +1,82 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#ifndef _G4_GLOBAL_SCHEDULE_PASS_H_
+#define _G4_GLOBAL_SCHEDULE_PASS_H_
+
+#include "../BuildIR.h"
+#include "../FlowGraph.h"
+#include "../G4_IR.hpp"
+#include "../LocalScheduler/LatencyTable.h"
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+namespace vISA {
+
+// Cross-BB scheduling of long-latency reads. The local schedulers cannot hide
+// the latency of a send that starts a block, so a region
+//
+//   D: ...            D dominates J and J post-dominates D, so J runs
+//      (p) goto       whenever D does. The blocks M in between are
+//   M: ...            acyclic and in the same loop as D and J.
+//   J: send ...
+//
+// is scheduled as a trace and read-only sends at the top of J are hoisted to
+// the end of D, where their latency overlaps with M. The uses stay in J and
+// the local scheduler places them as late as the new def allows.
+class GlobalSchedule {
+  G4_Kernel &kernel;
+  IR_Builder &builder;
+  std::unique_ptr<LatencyTable> LT;
+  const unsigned maxRegionInsts;
+  const unsigned maxSendsPerRegion;
+
+  // Layout position of each BB, indexed by BB id.
+  std::vector<unsigned> layoutPos;
+
+  unsigned numHoistedSends = 0;
+  uint64_t cycleGain = 0;
+
+  struct Region {
+    G4_BB *head = nullptr;
+    G4_BB *join = nullptr;
+    // The blocks between head and join, in layout order.
+    std::vector<G4_BB *> body;
+  };
+
+  // Declares written and referenced between the insertion point in the head
+  // and the send, which the send must not be moved across.
+  struct Barrier {
+    std::unordered_set<const G4_Declare *> defs;
+    std::unordered_set<const G4_Declare *> refs;
+    bool writesMemory = false;
+    void add(G4_INST *inst);
+  };
+
+  bool findRegion(G4_BB *join, Region &R);
+  float getExpectedCycles(const Region &R);
+  bool canHoist(G4_INST *send, const Barrier &B) const;
+  void scheduleRegion(Region &R);
+
+public:
+  GlobalSchedule(G4_Kernel &k);
+  GlobalSchedule(const GlobalSchedule &) = delete;
+  GlobalSchedule &operator=(const GlobalSchedule &) = delete;
+
+  void run();
+
+  unsigned getNumHoistedSends() const { return numHoistedSends; }
+  // Static estimate of the cycles saved per run of the kernel.
+  uint64_t getCycleGain() const { return cycleGain; }
+};
+
+} // namespace vISA
+
+#endif // _G4_GLOBAL_SCHEDULE_PASS_H_
@@ -15,6 +15,7 @@ SPDX-License-Identifier: MIT
 #include "Timer.h"
 #include "VarSplit.h"
 
+#include <algorithm>
 #include <bitset>
 #include <climits>
 #include <cmath>
@@ -656,30 +657,20 @@ void LivenessAnalysis::computeLiveness() {
   std::vector<G4_BB *> PO;
   getPostOrder(fg.getEntryBB(), PO);
 
-  bool change;
-
   //
-  // backward flow analysis to propagate uses (locate last uses)
+  // Record local sets so next RA iteration can update liveness incrementally
   //
-  do {
-    change = false;
-    for (auto I = PO.begin(), E = PO.end(); I != E; ++I)
-      change |= contextFreeUseAnalyze(*I, change);
-  } while (change);
+  bool incLiveness = gra.incRA.isLivenessEnabled();
+  if (incLiveness) {
+    def_gen = def_out;
+    kernelInputDefs = inputDefs;
+    kernelOutputUses = outputUses;
+  }
 
-  //
-  // initialize entry block with payload input
-  //
-  def_in[fg.getEntryBB()->getId()] = std::move(inputDefs);
-
-  //
-  // forward flow analysis to propagate defs (locate first defs)
-  //
-  do {
-    change = false;
-    for (auto I = PO.rbegin(), E = PO.rend(); I != E; ++I)
-      change |= contextFreeDefAnalyze(*I, change);
-  } while (change);
+  if (!incLiveness || !incrementalFlowAnalysis(PO, inputDefs, outputUses))
+    contextFreeFlowAnalysis(PO, inputDefs);
+  else if (gra.incRA.isEnabledWithVerification())
+    verifyIncrementalFlowAnalysis(PO, inputDefs, outputUses);
 
   //
   // dump vectors for debugging
@@ -1636,6 +1627,216 @@ bool LivenessAnalysis::contextFreeDefAnalyze(G4_BB *bb, bool isChanged) {
   return changed;
 }
 
+void LivenessAnalysis::contextFreeFlowAnalysis(const std::vector<G4_BB *> &PO,
+                                               const SparseBitVector &inputDefs) {
+  bool change;
+
+  //
+  // backward flow analysis to propagate uses (locate last uses)
+  //
+  do {
+    change = false;
+    for (auto I = PO.begin(), E = PO.end(); I != E; ++I)
+      change |= contextFreeUseAnalyze(*I, change);
+  } while (change);
+
+  //
+  // initialize entry block with payload input
+  //
+  def_in[fg.getEntryBB()->getId()] = inputDefs;
+
+  //
+  // forward flow analysis to propagate defs (locate first defs)
+  //
+  do {
+    change = false;
+    for (auto I = PO.rbegin(), E = PO.rend(); I != E; ++I)
+      change |= contextFreeDefAnalyze(*I, change);
+  } while (change);
+}
+
+//
+// Update liveness computed in previous RA iteration instead of computing it
+// from scratch. Gen/kill sets of current iteration must already be computed.
+//
+// Each variable's liveness is an independent data flow problem. So for every
+// variable whose local sets are unchanged in all BBs, the previous fixed point
+// is still the fixed point on an unchanged CFG. Only bits of the changed
+// variables are recomputed, using a worklist seeded with BBs that reference
+// them. Spill/fill code inserted by previous iteration usually touches few
+// variables and BBs, so this is much cheaper than the full fixed point.
+//
+// Return false if previous liveness cannot be reused. Caller must run the full
+// analysis in that case.
+//
+bool LivenessAnalysis::incrementalFlowAnalysis(
+    const std::vector<G4_BB *> &PO, const SparseBitVector &inputDefs,
+    const SparseBitVector &outputUses) {
+  const IncrementalRA &incRA = gra.incRA;
+  if (!incRA.hasPrevLiveness(selectedRF) || incRA.def_gen.size() != numBBId)
+    return false;
+
+  for (auto bb : fg) {
+    const auto &prevSuccs = incRA.succs[bb->getId()];
+    if (prevSuccs.size() != bb->Succs.size() ||
+        !std::equal(bb->Succs.begin(), bb->Succs.end(), prevSuccs.begin(),
+                    [](const G4_BB *succ, unsigned int id) {
+                      return succ->getId() == id;
+                    }))
+      return false;
+  }
+
+  //
+  // collect variables whose local sets changed since previous iteration
+  //
+  SparseBitVector changed;
+  auto addDiff = [&changed](const SparseBitVector &cur,
+                            const SparseBitVector &prev) {
+    if (cur != prev) {
+      changed |= cur - prev;
+      changed |= prev - cur;
+    }
+  };
+
+  // Ids are expected to be stable across iterations, but treat any id now
+  // held by a different variable as changed.
+  for (unsigned i = 0, e = std::min((unsigned)incRA.vars.size(), numVarId);
+       i != e; ++i) {
+    if (vars[i] != incRA.vars[i])
+      changed.set(i);
+  }
+  addDiff(inputDefs, incRA.inputDefs);
+  addDiff(outputUses, incRA.outputUses);
+  for (unsigned i = 0; i != numBBId; ++i) {
+    addDiff(use_gen[i], incRA.use_gen[i]);
+    addDiff(use_kill[i], incRA.use_kill[i]);
+    addDiff(def_out[i], incRA.def_gen[i]);
+  }
+
+  //
+  // Seed reachable BBs with previous fixed point minus changed variables.
+  // Unreachable BBs are never visited by the full analysis either, so they
+  // keep their local sets.
+  //
+  std::vector<bool> reachable(numBBId, false);
+  for (auto bb : PO)
+    reachable[bb->getId()] = true;
+
+  // Changed variables start out dead everywhere in use_in. BBs that generate
+  // a use of them, and exit BBs, are visited first. def_out already holds
+  // local defs of changed variables, so successors of BBs defining them are
+  // visited first.
+  G4_BB *entryBB = fg.getEntryBB();
+  std::vector<G4_BB *> useWorklist, defWorklist;
+  std::vector<bool> onWorklist(numBBId, false);
+  auto addToDefWorklist = [&](G4_BB *bb) {
+    if (!onWorklist[bb->getId()]) {
+      onWorklist[bb->getId()] = true;
+      defWorklist.push_back(bb);
+    }
+  };
+  addToDefWorklist(entryBB);
+  for (auto bb : PO) {
+    unsigned id = bb->getId();
+    use_out[id] |= incRA.use_out[id] - changed;
+    use_in[id] = incRA.use_in[id] - changed;
+    def_in[id] = incRA.def_in[id] - changed;
+    def_out[id] |= incRA.def_out[id] - changed;
+
+    if (bb->Succs.empty() || !(use_gen[id] & changed).empty())
+      useWorklist.push_back(bb);
+    if (!(def_gen[id] & changed).empty()) {
+      for (auto succBB : bb->Succs)
+        addToDefWorklist(succBB);
+    }
+  }
+  def_in[entryBB->getId()] |= inputDefs;
+
+  //
+  // backward flow analysis for changed variables
+  //
+  std::vector<bool> onUseWorklist(numBBId, false);
+  for (auto bb : useWorklist)
+    onUseWorklist[bb->getId()] = true;
+  while (!useWorklist.empty()) {
+    G4_BB *bb = useWorklist.back();
+    useWorklist.pop_back();
+    unsigned id = bb->getId();
+    onUseWorklist[id] = false;
+
+    for (auto succBB : bb->Succs)
+      use_out[id] |= use_in[succBB->getId()];
+
+    SparseBitVector in = use_out[id] - use_kill[id];
+    in |= use_gen[id];
+    if (in == use_in[id])
+      continue;
+    use_in[id] = std::move(in);
+
+    for (auto predBB : bb->Preds) {
+      unsigned predId = predBB->getId();
+      if (reachable[predId] && !onUseWorklist[predId]) {
+        onUseWorklist[predId] = true;
+        useWorklist.push_back(predBB);
+      }
+    }
+  }
+
+  //
+  // forward flow analysis for changed variables
+  //
+  while (!defWorklist.empty()) {
+    G4_BB *bb = defWorklist.back();
+    defWorklist.pop_back();
+    unsigned id = bb->getId();
+    onWorklist[id] = false;
+
+    for (auto predBB : bb->Preds)
+      def_in[id] |= def_out[predBB->getId()];
+
+    SparseBitVector out = def_out[id] | def_in[id];
+    if (out == def_out[id])
+      continue;
+    def_out[id] = std::move(out);
+
+    for (auto succBB : bb->Succs)
+      addToDefWorklist(succBB);
+  }
+
+  VISA_DEBUG_VERBOSE(std::cout << "Incremental liveness: " << changed.count()
+                               << " of " << numVarId
+                               << " variables recomputed\n");
+  return true;
+}
+
+//
+// Verify that incremental liveness matches liveness computed from scratch.
+//
+void LivenessAnalysis::verifyIncrementalFlowAnalysis(
+    const std::vector<G4_BB *> &PO, const SparseBitVector &inputDefs,
+    const SparseBitVector &outputUses) {
+  auto incDefIn = def_in;
+  auto incDefOut = def_out;
+  auto incUseIn = use_in;
+  auto incUseOut = use_out;
+
+  for (auto bb : fg) {
+    unsigned id = bb->getId();
+    use_in[id] = use_gen[id];
+    if (bb->Succs.empty())
+      use_out[id] = outputUses;
+    else
+      use_out[id].clear();
+    def_in[id].clear();
+    def_out[id] = def_gen[id];
+  }
+  contextFreeFlowAnalysis(PO, inputDefs);
+
+  vISA_ASSERT(def_in == incDefIn && def_out == incDefOut &&
+                  use_in == incUseIn && use_out == incUseOut,
+              "incremental liveness differs from full liveness");
+}
+
 void LivenessAnalysis::dump_bb_vector(char *vname, std::vector<BitSet> &vec) {
   std::cerr << vname << "\n";
   for (BB_LIST_ITER it = fg.begin(); it != fg.end(); it++) {
@@ -76,6 +76,14 @@ class LivenessAnalysis {
 
   bool contextFreeUseAnalyze(G4_BB *bb, bool isChanged);
   bool contextFreeDefAnalyze(G4_BB *bb, bool isChanged);
+  void contextFreeFlowAnalysis(const std::vector<G4_BB *> &PO,
+                               const SparseBitVector &inputDefs);
+  bool incrementalFlowAnalysis(const std::vector<G4_BB *> &PO,
+                               const SparseBitVector &inputDefs,
+                               const SparseBitVector &outputUses);
+  void verifyIncrementalFlowAnalysis(const std::vector<G4_BB *> &PO,
+                                     const SparseBitVector &inputDefs,
+                                     const SparseBitVector &outputUses);
 
   bool livenessCandidate(const G4_Declare *decl, bool verifyRA) const;
 
@@ -115,6 +123,12 @@ public:
   std::unordered_map<FuncInfo *, SparseBitVector> args;
   std::unordered_map<FuncInfo *, SparseBitVector> retVal;
 
+  // Local def_out of each BB and kernel input/output sets. Recorded only
+  // when incremental RA may seed next iteration's liveness with this one.
+  std::vector<SparseBitVector> def_gen;
+  SparseBitVector kernelInputDefs;
+  SparseBitVector kernelOutputUses;
+
   // Hold variables known to be globals
   SparseBitVector globalVars;
 
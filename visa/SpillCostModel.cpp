@@ -0,0 +1,146 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "FrequencyInfo.h"
+#include "GraphColor.h"
+#include "LocalScheduler/LatencyTable.h"
+#include "LoopAnalysis.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+using namespace vISA;
+
+using Scaled64 = llvm::ScaledNumber<uint64_t>;
+
+// Deeper nests are weighted as if they were this deep, as in
+// GlobalRA::getRefCount.
+static const unsigned MAX_LOOP_DEPTH = 8;
+
+SpillCostModel::SpillCostModel(GlobalRA &g)
+    : gra(g), kernel(g.kernel),
+      loopTripCount(std::max(
+          1u, g.builder.getuint32Option(vISA_SpillCostLoopTripCount))) {
+  auto LT = LatencyTable::createLatencyTable(g.builder);
+  spillLatency = LT->getScratchLatency(true);
+  fillLatency = LT->getScratchLatency(false);
+}
+
+void SpillCostModel::computeBlockFreqs() {
+  unsigned maxId = 0;
+  for (auto bb : kernel.fg)
+    maxId = std::max(maxId, bb->getId());
+  blockFreq.assign(maxId + 1, 0.0f);
+
+  FrequencyInfo &freqInfo = gra.builder.getFreqInfoManager();
+  Scaled64 entryFreq = freqInfo.getBlockFreqInfo(kernel.fg.getEntryBB());
+  if (!entryFreq.isZero()) {
+    for (auto bb : kernel.fg) {
+      Scaled64 ratio =
+          freqInfo.getBlockFreqInfo(bb) * Scaled64::get(1024) / entryFreq;
+      blockFreq[bb->getId()] = ratio.toInt<uint64_t>() / 1024.0f;
+    }
+    return;
+  }
+
+  LoopDetection &loops = kernel.fg.getLoops();
+  for (auto bb : kernel.fg) {
+    Loop *innerMostLoop = loops.getInnerMostLoop(bb);
+    unsigned depth = innerMostLoop ? innerMostLoop->getNestingLevel() : 0;
+    blockFreq[bb->getId()] =
+        std::pow((float)loopTripCount, (float)std::min(depth, MAX_LOOP_DEPTH));
+  }
+}
+
+void SpillCostModel::startColoring() {
+  candidates.clear();
+
+  size_t numInsts = 0;
+  for (auto bb : kernel.fg)
+    numInsts += bb->size();
+  if (cachedIterNo == gra.getIterNo() && cachedNumInsts == numInsts)
+    return;
+  cachedIterNo = gra.getIterNo();
+  cachedNumInsts = numInsts;
+  dclCycles.clear();
+  computeBlockFreqs();
+}
+
+float SpillCostModel::getSpillFillCycles(G4_Declare *dcl, VarReferences &refs,
+                                         const IndirectRefs *indirectRefs) {
+  auto it = dclCycles.find(dcl);
+  if (it != dclCycles.end())
+    return it->second;
+
+  float cycles = 0.0f;
+  if (auto defs = refs.getDefs(dcl)) {
+    for (auto &def : *defs)
+      cycles += getBlockFreq(std::get<1>(def)) * spillLatency;
+  }
+  if (auto uses = refs.getUses(dcl)) {
+    for (auto &use : *uses)
+      cycles += getBlockFreq(std::get<1>(use)) * fillLatency;
+  }
+  // An indirect access fills and spills the whole pointee.
+  if (indirectRefs) {
+    for (auto &ref : *indirectRefs)
+      cycles += getBlockFreq(ref.second) * (fillLatency + spillLatency);
+  }
+
+  dclCycles[dcl] = cycles;
+  return cycles;
+}
+
+void SpillCostModel::addCandidate(G4_Declare *dcl, float legacyCost,
+                                  float cycles) {
+  candidates.push_back({dcl, legacyCost, cycles});
+}
+
+// The cycles avoided are estimated against the candidates the default cost
+// ranks lowest, taken until they free as many bytes as the actual spills.
+void SpillCostModel::recordSpills(const LIVERANGE_LIST &spilled) {
+  std::unordered_set<const G4_Declare *> spilledDcls;
+  for (auto lr : spilled)
+    spilledDcls.insert(lr->getDcl());
+
+  float chosenCycles = 0.0f;
+  unsigned spilledBytes = 0;
+  for (auto &c : candidates) {
+    if (spilledDcls.count(c.dcl)) {
+      chosenCycles += c.cycles;
+      spilledBytes += c.dcl->getByteSize();
+    }
+  }
+
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const Candidate &a, const Candidate &b) {
+                     return a.legacyCost < b.legacyCost;
+                   });
+  float legacyCycles = 0.0f;
+  unsigned legacyBytes = 0;
+  for (auto &c : candidates) {
+    if (legacyBytes >= spilledBytes)
+      break;
+    legacyCycles += c.cycles;
+    legacyBytes += c.dcl->getByteSize();
+  }
+
+  spillCycles += (uint64_t)chosenCycles;
+  if (legacyCycles > chosenCycles)
+    cyclesAvoided += (uint64_t)(legacyCycles - chosenCycles);
+  candidates.clear();
+
+  RA_TRACE(std::cout << "\t--spill cost: " << spillCycles << " cycles, "
+                     << cyclesAvoided << " cycles avoided\n");
+
+  auto &stats = gra.builder.getJitInfo()->statsVerbose;
+  stats.spillCostCycles = (uint32_t)std::min<uint64_t>(spillCycles, UINT32_MAX);
+  stats.spillCostCyclesAvoided =
+      (uint32_t)std::min<uint64_t>(cyclesAvoided, UINT32_MAX);
+}
@@ -13,6 +13,7 @@ SPDX-License-Identifier: MIT
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 #ifdef _WIN32
 #include "Windows.h"
 #endif
@@ -153,8 +154,35 @@ int createNewTimer(const char *name) {
   return numTimers++;
 }
 
+void traceTimer(TimerID timerId, bool isStart) {
+  // The builder timers wrap every call that constructs the IR; as spans they
+  // would cost more than the work they measure.
+  if (timerId >= TimerID::VISA_BUILDER_APPEND_INST &&
+      timerId <= TimerID::VISA_BUILDER_IR_CONSTRUCTION)
+    return;
+  if (timerId >= TimerID::NUM_TIMERS)
+    return;
+  static const std::vector<vISA::trace::SpanID> spanIDs = [] {
+    std::vector<vISA::trace::SpanID> ids;
+    for (const char *name : timerNames) {
+      // The names are indented for dumpAllTimers; spans nest by themselves.
+      while (*name == '\t' || *name == ' ')
+        ++name;
+      ids.push_back(vISA::trace::intern(name, "visa"));
+    }
+    return ids;
+  }();
+  auto id = spanIDs[static_cast<int>(timerId)];
+  if (isStart)
+    vISA::trace::begin(id);
+  else
+    vISA::trace::end(id);
+}
+
 void startTimer(TimerID timerId) {
   [[maybe_unused]] int timer = static_cast<int>(timerId);
+  if (vISA::trace::isEnabled())
+    traceTimer(timerId, true);
 #ifdef MEASURE_COMPILATION_TIME
   if (timer < static_cast<int>(TimerID::NUM_TIMERS)) {
 #if defined(_DEBUG) && defined(CHECK_TIMER)
@@ -182,6 +210,8 @@ void startTimer(TimerID timerId) {
 
 void stopTimer(TimerID timerId) {
   [[maybe_unused]] int timer = static_cast<int>(timerId);
+  if (vISA::trace::isEnabled())
+    traceTimer(timerId, false);
 #ifdef MEASURE_COMPILATION_TIME
   if (timer < static_cast<int>(TimerID::NUM_TIMERS)) {
     LARGE_INTEGER stop;
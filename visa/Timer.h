@@ -15,6 +15,7 @@ SPDX-License-Identifier: MIT
 #define MEASURE_COMPILATION_TIME
 #endif
 
+#include "CompileTrace.h"
 #include "Option.h"
 
 // Timer library for the compiler
@@ -44,6 +45,8 @@ void stopTimer(TimerID timer);
 void dumpAllTimers(const char *asmFileName, bool outputTime = false);
 void dumpEncoderStats(Options *opt, std::string &asmName);
 void resetPerKernel();
+// Opens (isStart) or closes the compile trace span of a timer.
+void traceTimer(TimerID timer, bool isStart);
 // double getTimerUS(unsigned idx);
 
 struct TimerScope {
@@ -57,10 +60,26 @@ struct TimerScope {
   ~TimerScope() { stopTimer(timerId); }
 };
 
+// Without MEASURE_COMPILATION_TIME timers only feed the compile trace.
+struct TraceTimerScope {
+  const TimerID timerId;
+  TraceTimerScope(const TimerID _timerId) : timerId(_timerId) {
+    if (vISA::trace::isEnabled())
+      traceTimer(timerId, true);
+  }
+
+  TraceTimerScope(const TraceTimerScope&) = delete;
+  TraceTimerScope& operator=(const TraceTimerScope&) = delete;
+  ~TraceTimerScope() {
+    if (vISA::trace::isEnabled())
+      traceTimer(timerId, false);
+  }
+};
+
 #if defined(MEASURE_COMPILATION_TIME)
 #define TIME_SCOPE(TIMER_ID) TimerScope __timerScope(TimerID::TIMER_ID);
 #else
-#define TIME_SCOPE(TIMER_ID)
+#define TIME_SCOPE(TIMER_ID) TraceTimerScope __timerScope(TimerID::TIMER_ID);
 #endif
 
 #undef DEF_TIMER
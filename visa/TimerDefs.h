@@ -14,6 +14,11 @@ DEF_TIMER(OPTIMIZER, "Optimizer")
 DEF_TIMER(HW_CONFORMITY, "HW_Conformity")
 DEF_TIMER(MISC_OPTS, "Misc_opts")
 DEF_TIMER(SWSB, "\tSWSB")
+DEF_TIMER(SWSB_DEP_DISTANCE, "\t  SWSB_Dep_Distance")
+DEF_TIMER(SWSB_GLOBAL_ANALYSIS, "\t  SWSB_Global_Analysis")
+DEF_TIMER(SWSB_GLOBAL_DEPS, "\t  SWSB_Global_Deps")
+DEF_TIMER(SWSB_TOKEN_ALLOCATION, "\t  SWSB_Token_Allocation")
+DEF_TIMER(SWSB_SYNC_INSERTION, "\t  SWSB_Sync_Insertion")
 DEF_TIMER(TOTAL_RA, "Total_RA")
 DEF_TIMER(ADDR_FLAG_RA, "\tAddr_Flag_RA")
 DEF_TIMER(LOCAL_RA, "\tGRF_Local_RA")
@@ -21,9 +26,15 @@ DEF_TIMER(HYBRID_RA, "\tGRF_Hybrid_RA")
 DEF_TIMER(LINEARSCAN_RA, "\tGRF_LinearScan_RA")
 DEF_TIMER(GRF_GLOBAL_RA, "\tGRF_Global_RA")
 DEF_TIMER(INTERFERENCE, "\t  Interference")
+DEF_TIMER(INTERFERENCE_SETUP_LRS, "\t    Intf_Setup_LRs")
+DEF_TIMER(INTERFERENCE_BUILD, "\t    Intf_Build")
+DEF_TIMER(INTERFERENCE_MERGE, "\t      Intf_Merge")
+DEF_TIMER(INTERFERENCE_AUGMENT, "\t    Intf_Augmentation")
+DEF_TIMER(INTERFERENCE_SPARSE_GRAPH, "\t    Intf_Sparse_Graph")
 DEF_TIMER(COLORING, "\t  Graph Coloring")
 DEF_TIMER(SPILL, "\t  spill")
 DEF_TIMER(PRERA_SCHEDULING, "preRA_Scheduling")
+DEF_TIMER(GLOBAL_SCHEDULING, "Global_Scheduling")
 DEF_TIMER(SCHEDULING, "Scheduling")
 DEF_TIMER(ENCODE_AND_EMIT, "Encode+Emit")
 DEF_TIMER(ENCODE_COMPACTION, "\tCompaction")
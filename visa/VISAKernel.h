@@ -202,6 +202,7 @@ public:
   bool declExistsInCurrentScope(const std::string &name) const;
   bool setNameIndexMap(const std::string &name, CISA_GEN_VAR *,
                        bool unique = false);
+  void mapFragmentVarName(const char *name, CISA_GEN_VAR *decl);
   void pushIndexMapScopeLevel();
   void popIndexMapScopeLevel();
 
@@ -1434,6 +1435,8 @@ private:
   CISA_IR_Builder *const m_CISABuilder;
   vISA::IR_Builder *m_builder;
   vISA::Mem_Manager *m_kernelMem;
+  // Arena memory of this kernel, tracked only with -dumpArenaUsage
+  std::shared_ptr<vISA::ArenaUsage> m_arenaUsage;
   // customized allocator for allocating
   // It is very important that the same allocator is used by all instruction
   // lists that might be joined/spliced.
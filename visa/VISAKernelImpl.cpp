@@ -124,6 +124,7 @@ int VISAKernelImpl::calculateTotalInputSize() {
 
 int VISAKernelImpl::compileFastPath() {
   int status = VISA_SUCCESS;
+  vISA::ArenaUsage::Scope arenaUsageScope(m_arenaUsage);
 
   vISA_ASSERT_INPUT(
       (getIsKernel() || getIsPayload() ||
@@ -209,12 +210,13 @@ static void setDeclAlignment(G4_Declare *dcl, const IR_Builder &builder,
 
 void VISAKernelImpl::resetPostCompile() {
   // Skip CISA-level cleanup if the caller will still need the data after
-  // Compile() returns. isaDump() (driven by EmitZeBinVISASections in IGC, or
-  // -dumpcommonisa / -isaasmToConsole in standalone) iterates both
-  // m_instruction_list and m_var_info_list; debug info generation also needs
-  // these lists.
+  // Compile() returns. isaDump() (driven by -linkableVisa for
+  // EmitZeBinVISASections in IGC, or -dumpcommonisa / -isaasmToConsole in
+  // standalone) iterates both m_instruction_list and m_var_info_list; debug
+  // info generation also needs these lists.
   const bool needsCisaData =
       m_kernel->getOption(vISA_GenerateDebugInfo) ||
+      m_kernel->getOption(vISA_LinkableVISA) ||
       m_kernel->getOption(vISA_GenerateISAASM) ||
       m_kernel->getOption(vISA_GenerateCombinedISAASM) ||
       m_kernel->getOption(vISA_ISAASMToConsole);
@@ -314,6 +316,7 @@ void VISAKernelImpl::adjustIndirectCallOffset() {
 }
 
 void VISAKernelImpl::compilePostOptimize() {
+  vISA::ArenaUsage::Scope arenaUsageScope(m_arenaUsage);
 
   if (getOptions()->getOption(vISA_AddKernelID)) {
     // gt debugger requires a dummy mov as first
@@ -366,6 +369,9 @@ void *VISAKernelImpl::encodeAndEmit(unsigned int &binarySize) {
   //
   startTimer(TimerID::ENCODE_AND_EMIT);
   setCurrentDebugPass("encode");
+  vISA::ArenaUsage::Scope arenaUsageScope(m_arenaUsage);
+  if (m_arenaUsage)
+    m_arenaUsage->beginPhase("encode");
   if (m_builder->useIGAEncoder()) {
     auto r = EncodeKernelIGA(*m_kernel, m_asmName);
     binary = r.binary;
@@ -454,6 +460,13 @@ void *VISAKernelImpl::encodeAndEmit(unsigned int &binarySize) {
         << "  Kernel " << m_kernel->getName() << " : "
         << m_kernel->getAsmCount() << " asm instructions\n";
   }
+
+  if (m_arenaUsage) {
+    m_arenaUsage->endPhase();
+    // Like -dumpRPE, write to stderr: IGC does not print the critical
+    // messages of a successful compile.
+    m_arenaUsage->dump(std::cerr, m_kernel->getName());
+  }
   stopTimer(TimerID::ENCODE_AND_EMIT);
 
 #if defined(_DEBUG) && defined(_WIN32)
@@ -752,6 +765,9 @@ void VISAKernelImpl::recordFinalizerInfo() {
 }
 
 int VISAKernelImpl::InitializeFastPath() {
+  if (m_options->getOption(vISA_DumpArenaUsage))
+    m_arenaUsage = std::make_shared<vISA::ArenaUsage>();
+  vISA::ArenaUsage::Scope arenaUsageScope(m_arenaUsage);
   m_kernelMem = new vISA::Mem_Manager(4096);
 
   uint32_t funcId;
@@ -821,7 +837,8 @@ int VISAKernelImpl::CISABuildPreDefinedDecls() {
         std::string varName(getPredefinedVarString(predefId));
         std::string alias = "V" + std::to_string(i);
         decl->genVar.name_index = addStringPool(varName);
-        if (m_options->getOption(vISA_isParseMode)) {
+        if (m_options->getOption(vISA_isParseMode) ||
+            m_options->getOption(vISA_InlineVISAFragments)) {
           setNameIndexMap(alias, decl, true);
           setNameIndexMap(varName, decl, true);
         }
@@ -1012,7 +1029,9 @@ void VISAKernelImpl::ensureVariableNameUnique(const char *&varName) {
 // Return true if varName is updated to be an unique one.
 bool VISAKernelImpl::generateVariableName(Common_ISA_Var_Class Ty,
                                           const char *&varName) {
-  if (!m_options->getOption(vISA_GenerateISAASM) && !IsAsmWriterMode()) {
+  if (!m_options->getOption(vISA_GenerateISAASM) &&
+      !m_options->getOption(vISA_LinkableVISA) &&
+      !m_options->getOption(vISA_InlineVISAFragments) && !IsAsmWriterMode()) {
     // variable name is a don't care if we are not outputting vISA assembly
     return false;
   }
@@ -1115,6 +1134,7 @@ int VISAKernelImpl::CreateVISAGenVar(VISA_GenVar *&decl, const char *varName,
   }
 
   m_GenVarToNameMap[decl] = varName;
+  mapFragmentVarName(varName, decl);
 
   info->var_visa_type = (uint8_t)dataType;
   info->var_align = (uint8_t)varAlign;
@@ -1204,6 +1224,7 @@ int VISAKernelImpl::CreateVISAAddrVar(VISA_AddrVar *&decl, const char *varName,
   bool nameModified = generateVariableName(decl->type, varName);
 
   m_GenVarToNameMap[decl] = varName;
+  mapFragmentVarName(varName, decl);
 
   decl->index = m_addr_info_count++;
   if (IS_GEN_BOTH_PATH) {
@@ -1256,6 +1277,7 @@ int VISAKernelImpl::CreateVISAPredVar(VISA_PredVar *&decl, const char *varName,
   bool nameModified = generateVariableName(decl->type, varName);
 
   m_GenVarToNameMap[decl] = varName;
+  mapFragmentVarName(varName, decl);
 
   pred_info_t *pred = &decl->predVar;
 
@@ -1304,6 +1326,7 @@ int VISAKernelImpl::CreateStateVar(CISA_GEN_VAR *&decl,
   bool nameModified = generateVariableName(decl->type, varName);
 
   m_GenVarToNameMap[decl] = varName;
+  mapFragmentVarName(varName, decl);
 
   state_info_t *state = &decl->stateVar;
   state->attribute_capacity = 0;
@@ -9288,6 +9311,17 @@ bool VISAKernelImpl::setNameIndexMap(const std::string &name,
   return true;
 }
 
+// Variables created through the builder API are looked up by name when a
+// vISA fragment is parsed into this kernel. Names are already unique here,
+// and the parser records the variables it declares itself.
+void VISAKernelImpl::mapFragmentVarName(const char *name,
+                                        CISA_GEN_VAR *decl) {
+  if (!m_options->getOption(vISA_InlineVISAFragments) ||
+      m_options->getOption(vISA_isParseMode))
+    return;
+  setNameIndexMap(std::string(name), decl);
+}
+
 void VISAKernelImpl::pushIndexMapScopeLevel() {
   m_GenNamedVarMap.push_back(GenDeclNameToVarMap());
 }
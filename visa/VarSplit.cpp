@@ -318,12 +318,14 @@ bool LoopVarSplit::split(G4_Declare *dcl, Loop &loop) {
                           AugmentationMasks::Default64Bit;
 
   // emit TMP = dcl in preheader
-  copy(loop.preHeader, splitDcl, dcl, &splitData, isDefault32bMask, isDefault64bMask);
+  copy(coloring->getGRA(), references, loop.preHeader, splitDcl, dcl,
+       &splitData, isDefault32bMask, isDefault64bMask);
 
   // emit dcl = TMP in loop exit
   if (dsts.size() > 0) {
-    copy(loop.getLoopExits().front(), dcl, splitDcl, &splitData,
-         isDefault32bMask, isDefault64bMask, /*pushBack*/ false);
+    copy(coloring->getGRA(), references, loop.getLoopExits().front(), dcl,
+         splitDcl, &splitData, isDefault32bMask, isDefault64bMask,
+         /*pushBack*/ false);
   }
 
   // replace all occurences of dcl in loop with TMP
@@ -338,7 +340,8 @@ bool LoopVarSplit::split(G4_Declare *dcl, Loop &loop) {
   return true;
 }
 
-void LoopVarSplit::copy(G4_BB *bb, G4_Declare *dst, G4_Declare *src,
+void LoopVarSplit::copy(GlobalRA &gra, VarReferences &references, G4_BB *bb,
+                        G4_Declare *dst, G4_Declare *src,
                         SplitResults *splitData, bool isDefault32bMask,
                         bool isDefault64bMask, bool pushBack) {
   // create mov instruction to copy dst->src
@@ -347,18 +350,19 @@ void LoopVarSplit::copy(G4_BB *bb, G4_Declare *dst, G4_Declare *src,
   // when pushBack argument = true, append to BB (happens in pre-header)
   // when pushBack argument = false, insert in bb after label (happens at exit
   // bb)
+  // splitData may be null when the copies need not be tracked
 
+  G4_Kernel &kernel = gra.kernel;
   dst = dst->getRootDeclare();
   src = src->getRootDeclare();
   unsigned int numRows = dst->getNumRows();
   unsigned int bytesRemaining = dst->getByteSize();
   unsigned int maxDstSize =
-      coloring->getGRA().use4GRFAlign && isDefault64bMask ? 4 : 2;
+      gra.use4GRFAlign && isDefault64bMask ? 4 : 2;
 
   auto insertCopy = [&](G4_INST *inst) {
     if (pushBack || bb->size() == 0) {
       bb->push_back(inst);
-      splitData->insts[bb].insert(inst);
     } else {
       if (bb->front()->isLabel()) {
         auto insertAfterIt = bb->begin();
@@ -373,12 +377,12 @@ void LoopVarSplit::copy(G4_BB *bb, G4_Declare *dst, G4_Declare *src,
                     "shouldnt insert copy before join");
         bb->push_front(inst);
       }
-
-      splitData->insts[bb].insert(inst);
     }
+    if (splitData)
+      splitData->insts[bb].insert(inst);
     if (inst->isWriteEnableInst() &&
-        coloring->getGRA().EUFusionNoMaskWANeeded()) {
-      coloring->getGRA().addEUFusionNoMaskWAInst(bb, inst);
+        gra.EUFusionNoMaskWANeeded()) {
+      gra.addEUFusionNoMaskWAInst(bb, inst);
     }
   };
 
@@ -782,4 +786,162 @@ void LoopVarSplit::adjustLoopMaxPressure(Loop &loop, unsigned int numRows) {
   }
 }
 
+LoopBoundarySplit::LoopBoundarySplit(GlobalRA &g, GraphColor &c,
+                                     const LivenessAnalysis &liveAnalysis,
+                                     RPE &r)
+    : gra(g), kernel(g.kernel), coloring(c), liveness(liveAnalysis), rpe(r),
+      references(g.kernel) {}
+
+void LoopBoundarySplit::run() {
+  std::vector<G4_Declare *> candidates;
+  for (auto lr : coloring.getSpilledLiveRanges()) {
+    auto dcl = lr->getDcl();
+    if (dcl->getAddressed() || lr->getIsPartialDcl() ||
+        lr->getIsSplittedDcl() || lr->getSpillCost() == MAXSPILLCOST ||
+        gra.splitResults.count(dcl))
+      continue;
+    candidates.push_back(dcl);
+  }
+  if (candidates.empty())
+    return;
+
+  collectRefBBs(std::unordered_set<G4_Declare *>(candidates.begin(),
+                                                 candidates.end()));
+
+  const auto &topLoops = kernel.fg.getLoops().getTopLoops();
+  for (auto dcl : candidates)
+    splitAroundLoops(dcl, topLoops);
+}
+
+void LoopBoundarySplit::collectRefBBs(
+    const std::unordered_set<G4_Declare *> &candidates) {
+  for (auto bb : kernel.fg) {
+    for (auto inst : *bb) {
+      for (unsigned int i = 0; i != Opnd_total_num; ++i) {
+        auto opnd = inst->getOperand((Gen4_Operand_Number)i);
+        if (!opnd || !opnd->getTopDcl())
+          continue;
+        auto rootDcl = opnd->getTopDcl()->getRootDeclare();
+        if (candidates.count(rootDcl))
+          refBBs[rootDcl].insert(bb);
+      }
+    }
+  }
+}
+
+bool LoopBoundarySplit::isHotLoop(Loop &loop) {
+  auto it = hotLoopCache.find(&loop);
+  if (it != hotLoopCache.end())
+    return it->second;
+
+  unsigned int maxRP = 0;
+  for (auto bb : loop.getBBs()) {
+    for (auto inst : *bb)
+      maxRP = std::max(maxRP, rpe.getRegisterPressure(inst));
+  }
+  bool isHot =
+      maxRP >= (unsigned int)(cHotLoopRatio * (float)kernel.getNumRegTotal());
+  hotLoopCache[&loop] = isHot;
+  return isHot;
+}
+
+bool LoopBoundarySplit::canSplitAround(G4_Declare *dcl, Loop &loop) {
+  if (!isHotLoop(loop))
+    return false;
+
+  // cannot split without pre-header, and unsafe to split if loop has
+  // subroutine calls. copies are appended to the pre-header so it must
+  // fall through to the loop.
+  if (!loop.preHeader || loop.subCalls ||
+      (!loop.preHeader->empty() && loop.preHeader->back()->isFlowControl()))
+    return false;
+
+  // copies back are inserted at the top of the only exit, which must run
+  // exactly once per run of the pre-header and not be part of another loop.
+  if (loop.getLoopExits().size() != 1)
+    return false;
+  G4_BB *exit = loop.getLoopExits().front();
+  if (!loop.preHeader->dominates(exit) ||
+      kernel.fg.getLoops().getInnerMostLoop(exit) != loop.parent)
+    return false;
+  for (auto pred : exit->Preds) {
+    if (!loop.contains(pred))
+      return false;
+  }
+  auto instIt = exit->begin();
+  if (instIt != exit->end() && (*instIt)->isLabel())
+    ++instIt;
+  if (instIt != exit->end() && (*instIt)->isFlowControl() &&
+      (*instIt)->opcode() != G4_join)
+    return false;
+
+  for (auto bb : refBBs[dcl]) {
+    if (loop.contains(bb))
+      return false;
+  }
+
+  auto varId = dcl->getRegVar()->getId();
+  return liveness.isLiveAtEntry(loop.getHeader(), varId) &&
+         liveness.isLiveAtEntry(exit, varId);
+}
+
+void LoopBoundarySplit::splitAroundLoops(G4_Declare *dcl,
+                                         const std::vector<Loop *> &loops) {
+  // split around the outermost loops possible. loops nested in one that
+  // dcl is split around are already free of it.
+  for (auto loop : loops) {
+    if (canSplitAround(dcl, *loop))
+      split(dcl, *loop);
+    else
+      splitAroundLoops(dcl, loop->immNested);
+  }
+}
+
+void LoopBoundarySplit::split(G4_Declare *dcl, Loop &loop) {
+  // Emits:
+  //
+  // preheader:
+  //   pseudo_kill LOOPTHRU
+  //   LOOPTHRU = dcl
+  // loop:
+  //   ...
+  // exit:
+  //   pseudo_kill dcl
+  //   dcl = LOOPTHRU
+  //
+  // The kills end both ranges at the copies even when the copies don't use
+  // NoMask.
+  auto builder = kernel.fg.builder;
+  auto thruDcl = builder->createTempVar(dcl->getTotalElems(),
+                                        dcl->getElemType(),
+                                        gra.getSubRegAlign(dcl), "LOOPTHRU",
+                                        true);
+  gra.incRA.markForIntfUpdate(dcl);
+  gra.incRA.markForIntfUpdate(thruDcl);
+
+  bool isDefault32bMask =
+      gra.getAugmentationMask(dcl) == AugmentationMasks::Default32Bit;
+  bool isDefault64bMask =
+      gra.getAugmentationMask(dcl) == AugmentationMasks::Default64Bit;
+
+  loop.preHeader->push_back(
+      builder->createPseudoKill(thruDcl, PseudoKillType::Other, false));
+  LoopVarSplit::copy(gra, references, loop.preHeader, thruDcl, dcl, nullptr,
+                     isDefault32bMask, isDefault64bMask);
+
+  G4_BB *exit = loop.getLoopExits().front();
+  LoopVarSplit::copy(gra, references, exit, dcl, thruDcl, nullptr,
+                     isDefault32bMask, isDefault64bMask, /*pushBack*/ false);
+  auto insertIt = exit->begin();
+  if ((*insertIt)->isLabel()) {
+    ++insertIt;
+    if (insertIt != exit->end() && (*insertIt)->opcode() == G4_join)
+      ++insertIt;
+  }
+  exit->insertBefore(
+      insertIt, builder->createPseudoKill(dcl, PseudoKillType::Other, false));
+
+  numSplits++;
+}
+
 }; // namespace vISA
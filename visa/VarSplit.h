@@ -60,14 +60,15 @@ public:
                                  INST_LIST_ITER filledInstIter);
   static const std::unordered_set<G4_INST *> getSplitInsts(GlobalRA *gra,
                                                            G4_BB *bb);
+  static void copy(GlobalRA &gra, VarReferences &references, G4_BB *bb,
+                   G4_Declare *dst, G4_Declare *src, SplitResults *splitData,
+                   bool isDefault32bMask, bool isDefault64bMask,
+                   bool pushBack = true);
 
 private:
   const unsigned int cLargeLoop = 500;
 
   bool split(G4_Declare *dcl, Loop &loop);
-  void copy(G4_BB *bb, G4_Declare *dst, G4_Declare *src,
-            SplitResults *splitData, bool isDefault32bMask,
-            bool isDefault64bMask, bool pushBack = true);
   void replaceSrc(G4_SrcRegRegion *src, G4_Declare *dcl, const Loop &loop);
   void replaceDst(G4_DstRegRegion *dst, G4_Declare *dcl, const Loop &loop);
   G4_Declare *getNewDcl(G4_Declare *dcl1, G4_Declare *dcl2, const Loop &loop);
@@ -128,6 +129,51 @@ private:
   }
 };
 
+// LoopVarSplit only splits a spilled variable around loops that reference it.
+// A variable that is live through a loop but unused in it still ends up in
+// memory across its whole range. This pass splits such variables at the
+// boundaries of loops whose register pressure is high: the variable is copied
+// to a LOOPTHRU temp in the preheader and back at the single loop exit. Only
+// the temp is live through the loop, and having just these two references it
+// is cheap to spill. RA is rerun afterwards so that the spill decision is made
+// on the split ranges.
+//
+// Unlike LoopVarSplit temps, LOOPTHRU temps are not recorded in
+// GlobalRA::splitResults. The original variable may well be allocated in the
+// rerun, so the temp cannot share its spill location and the copies must stay.
+class LoopBoundarySplit {
+public:
+  LoopBoundarySplit(GlobalRA &g, GraphColor &c,
+                    const LivenessAnalysis &liveAnalysis, RPE &r);
+  LoopBoundarySplit(const LoopBoundarySplit &) = delete;
+  LoopBoundarySplit &operator=(const LoopBoundarySplit &) = delete;
+
+  void run();
+  unsigned int getNumSplits() const { return numSplits; }
+
+private:
+  // Loops whose max pressure is at least this fraction of the GRF file
+  const float cHotLoopRatio = 0.9f;
+
+  void collectRefBBs(const std::unordered_set<G4_Declare *> &candidates);
+  bool isHotLoop(Loop &loop);
+  bool canSplitAround(G4_Declare *dcl, Loop &loop);
+  void splitAroundLoops(G4_Declare *dcl, const std::vector<Loop *> &loops);
+  void split(G4_Declare *dcl, Loop &loop);
+
+  GlobalRA &gra;
+  G4_Kernel &kernel;
+  GraphColor &coloring;
+  const LivenessAnalysis &liveness;
+  RPE &rpe;
+  VarReferences references;
+
+  // BBs that reference each candidate, through any of its aliases
+  std::unordered_map<G4_Declare *, std::unordered_set<G4_BB *>> refBBs;
+  std::unordered_map<Loop *, bool> hotLoopCache;
+  unsigned int numSplits = 0;
+};
+
 class VarProperties {
 public:
   enum class AccessGranularity { OneGrf = 1, TwoGrf = 2, Unknown = 3 };
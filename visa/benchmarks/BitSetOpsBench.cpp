@@ -0,0 +1,158 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// Measures the BitSetOps kernels of every ISA the host supports on data shaped
+// like RA liveness: a backward use/def dataflow over a CFG with mostly
+// fall-through edges and some loops, where each BB references variables that
+// are close to it in program order, plus a few globals.
+//
+// Usage: BitSetOpsBench [-vars N] [-bbs N] [-reps N]
+
+#include "BitSetOps.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace vISA;
+
+namespace {
+
+using Word = uint32_t;
+constexpr unsigned BitsPerWord = sizeof(Word) * 8;
+
+struct Liveness {
+  unsigned numWords = 0;
+  std::vector<std::vector<unsigned>> succs;
+  std::vector<std::vector<Word>> gen, kill;
+};
+
+void setBit(std::vector<Word> &set, unsigned bit) {
+  set[bit / BitsPerWord] |= Word(1) << (bit % BitsPerWord);
+}
+
+Liveness makeLiveness(unsigned numVars, unsigned numBBs) {
+  std::mt19937 rng(42);
+  Liveness l;
+  l.numWords = (numVars + BitsPerWord - 1) / BitsPerWord;
+  l.succs.resize(numBBs);
+  l.gen.assign(numBBs, std::vector<Word>(l.numWords));
+  l.kill.assign(numBBs, std::vector<Word>(l.numWords));
+
+  const unsigned numGlobals = numVars / 32;
+  const unsigned window = std::max(64u, numVars / 16);
+  for (unsigned bb = 0; bb < numBBs; ++bb) {
+    if (bb + 1 < numBBs)
+      l.succs[bb].push_back(bb + 1);
+    // One in eight BBs closes a loop, one in eight branches forward.
+    if (bb > 0 && rng() % 8 == 0)
+      l.succs[bb].push_back(bb - 1 - rng() % std::min(bb, 32u));
+    else if (bb + 2 < numBBs && rng() % 8 == 0)
+      l.succs[bb].push_back(bb + 2 + rng() % std::min(numBBs - bb - 2, 16u));
+
+    const unsigned center =
+        numGlobals + (uint64_t)(numVars - numGlobals) * bb / numBBs;
+    for (unsigned i = 0; i < 24; ++i) {
+      unsigned var = center + rng() % window;
+      if (var >= numVars)
+        var = numGlobals + rng() % (numVars - numGlobals);
+      setBit(rng() % 2 ? l.gen[bb] : l.kill[bb], var);
+    }
+    setBit(l.gen[bb], rng() % numGlobals);
+  }
+  return l;
+}
+
+// Iterates use_in = gen | (use_out & ~kill), use_out = U use_in(succ) to a
+// fixed point, and returns the number of iterations.
+unsigned solve(const Liveness &l, std::vector<std::vector<Word>> &useIn) {
+  const unsigned numBBs = (unsigned)l.succs.size();
+  useIn.assign(numBBs, std::vector<Word>(l.numWords));
+  std::vector<Word> useOut(l.numWords);
+  unsigned iterations = 0;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    ++iterations;
+    for (unsigned bb = numBBs; bb-- > 0;) {
+      std::fill(useOut.begin(), useOut.end(), 0);
+      for (unsigned succ : l.succs[bb])
+        BitSetOps::unionWith(useOut.data(), useIn[succ].data(), l.numWords);
+      BitSetOps::intersectWithComplement(useOut.data(), l.kill[bb].data(),
+                                         l.numWords);
+      BitSetOps::unionWith(useOut.data(), l.gen[bb].data(), l.numWords);
+      changed |= BitSetOps::unionWith(useIn[bb].data(), useOut.data(),
+                                      l.numWords);
+    }
+  }
+  return iterations;
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  unsigned numVars = 32768, numBBs = 2000, reps = 5;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    unsigned value = (unsigned)strtoul(argv[i + 1], nullptr, 0);
+    if (!strcmp(argv[i], "-vars"))
+      numVars = std::max(value, 1024u);
+    else if (!strcmp(argv[i], "-bbs"))
+      numBBs = std::max(value, 2u);
+    else if (!strcmp(argv[i], "-reps"))
+      reps = std::max(value, 1u);
+    else {
+      fprintf(stderr, "usage: %s [-vars N] [-bbs N] [-reps N]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  const Liveness l = makeLiveness(numVars, numBBs);
+  printf("liveness: %u vars, %u BBs, host ISA %s\n", numVars, numBBs,
+         BitSetOps::getISAName(BitSetOps::getHostISA()));
+
+  std::vector<std::vector<Word>> reference;
+  double scalarMs = 0;
+  for (BitSetOps::ISA isa : {BitSetOps::ISA::Scalar, BitSetOps::ISA::AVX2,
+                             BitSetOps::ISA::AVX512}) {
+    if (static_cast<int>(isa) > static_cast<int>(BitSetOps::getHostISA()))
+      break;
+    BitSetOps::setISA(isa);
+
+    std::vector<std::vector<Word>> useIn;
+    unsigned iterations = 0;
+    double bestMs = 0;
+    for (unsigned r = 0; r < reps; ++r) {
+      auto start = std::chrono::steady_clock::now();
+      iterations = solve(l, useIn);
+      double ms = elapsedMs(start);
+      bestMs = r == 0 ? ms : std::min(bestMs, ms);
+    }
+
+    if (isa == BitSetOps::ISA::Scalar) {
+      reference = useIn;
+      scalarMs = bestMs;
+    } else if (useIn != reference) {
+      fprintf(stderr, "%s result differs from scalar\n",
+              BitSetOps::getISAName(isa));
+      return 1;
+    }
+    printf("  %-8s %4u iterations %10.3f ms  %5.2fx\n",
+           BitSetOps::getISAName(isa), iterations, bestMs, scalarMs / bestMs);
+  }
+  return 0;
+}
@@ -8,6 +8,9 @@ SPDX-License-Identifier: MIT
 
 #include "common/ged_int_utils.h"
 #include "common/ged_base.h"
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 static const uint64_t maxValues[] =
 {
@@ -128,3 +131,17 @@ const uint32_t& BitsToNumOfValues(const uint8_t size)
     GEDASSERT(GED_DWORD_BITS > size);
     return numOfValues[size];
 }
+
+
+uint32_t LowestSetBit(const uint64_t val)
+{
+    GEDASSERT(0 != val);
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    if (_BitScanForward(&index, (unsigned long)val)) return (uint32_t)index;
+    _BitScanForward(&index, (unsigned long)(val >> GED_DWORD_BITS));
+    return (uint32_t)index + GED_DWORD_BITS;
+#else
+    return (uint32_t)__builtin_ctzll(val);
+#endif
+}
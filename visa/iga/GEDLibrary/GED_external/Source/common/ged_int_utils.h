@@ -33,4 +33,14 @@ extern const uint64_t& BitsToMaxValue(const uint8_t size);
  */
 extern const uint32_t& BitsToNumOfValues(const uint8_t size);
 
+
+/*!
+ * Get the index of the lowest set bit of the given non-zero qword.
+ *
+ * @param[in]   val     The value, which must not be zero.
+ *
+ * @return      The index of the lowest set bit.
+ */
+extern uint32_t LowestSetBit(const uint64_t val);
+
 #endif // GED_INT_UTILS_H
@@ -1502,11 +1502,19 @@ bool GEDIns::FindCompactionTableEntry(uint64_t& val, const uint64_t& valMask, co
     GEDASSERT(0 != tableSize);
     GEDASSERT(tableSize < GED_MAX_ENTRIES_IN_COMPACT_TABLE); // sanity check
     val |= valMask;
-    for (uint32_t i = 0; i < tableSize; ++i)
+    // Compare up to 64 entries at a time into a match mask. The inner loop has no early exit, so the compiler can vectorize it;
+    // the lowest set bit is the first matching entry, as with a plain linear search.
+    for (uint32_t base = 0; base < tableSize; base += 64)
     {
-        if ((table[i] | valMask) == val)
+        const uint32_t chunkSize = (tableSize - base < 64) ? (tableSize - base) : 64;
+        uint64_t matches = 0;
+        for (uint32_t i = 0; i < chunkSize; ++i)
+        {
+            matches |= (uint64_t)((table[base + i] | valMask) == val) << i;
+        }
+        if (0 != matches)
         {
-            val = i;
+            val = base + LowestSetBit(matches);
             return true;
         }
     }
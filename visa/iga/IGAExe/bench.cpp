@@ -0,0 +1,156 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "iga_main.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+// counts the instructions in a kernel binary; bit 29 of the first dword
+// is the compaction control bit on all supported platforms
+static size_t countInstructions(const unsigned char *bits, size_t bitsLen) {
+  size_t n = 0;
+  for (size_t off = 0; off + 8 <= bitsLen; n++) {
+    uint32_t dw0;
+    memcpy(&dw0, bits + off, sizeof(dw0));
+    off += (dw0 & (1u << 29)) ? 8 : 16;
+  }
+  return n;
+}
+
+static void reportThroughput(const std::string &inpFile, const char *what,
+                             size_t numInsts, uint32_t iterations,
+                             double seconds) {
+  double instsPerSec = seconds > 0.0 ? numInsts * iterations / seconds : 0.0;
+  std::cout << inpFile << ": " << what << " " << numInsts << " instructions "
+            << iterations << " times in " << std::fixed
+            << std::setprecision(3) << seconds << " s ("
+            << std::setprecision(0) << instsPerSec << " instructions/s)\n";
+}
+
+static bool benchmarkAssemble(const Opts &opts, igax::Context &ctx,
+                              const std::string &inpFile) {
+  std::string inpText = readTextFile(inpFile.c_str());
+
+  // the first run reports any errors and sizes the kernel
+  igax::Bits bits;
+  if (!assemble(opts, ctx, inpFile, inpText, bits))
+    return false;
+  size_t numInsts = countInstructions(bits.data(), bits.size());
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < opts.benchIterations; i++) {
+    if (!assemble(opts, ctx, inpFile, inpText, bits))
+      return false;
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  reportThroughput(inpFile, "assembled", numInsts, opts.benchIterations,
+                   elapsed.count());
+  return true;
+}
+
+// Compares full disassembly to text against the record decode that
+// profilers use, both serially and with a kernel per thread.
+static bool benchmarkDisassemble(const Opts &opts, igax::Context &ctx,
+                                 const std::string &inpFile) {
+  std::vector<unsigned char> inp;
+  readBinaryFile(inpFile.c_str(), inp);
+  const uint32_t inpSize = (uint32_t)inp.size();
+
+  uint32_t numRecords = 0;
+  iga_status_t st =
+      iga_decode_records(opts.platform, inp.data(), inpSize, nullptr,
+                         &numRecords);
+  if (st != IGA_SUCCESS && st != IGA_OUT_OF_MEM) {
+    std::cerr << inpFile << ": iga_decode_records: "
+              << iga_status_to_string(st) << "\n";
+    return false;
+  }
+  std::vector<iga_inst_record_t> records(numRecords);
+  st = iga_decode_records(opts.platform, inp.data(), inpSize, records.data(),
+                          &numRecords);
+  if (st != IGA_SUCCESS) {
+    std::cerr << inpFile << ": iga_decode_records: "
+              << iga_status_to_string(st) << "\n";
+    return false;
+  }
+
+  iga_disassemble_options_t dopts = IGA_DISASSEMBLE_OPTIONS_INIT();
+  dopts.formatting_opts = makeFormattingOpts(opts);
+  setOptBit(dopts.decoder_opts, IGA_DECODING_OPT_NATIVE, opts.useNativeEncoder);
+  try {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < opts.benchIterations; i++)
+      (void)ctx.disassembleToString(inp.data(), inp.size(), dopts);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    reportThroughput(inpFile, "disassembled", numRecords,
+                     opts.benchIterations, elapsed.count());
+  } catch (const igax::Error &err) {
+    err.emit(std::cerr);
+    std::cerr << "\n";
+    return false;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < opts.benchIterations; i++) {
+    uint32_t n = numRecords;
+    (void)iga_decode_records(opts.platform, inp.data(), inpSize,
+                             records.data(), &n);
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  reportThroughput(inpFile, "decoded records for", numRecords,
+                   opts.benchIterations, elapsed.count());
+
+  // each thread decodes the whole kernel into its own records
+  const uint32_t numThreads =
+      std::max(1u, std::min(std::thread::hardware_concurrency(),
+                            opts.benchIterations));
+  std::atomic<uint32_t> nextIteration(0);
+  std::vector<std::thread> threads;
+  start = std::chrono::steady_clock::now();
+  for (uint32_t t = 0; t < numThreads; t++) {
+    threads.emplace_back([&]() {
+      std::vector<iga_inst_record_t> threadRecords(numRecords);
+      while (nextIteration++ < opts.benchIterations) {
+        uint32_t n = numRecords;
+        (void)iga_decode_records(opts.platform, inp.data(), inpSize,
+                                 threadRecords.data(), &n);
+      }
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+  elapsed = std::chrono::steady_clock::now() - start;
+  std::string what =
+      "decoded records (" + std::to_string(numThreads) + " threads) for";
+  reportThroughput(inpFile, what.c_str(), numRecords, opts.benchIterations,
+                   elapsed.count());
+  return true;
+}
+
+bool benchmark(const Opts &opts, igax::Context &ctx,
+               const std::string &inpFile) {
+  if (inpFile == IGA_STDIN_FILENAME) {
+    fatalExitWithMessage("-Xbench: input must be a file");
+  }
+  if (opts.mode == Opts::Mode::ASM) {
+    return benchmarkAssemble(opts, ctx, inpFile);
+  } else if (opts.mode == Opts::Mode::DIS) {
+    return benchmarkDisassemble(opts, ctx, inpFile);
+  }
+  fatalExitWithMessage(inpFile, ": -Xbench requires -a or -d");
+}
@@ -253,6 +253,21 @@ extern "C" int iga_main(int argc, const char **argv) {
       "has a Compacted or NoCompact annotation, IGA respects that unless "
       "the compacted form does not exist.",
       opts::OptAttrs::ALLOW_UNSET, baseOpts.autoCompact);
+  xGrp.defineOpt(
+      "bench", nullptr, "INT", "times assembly or disassembly of each input",
+      "Assembles (-a) or disassembles (-d) each input file the given number "
+      "of times and reports the throughput in instructions per second "
+      "instead of writing output.  Disassembly is timed both to text and "
+      "with iga_decode_records, serially and on all hardware threads.  "
+      "The input should be a large real kernel (e.g. one dumped by the "
+      "compiler) so that the encoder or decoder, not setup, dominates.",
+      opts::OptAttrs::ALLOW_UNSET,
+      [](const char *cinp, const opts::ErrorHandler &eh, Opts &baseOpts) {
+        int n = eh.parseInt(cinp);
+        if (n <= 0)
+          eh("iteration count must be positive");
+        baseOpts.benchIterations = (uint32_t)n;
+      });
   xGrp.defineFlag("force-no-compact", nullptr,
                   "forcely uncompact any instruction",
                   "Forcely un-compact any instruction even if 'Compacted' is "
@@ -520,7 +535,9 @@ extern "C" int iga_main(int argc, const char **argv) {
       struct Opts opts = optsForFile(inpFile);
       try {
         igax::Context ctx(opts.platform);
-        if (opts.mode == Opts::Mode::DIS) {
+        if (opts.benchIterations > 0) {
+          hasError |= !benchmark(opts, ctx, inpFile);
+        } else if (opts.mode == Opts::Mode::DIS) {
           hasError |= !disassemble(opts, ctx, inpFile);
         } else if (opts.mode == Opts::Mode::ASM) {
           hasError |= !assemble(opts, ctx, inpFile);
@@ -60,6 +60,7 @@ struct Opts {
   bool useNativeEncoder = false;                   // -Xnative
   bool forceNoCompact = false;                     // -Xforce-no-compact
   uint32_t pcOffset = 0; // pcOffset provided with -Xset-pc-base
+  uint32_t benchIterations = 0; // -Xbench
 
   bool printBits = false;          // -Xprint-bits
   bool printDefs = false;          // -Xprint-defs
@@ -85,6 +86,8 @@ bool debugCompaction(Opts opts); // -Xdcmp in decode_fields.cpp
 bool listOps(const Opts &opts,
              const std::string &opmn);       // -Xlist-ops: list_ops.cpp
 bool decodeSendDescriptor(const Opts &opts); // -Xsds in decode_message.cpp
+bool benchmark(const Opts &opts, igax::Context &ctx,
+               const std::string &inpFile); // -Xbench in bench.cpp
 
 static inline void setOptBit(uint32_t &opts, uint32_t bit, bool isSet) {
   if (isSet) {
@@ -98,6 +98,7 @@ void Encoder::encodeKernel(Kernel &k, MemManager &mem, void *&bits,
 
     encodeKernelPreProcess(k);
     m_needToPatch.clear();
+    m_prepassBits.clear();
     m_mem = &mem;
     m_numberInstructionsEncoded = k.getInstructionCount();
     size_t allocLen = m_numberInstructionsEncoded * UNCOMPACTED_SIZE;
@@ -108,6 +109,7 @@ void Encoder::encodeKernel(Kernel &k, MemManager &mem, void *&bits,
       fatalAtT(0, "failed to allocate memory for kernel binary");
       return;
     }
+    m_instBufLen = allocLen;
 
     const BlockList &blockList = k.getBlockList();
 
@@ -146,6 +148,86 @@ void Encoder::encodeKernel(Kernel &k, MemManager &mem, void *&bits,
 #endif
 }
 
+void Encoder::beginStream(MemManager &mem, size_t maxInsts) {
+  initIGATimer();
+  setIGAKernelName("test");
+  IGA_ASSERT(!m_opts.autoDepSet && !m_opts.compactRestrict,
+             "streaming encoder needs the whole kernel for this option");
+
+  m_needToPatch.clear();
+  m_prepassBits.clear();
+  m_blockToOffsetMap.clear();
+  m_mem = &mem;
+  m_numberInstructionsEncoded = 0;
+  m_instBufLen = maxInsts * UNCOMPACTED_SIZE;
+  if (m_instBufLen == 0) // for empty kernel case
+    m_instBufLen = 4;
+  m_instBuf = (uint8_t *)mem.alloc(m_instBufLen);
+#ifndef IGA_DISABLE_ENCODER_EXCEPTIONS
+  try {
+#endif
+    if (!m_instBuf)
+      fatalAtT(0, "failed to allocate memory for kernel binary");
+#ifndef IGA_DISABLE_ENCODER_EXCEPTIONS
+  } catch (const iga::FatalError &) {
+    // error is already reported
+  }
+#endif
+}
+
+void Encoder::beginStreamBlock(const Block *blk) {
+  m_blockToOffsetMap[blk] = currentPc();
+}
+
+void Encoder::encodeStreamInstruction(Kernel &k, Instruction *inst) {
+#ifndef IGA_DISABLE_ENCODER_EXCEPTIONS
+  try {
+#endif
+    if (!m_instBuf || hasFatalError())
+      return;
+    // CACHELINEALIGN pads with at most two sync.nop
+    size_t maxLen = inst->hasInstOpt(InstOpt::CACHELINEALIGN)
+                        ? 3 * UNCOMPACTED_SIZE
+                        : UNCOMPACTED_SIZE;
+    if (currentPc() + maxLen > m_instBufLen) {
+      fatalAtT(inst->getLoc(), "kernel binary exceeds the instruction bound");
+      return;
+    }
+    START_ENCODER_TIMER();
+    encodeInstructionAt(k, inst, nullptr, InstList::iterator());
+    STOP_ENCODER_TIMER();
+    m_numberInstructionsEncoded++;
+#ifndef IGA_DISABLE_ENCODER_EXCEPTIONS
+  } catch (const iga::FatalError &) {
+    // error is already reported
+  }
+#endif
+}
+
+void Encoder::endStream(Kernel &k, void *&bits, uint32_t &bitsLen) {
+#ifndef IGA_DISABLE_ENCODER_EXCEPTIONS
+  try {
+#endif
+    if (!m_instBuf || hasFatalError())
+      return;
+    START_ENCODER_TIMER();
+    patchJumpOffsets();
+    STOP_ENCODER_TIMER();
+
+    bitsLen = currentPc();
+    bits = m_instBuf;
+
+    applyGedWorkarounds(k, currentPc());
+
+    // clear any padding
+    memset(m_instBuf + bitsLen, 0, m_instBufLen - bitsLen);
+#ifndef IGA_DISABLE_ENCODER_EXCEPTIONS
+  } catch (const iga::FatalError &) {
+    // error is already reported
+  }
+#endif
+}
+
 // compactRestrictPrepass — dry-run pass that decides which instructions to
 // force to native (16b) form before any bytes are written to the output buffer.
 //
@@ -154,10 +236,11 @@ void Encoder::encodeKernel(Kernel &k, MemManager &mem, void *&bits,
 // the hypothetical output size.  Whenever a 16b instruction would straddle a
 // 64B cacheline boundary, the prepass searches backward for the most recent
 // compact instruction and marks it {NoCompact}.  The simulated PC is adjusted
-// by +8 to account for the growth.  Because the real encoding pass will
-// re-derive all GED fields from the IGA instruction object and call
-// GED_EncodeIns(NATIVE) directly, there is no compact→native decode round-trip
-// and no platform-specific uncompaction safety check is needed.
+// by +8 to account for the growth.  A forced-native instruction is re-encoded
+// from the IGA instruction object by the real encoding pass, so there is no
+// compact→native decode round-trip and no platform-specific uncompaction
+// safety check is needed.  Every other instruction keeps the bits encoded
+// here (see emitPrepassBits).
 void Encoder::compactRestrictPrepass(const BlockList &blockList) {
   // Nothing will be compacted, skip this pass
   if(m_opts.forceNoCompact)
@@ -173,8 +256,7 @@ void Encoder::compactRestrictPrepass(const BlockList &blockList) {
   std::vector<Entry> history;
   history.reserve(128);
 
-  // Scratch buffer for the compact-probe encode
-  uint8_t scratchBuf[UNCOMPACTED_SIZE];
+  m_prepassBits.reserve(m_numberInstructionsEncoded);
 
   int32_t simPc = 0; // simulated output PC, tracks hypothetical instruction positions
 
@@ -200,17 +282,24 @@ void Encoder::compactRestrictPrepass(const BlockList &blockList) {
         size_t savedNTP = m_needToPatch.size();
         setCurrInst(inst);
         encodeInstruction(*inst);
-        if (m_needToPatch.size() > savedNTP)
+        bool needsPatch = m_needToPatch.size() > savedNTP;
+        if (needsPatch)
           m_needToPatch.erase(m_needToPatch.begin() + savedNTP,
                               m_needToPatch.end());
         if (hasFatalError())
           return;
 
-        // Probe compact encoding; only the return value matters.
-        if (GED_EncodeIns(&m_gedInst, GED_INS_TYPE_COMPACT, scratchBuf) ==
-            GED_RETURN_VALUE_SUCCESS) {
-          couldCompact = true;
-        }
+        // Probe compact encoding.  Keep whichever form succeeds so that
+        // encodeBlock need not encode the instruction a second time.
+        PrepassBits pb;
+        GED_RETURN_VALUE status =
+            GED_EncodeIns(&m_gedInst, GED_INS_TYPE_COMPACT, pb.bits);
+        couldCompact = status == GED_RETURN_VALUE_SUCCESS;
+        pb.compacted = couldCompact;
+        if (!couldCompact)
+          status = GED_EncodeIns(&m_gedInst, GED_INS_TYPE_NATIVE, pb.bits);
+        if (!needsPatch && status == GED_RETURN_VALUE_SUCCESS)
+          m_prepassBits.emplace(inst, pb);
       }
 
       int32_t size = couldCompact ? COMPACTED_SIZE : UNCOMPACTED_SIZE;
@@ -264,90 +353,123 @@ void Encoder::encodeBlock(Kernel &k, Block *blk) {
   InstList &instList = blk->getInstList();
   const auto instListEnd = instList.end();
   for (auto instIter = instList.begin(); instIter != instListEnd; ++instIter) {
-    Instruction *inst = *instIter;
-
-    if (inst->hasInstOpt(InstOpt::CACHELINEALIGN)) {
-      while (currentPc() / 64 != (currentPc() + 31) / 64) {
-        SWSB swsb(SWSB::DistType::NO_DIST, SWSB::TokenType::NOTOKEN, 0, 0);
-        Instruction *syncInst = k.createSyncNopInstruction(swsb);
-        setCurrInst(syncInst);
-        encodeInstruction(*syncInst);
-        if (hasFatalError()) {
-          return;
-        }
-        setEncodedPC(syncInst, currentPc());
-        GED_RETURN_VALUE status = GED_RETURN_VALUE_SIZE;
-        status = GED_EncodeIns(&m_gedInst, GED_INS_TYPE_NATIVE,
-                               m_instBuf + currentPc());
-        if (status != GED_RETURN_VALUE_SUCCESS) {
-          errorAtT(inst->getLoc(), "GED unable to encode instruction: ",
-                   gedReturnValueToString(status));
-        }
-        blk->insertInstBefore(instIter, syncInst);
-        advancePc(16);
-      }
-    }
-
-    setCurrInst(inst);
-
-    if (inst->isInlineBinaryInstruction()) {
-      encodeInlineBinaryInst(*inst);
-      continue;
-    }
-
-    encodeInstruction(*inst);
+    encodeInstructionAt(k, *instIter, blk, instIter);
     if (hasFatalError()) {
       return;
     }
-    setEncodedPC(inst, currentPc());
-
-    GED_RETURN_VALUE status = GED_RETURN_VALUE_SIZE;
-
-    // If -Xforce-no-compact is set, do not compact any insruction
-    // Otherwise, if {NoCompact} is set, do not compact the instruction
-    // Otherwise, if {Compacted} is set on the instruction, try to compact it
-    // and report error on fail Otherwise, if no compaction setting on the
-    // instruction, try to compact the instruction if -Xauto-compact Otherwise,
-    // do not compact the instruction
-    bool mustCompact = inst->hasInstOpt(InstOpt::COMPACTED);
-    bool mustNotCompact = inst->hasInstOpt(InstOpt::NOCOMPACT);
-    if (m_opts.forceNoCompact) {
-      mustCompact = false;
-      mustNotCompact = true;
-    }
-
-    int32_t iLen = 16;
-    if (mustCompact || (!mustNotCompact && m_opts.autoCompact)) {
-      // try compact first
-      status = GED_EncodeIns(&m_gedInst, GED_INS_TYPE_COMPACT,
-                             m_instBuf + currentPc());
-      if (status == GED_RETURN_VALUE_SUCCESS) {
-        // If auto compation is turned on, in case we need to patch later.
-        inst->addInstOpt(InstOpt::COMPACTED);
-        iLen = 8;
-      } else if (status == GED_RETURN_VALUE_NO_COMPACT_FORM) {
-        if (mustCompact) {
-          if (m_opts.explicitCompactMissIsWarning) {
-            warningAtT(inst->getLoc(), "GED unable to compact instruction");
-          } else {
-            errorAtT(inst->getLoc(), "GED unable to compact instruction");
-          }
-        }
-      } // else: some other error (unreachable?)
-    }
+  }
+}
 
-    // try native encoding if compaction failed
-    if (status != GED_RETURN_VALUE_SUCCESS) {
-      inst->removeInstOpt(InstOpt::COMPACTED);
+void Encoder::encodeInstructionAt(Kernel &k, Instruction *inst, Block *blk,
+                                  InstList::iterator pos) {
+  if (inst->hasInstOpt(InstOpt::CACHELINEALIGN)) {
+    while (currentPc() / 64 != (currentPc() + 31) / 64) {
+      SWSB swsb(SWSB::DistType::NO_DIST, SWSB::TokenType::NOTOKEN, 0, 0);
+      Instruction *syncInst = k.createSyncNopInstruction(swsb);
+      setCurrInst(syncInst);
+      encodeInstruction(*syncInst);
+      if (hasFatalError()) {
+        return;
+      }
+      setEncodedPC(syncInst, currentPc());
+      GED_RETURN_VALUE status = GED_RETURN_VALUE_SIZE;
       status = GED_EncodeIns(&m_gedInst, GED_INS_TYPE_NATIVE,
                              m_instBuf + currentPc());
       if (status != GED_RETURN_VALUE_SUCCESS) {
         errorAtT(inst->getLoc(), "GED unable to encode instruction: ",
                  gedReturnValueToString(status));
       }
+      if (blk)
+        blk->insertInstBefore(pos, syncInst);
+      advancePc(16);
     }
-    advancePc(iLen);
   }
+
+  setCurrInst(inst);
+
+  if (inst->isInlineBinaryInstruction()) {
+    encodeInlineBinaryInst(*inst);
+    return;
+  }
+
+  if (!m_prepassBits.empty() && emitPrepassBits(inst))
+    return;
+
+  encodeInstruction(*inst);
+  if (hasFatalError()) {
+    return;
+  }
+  setEncodedPC(inst, currentPc());
+
+  GED_RETURN_VALUE status = GED_RETURN_VALUE_SIZE;
+
+  // If -Xforce-no-compact is set, do not compact any insruction
+  // Otherwise, if {NoCompact} is set, do not compact the instruction
+  // Otherwise, if {Compacted} is set on the instruction, try to compact it
+  // and report error on fail Otherwise, if no compaction setting on the
+  // instruction, try to compact the instruction if -Xauto-compact Otherwise,
+  // do not compact the instruction
+  bool mustCompact = inst->hasInstOpt(InstOpt::COMPACTED);
+  bool mustNotCompact = inst->hasInstOpt(InstOpt::NOCOMPACT);
+  if (m_opts.forceNoCompact) {
+    mustCompact = false;
+    mustNotCompact = true;
+  }
+
+  int32_t iLen = 16;
+  if (mustCompact || (!mustNotCompact && m_opts.autoCompact)) {
+    // try compact first
+    status = GED_EncodeIns(&m_gedInst, GED_INS_TYPE_COMPACT,
+                           m_instBuf + currentPc());
+    if (status == GED_RETURN_VALUE_SUCCESS) {
+      // If auto compation is turned on, in case we need to patch later.
+      inst->addInstOpt(InstOpt::COMPACTED);
+      iLen = 8;
+    } else if (status == GED_RETURN_VALUE_NO_COMPACT_FORM) {
+      if (mustCompact) {
+        if (m_opts.explicitCompactMissIsWarning) {
+          warningAtT(inst->getLoc(), "GED unable to compact instruction");
+        } else {
+          errorAtT(inst->getLoc(), "GED unable to compact instruction");
+        }
+      }
+    } // else: some other error (unreachable?)
+  }
+
+  // try native encoding if compaction failed
+  if (status != GED_RETURN_VALUE_SUCCESS) {
+    inst->removeInstOpt(InstOpt::COMPACTED);
+    status = GED_EncodeIns(&m_gedInst, GED_INS_TYPE_NATIVE,
+                           m_instBuf + currentPc());
+    if (status != GED_RETURN_VALUE_SUCCESS) {
+      errorAtT(inst->getLoc(), "GED unable to encode instruction: ",
+               gedReturnValueToString(status));
+    }
+  }
+  advancePc(iLen);
+}
+
+// Emits the bits compactRestrictPrepass kept for inst if they are the form
+// encodeBlock would produce.  The prepass only runs with auto-compaction, so
+// that is the compacted form unless the prepass marked inst {NoCompact}, and
+// the native form if compaction failed and was not required by {Compacted}
+// (in which case encodeBlock reports the failure).
+bool Encoder::emitPrepassBits(Instruction *inst) {
+  auto it = m_prepassBits.find(inst);
+  if (it == m_prepassBits.end())
+    return false;
+  const PrepassBits &pb = it->second;
+  if (pb.compacted ? inst->hasInstOpt(InstOpt::NOCOMPACT)
+                   : inst->hasInstOpt(InstOpt::COMPACTED))
+    return false;
+
+  setEncodedPC(inst, currentPc());
+  int32_t iLen = pb.compacted ? COMPACTED_SIZE : UNCOMPACTED_SIZE;
+  memcpy_s(m_instBuf + currentPc(), iLen, pb.bits, iLen);
+  if (pb.compacted)
+    inst->addInstOpt(InstOpt::COMPACTED);
+  advancePc(iLen);
+  return true;
 }
 
 bool Encoder::getBlockOffset(const Block *b, uint32_t &pc) {
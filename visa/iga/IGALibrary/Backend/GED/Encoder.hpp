@@ -20,6 +20,7 @@ SPDX-License-Identifier: MIT
 
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace iga {
@@ -71,6 +72,18 @@ public:
 
   void encodeKernel(Kernel &k, MemManager &m, void *&bits, uint32_t &bitsLen);
 
+  // Streaming alternative to encodeKernel: instructions are encoded as the
+  // caller produces them and are never appended to the blocks of k.
+  // beginStreamBlock records where a block starts so that jumps to it can be
+  // patched in endStream. maxInsts bounds the instructions encoded, including
+  // any sync.nop that CACHELINEALIGN inserts. The prepass passes of
+  // encodeKernel (auto-deps, compactRestrict) need the whole kernel and are
+  // not supported here.
+  void beginStream(MemManager &m, size_t maxInsts);
+  void beginStreamBlock(const Block *blk);
+  void encodeStreamInstruction(Kernel &k, Instruction *inst);
+  void endStream(Kernel &k, void *&bits, uint32_t &bitsLen);
+
   size_t getNumInstructionsEncoded() const;
 
   ///////////////////////////////////////////////////////////////////////
@@ -154,9 +167,14 @@ private:
   void *operator new(size_t sz, MemManager *m) { return m->alloc(sz); };
 
   void encodeBlock(Kernel &k, Block *blk);
+  // Encodes inst at the current PC. A sync.nop inserted for CACHELINEALIGN
+  // goes before pos in blk, or nowhere if blk is null.
+  void encodeInstructionAt(Kernel &k, Instruction *inst, Block *blk,
+                           InstList::iterator pos);
   void encodeInstruction(Instruction &inst);
   void patchJumpOffsets();
   void compactRestrictPrepass(const BlockList &blockList);
+  bool emitPrepassBits(Instruction *inst);
 
   ///////////////////////////////////////////////////////////////////////
   // BASIC INSTRUCTIONS
@@ -240,6 +258,7 @@ private:
   // state valid over encodeKernel()
   MemManager *m_mem;
   uint8_t *m_instBuf = nullptr; // the output bits
+  size_t m_instBufLen = 0;
   struct JumpPatch {            // JIP and UIP label patching
     Instruction *inst;          // the instruction
     ged_ins_t gedInst;          // the partially constructed GED instruction
@@ -249,6 +268,13 @@ private:
   };
   std::vector<JumpPatch> m_needToPatch;
   std::map<const Block *, int32_t> m_blockToOffsetMap;
+  // The bits compactRestrictPrepass encoded for each instruction that needs
+  // no patching; encodeBlock copies them instead of encoding it again.
+  struct PrepassBits {
+    bool compacted;
+    uint8_t bits[UNCOMPACTED_SIZE];
+  };
+  std::unordered_map<const Instruction *, PrepassBits> m_prepassBits;
 
 public:
   ////////////////////////////////////////////////////////////////
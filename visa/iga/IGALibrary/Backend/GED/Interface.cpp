@@ -10,6 +10,10 @@ SPDX-License-Identifier: MIT
 
 #include "Decoder.hpp"
 #include "Encoder.hpp"
+#include "GEDToIGATranslation.hpp"
+#include "IGAToGEDTranslation.hpp"
+
+#include <cstring>
 
 using namespace iga;
 
@@ -44,3 +48,91 @@ Kernel *iga::ged::Decode(const Model &m, const DecoderOpts &dopts,
   }
   return k;
 }
+
+// returns the length of the instruction at off, or 0 if the remaining
+// bytes cannot hold it
+static size_t instructionLength(const unsigned char *bits, size_t bitsLen,
+                                size_t off) {
+  if (bitsLen - off < 4)
+    return 0;
+  uint32_t dw0;
+  memcpy(&dw0, bits + off, sizeof(dw0));
+  size_t iLen = ((dw0 >> COMPACTION_CONTROL) & 1) != 0 ? COMPACTED_SIZE
+                                                       : UNCOMPACTED_SIZE;
+  return bitsLen - off < iLen ? 0 : iLen;
+}
+
+size_t iga::ged::CountInstructions(const void *bits, size_t bitsLen) {
+  const unsigned char *bytes = (const unsigned char *)bits;
+  size_t n = 0;
+  for (size_t off = 0, iLen; (iLen = instructionLength(bytes, bitsLen, off));
+       off += iLen)
+    n++;
+  return n;
+}
+
+bool iga::ged::DecodeRecords(const Model &m, const void *bits, size_t bitsLen,
+                             iga_inst_record_t *records) {
+  const unsigned char *bytes = (const unsigned char *)bits;
+  const GED_MODEL gedModel = lowerPlatform(m.platform);
+  bool success = true;
+  ged_ins_t gedInst;
+  for (size_t off = 0, iLen; (iLen = instructionLength(bytes, bitsLen, off));
+       off += iLen) {
+    iga_inst_record_t &r = *records++;
+    memset(&r, 0, sizeof(r));
+    r.pc = (uint32_t)off;
+    if (iLen == COMPACTED_SIZE)
+      r.flags |= IGA_INST_RECORD_COMPACTED;
+
+    memset(&gedInst, 0, sizeof(gedInst));
+    if (GED_DecodeIns(gedModel, bytes + off, (uint32_t)(bitsLen - off),
+                      &gedInst) != GED_RETURN_VALUE_SUCCESS) {
+      r.flags |= IGA_INST_RECORD_ERROR;
+      success = false;
+      continue;
+    }
+    const OpSpec &os = m.lookupOpSpec(translate(GED_GetOpcode(&gedInst)));
+    if (!os.isValid()) {
+      r.flags |= IGA_INST_RECORD_ERROR;
+      success = false;
+      continue;
+    }
+    r.op = static_cast<uint32_t>(os.op);
+
+    // fields an instruction lacks fail to decode and are left zero
+    GED_RETURN_VALUE st;
+    uint32_t execSize = GED_GetExecSize(&gedInst, &st);
+    if (st == GED_RETURN_VALUE_SUCCESS)
+      r.exec_size = (uint8_t)execSize;
+    GED_PRED_CTRL pred = GED_GetPredCtrl(&gedInst, &st);
+    if (st == GED_RETURN_VALUE_SUCCESS && pred != GED_PRED_CTRL_Normal)
+      r.flags |= IGA_INST_RECORD_PREDICATED;
+    GED_COND_MODIFIER cm = GED_GetCondModifier(&gedInst, &st);
+    if (st == GED_RETURN_VALUE_SUCCESS && cm != GED_COND_MODIFIER_Normal)
+      r.flags |= IGA_INST_RECORD_FLAG_MODIFIER;
+    GED_MASK_CTRL mc = GED_GetMaskCtrl(&gedInst, &st);
+    if (st == GED_RETURN_VALUE_SUCCESS && mc == GED_MASK_CTRL_NoMask)
+      r.flags |= IGA_INST_RECORD_NOMASK;
+    if (m.platform >= Platform::XE) {
+      uint32_t swsb = GED_GetSWSB(&gedInst, &st);
+      if (st == GED_RETURN_VALUE_SUCCESS)
+        r.swsb = swsb;
+    }
+    if (os.isBranching()) {
+      r.flags |= IGA_INST_RECORD_BRANCH;
+      int32_t jip = GED_GetJIP(&gedInst, &st);
+      if (st == GED_RETURN_VALUE_SUCCESS)
+        r.jip = jip;
+      int32_t uip = GED_GetUIP(&gedInst, &st);
+      if (st == GED_RETURN_VALUE_SUCCESS)
+        r.uip = uip;
+    } else if (os.isAnySendFormat()) {
+      r.flags |= IGA_INST_RECORD_SEND;
+      GED_SFID sfid = GED_GetSFID(&gedInst, &st);
+      if (st == GED_RETURN_VALUE_SUCCESS)
+        r.sfid = (uint8_t)translate(sfid);
+    }
+  }
+  return success;
+}
@@ -13,6 +13,7 @@ SPDX-License-Identifier: MIT
 // GED ENCODER USERS USE THIS INTERFACE
 #include "../../ErrorHandler.hpp"
 #include "../../IR/Kernel.hpp"
+#include "../../api/iga.h"
 #include "../DecoderOpts.hpp"
 #include "../EncoderOpts.hpp"
 
@@ -25,6 +26,17 @@ void Encode(const Model &m, const EncoderOpts &opts, ErrorHandler &eh,
 bool IsDecodeSupported(const Model &m, const DecoderOpts &opts);
 Kernel *Decode(const Model &m, const DecoderOpts &dopts, ErrorHandler &eh,
                const void *bits, size_t bitsLen);
+
+// The number of instructions DecodeRecords will emit for these bits
+// (trailing padding too short for an instruction is ignored).
+size_t CountInstructions(const void *bits, size_t bitsLen);
+// Decodes a summary of each instruction without building a Kernel.
+// records must have room for CountInstructions(bits, bitsLen) entries.
+// Uses no state but the stack, so kernels may be decoded in parallel.
+// Returns false if some instruction failed to decode; its record is
+// flagged with IGA_INST_RECORD_ERROR.
+bool DecodeRecords(const Model &m, const void *bits, size_t bitsLen,
+                   iga_inst_record_t *records);
 } // namespace ged
 } // namespace iga
 
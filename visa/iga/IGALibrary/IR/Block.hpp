@@ -30,6 +30,12 @@ typedef InstList::iterator InstListIterator;
 class Block {
 public:
   Block(int32_t pc = -1) : m_offset(pc), m_id(pc) {}
+  // The instruction list allocates its nodes from listMem, which can be
+  // shared by all blocks of a kernel.
+  Block(int32_t pc, std::shared_ptr<MemManager> listMem)
+      : m_offset(pc),
+        m_instructions(std_arena_based_allocator<Instruction *>(listMem)),
+        m_id(pc) {}
   ~Block() {
     // Destruct instructions.  The memory allocated for them will be
     // de-allocated by the top-level MemManager allocator, but we need
@@ -9,11 +9,16 @@ SPDX-License-Identifier: MIT
 #include "Kernel.hpp"
 #include "../IR/Messages.hpp"
 
+#include <algorithm>
 #include <set>
 
 using namespace iga;
 
-Kernel::Kernel(const Model &model) : m_model(model), m_mem(4096) {}
+Kernel::Kernel(const Model &model, size_t numInstsHint)
+    : m_model(model),
+      m_mem(std::max<size_t>(4096, numInstsHint * sizeof(Instruction))),
+      m_instListMem(std::make_shared<MemManager>(std::max<size_t>(
+          4096, numInstsHint * 3 * sizeof(Instruction *)))) {}
 
 Kernel::~Kernel() {
   // Since in a kernel blocks are allocated using the memory pool,
@@ -54,7 +59,7 @@ size_t Kernel::getInstructionCount() const {
   return n;
 }
 
-Block *Kernel::createBlock() { return new (&m_mem) Block(); }
+Block *Kernel::createBlock() { return new (&m_mem) Block(-1, m_instListMem); }
 
 void Kernel::appendBlock(Block *blk) { m_blocks.push_back(blk); }
 
@@ -27,7 +27,9 @@ typedef std::list<iga::Block *, std_arena_based_allocator<iga::Block *>>
 
 class Kernel {
 public:
-  Kernel(const Model &model);
+  // numInstsHint sizes the arenas so that building a kernel of about that
+  // many instructions takes few allocations.
+  Kernel(const Model &model, size_t numInstsHint = 0);
   ~Kernel();
   // disabling copy constructor to prevent problems with
   // shallow copy and mem manager
@@ -93,6 +95,8 @@ public:
 private:
   const Model &m_model;
   MemManager m_mem;
+  // Instruction list nodes of the blocks made by createBlock.
+  std::shared_ptr<MemManager> m_instListMem;
 
   BlockList m_blocks;
 };
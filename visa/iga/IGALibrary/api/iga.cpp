@@ -737,6 +737,31 @@ iga_status_t iga_context_disassemble_instruction(
                                          fmt_label_ctx, kernel_text);
 }
 
+iga_status_t iga_decode_records(iga_gen_t gen, const void *input,
+                                uint32_t input_size, iga_inst_record_t *records,
+                                uint32_t *records_len) {
+  RETURN_INVALID_ARG_ON_NULL(records_len);
+  if (input == nullptr && input_size != 0)
+    return IGA_INVALID_ARG;
+
+  const Model *m = Model::LookupModel(ToPlatform(gen));
+  if (!m) {
+    return IGA_UNSUPPORTED_PLATFORM;
+  }
+  const size_t numInsts =
+      input_size == 0 ? 0 : ged::CountInstructions(input, input_size);
+  const uint32_t capacity = *records_len;
+  *records_len = (uint32_t)numInsts;
+  if (numInsts == 0)
+    return IGA_SUCCESS;
+  if (numInsts > capacity)
+    return IGA_OUT_OF_MEM;
+  RETURN_INVALID_ARG_ON_NULL(records);
+
+  return ged::DecodeRecords(*m, input, input_size, records) ? IGA_SUCCESS
+                                                            : IGA_DECODE_ERROR;
+}
+
 iga_status_t iga_context_get_errors(iga_context_t ctx,
                                     const iga_diagnostic_t **ds,
                                     uint32_t *ds_len) {
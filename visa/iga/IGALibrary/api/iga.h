@@ -533,6 +533,68 @@ IGA_API iga_status_t iga_disassemble_instruction(
     const void *input, const char *(*fmt_label_name)(int32_t, void *),
     void *fmt_label_ctx, char **kernel_text);
 
+/*
+ * A compact summary of one decoded instruction.
+ */
+typedef struct {
+  /* the byte offset of the instruction in the input */
+  uint32_t pc;
+  /* the IGA op (see iga_opspec_op); 0 if the instruction failed to decode */
+  uint32_t op;
+  /* the raw SWSB encoding (XE+ only; otherwise 0) */
+  uint32_t swsb;
+  /* the branch offsets relative to pc (branches only; otherwise 0) */
+  int32_t jip;
+  int32_t uip;
+  /* the execution size (e.g. 16 for (16)); 0 if the op has none */
+  uint8_t exec_size;
+  /* the IGA SFID (sends only; otherwise 0) */
+  uint8_t sfid;
+  /* a union of IGA_INST_RECORD_* bits */
+  uint16_t flags;
+} iga_inst_record_t;
+
+#define IGA_INST_RECORD_COMPACTED 0x0001u
+#define IGA_INST_RECORD_PREDICATED 0x0002u
+#define IGA_INST_RECORD_FLAG_MODIFIER 0x0004u
+#define IGA_INST_RECORD_NOMASK 0x0008u
+#define IGA_INST_RECORD_BRANCH 0x0010u
+#define IGA_INST_RECORD_SEND 0x0020u
+/* the instruction failed to decode; only pc and the compaction bit are valid */
+#define IGA_INST_RECORD_ERROR 0x8000u
+
+/*
+ * Decodes kernel bits into an array of instruction records without
+ * building the IR or any text. This is intended for profilers that map
+ * large numbers of instructions back to ops and dependencies; use the
+ * disassemble functions when full operands or JSON output are needed.
+ *
+ * The function allocates no memory and uses no context, so separate
+ * threads may call it concurrently.
+ *
+ * PARAMETERS:
+ *  gen             the platform the bits were generated for
+ *  input           the instructions to decode
+ *  input_size      the size of the 'input' in bytes
+ *  records         the output array; may be NULL if *records_len is 0
+ *  records_len     on input the capacity of 'records' (in records); on
+ *                  output the number of instructions in 'input'
+ *
+ * RETURNS:
+ *  IGA_SUCCESS         if all instructions decoded
+ *  IGA_INVALID_ARG     if an argument is NULL; 'input' may be NULL only
+ *                      if 'input_size' is also 0
+ *  IGA_UNSUPPORTED_PLATFORM  if 'gen' is not supported
+ *  IGA_OUT_OF_MEM      if 'records' is too small; *records_len holds the
+ *                      required length and no records are written
+ *  IGA_DECODE_ERROR    if some instruction failed to decode; all records are
+ *                      written and the bad ones have IGA_INST_RECORD_ERROR
+ */
+IGA_API iga_status_t iga_decode_records(iga_gen_t gen, const void *input,
+                                        uint32_t input_size,
+                                        iga_inst_record_t *records,
+                                        uint32_t *records_len);
+
 /*****************************************************************************/
 /*             Diagnostic Processing Functions                               */
 /*****************************************************************************/
@@ -42,6 +42,39 @@ iga_status_t KernelEncoder::encode(std::ostream &errStr) {
   return IGA_SUCCESS;
 }
 
+KernelStreamEncoder::KernelStreamEncoder(Kernel *k, bool compact,
+                                         SWSB_ENCODE_MODE swsbEncodeMode,
+                                         size_t maxInsts)
+    : m_kernel(k) {
+  EncoderOpts enc_opt(compact, true);
+  enc_opt.swsbEncodeMode = swsbEncodeMode;
+  m_encoder = ::new Encoder(m_kernel->getModel(), m_errHandler, enc_opt);
+  m_encoder->beginStream(m_kernel->getMemManager(), maxInsts);
+}
+
+KernelStreamEncoder::~KernelStreamEncoder() { ::delete m_encoder; }
+
+void KernelStreamEncoder::startBlock(const Block *b) {
+  m_encoder->beginStreamBlock(b);
+}
+
+void KernelStreamEncoder::encode(Instruction *inst) {
+  m_encoder->encodeStreamInstruction(*m_kernel, inst);
+}
+
+iga_status_t KernelStreamEncoder::finish(std::ostream &errStr) {
+  m_encoder->endStream(*m_kernel, m_buf, m_binarySize);
+#ifdef _DEBUG
+  if (m_errHandler.hasErrors()) {
+    for (const auto &e : m_errHandler.getErrors()) {
+      errStr << "vISA inst $" << e.at.offset << ": " << e.message << "\n";
+    }
+    return IGA_ERROR;
+  }
+#endif // _DEBUG
+  return IGA_SUCCESS;
+}
+
 bool KernelEncoder::patchImmValue(const Model &model, unsigned char *binary,
                                   Type type, const ImmVal &val) {
   // check if the first instruction is compacted and get the instruction length
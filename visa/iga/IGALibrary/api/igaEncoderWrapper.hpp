@@ -77,4 +77,40 @@ public:
 
 };
 
+namespace iga {
+class Encoder;
+}
+
+// entry point for encoding a kernel one instruction at a time, as the caller
+// translates it, instead of building the kernel's blocks first. Instructions
+// and blocks are still created by the kernel, but are never appended to it.
+// IGA swsb set and compaction restriction need the whole kernel and are not
+// available here.
+class KernelStreamEncoder {
+  iga::Kernel *m_kernel;
+  iga::ErrorHandler m_errHandler;
+  iga::Encoder *m_encoder = nullptr;
+  void *m_buf = nullptr;
+  uint32_t m_binarySize = 0;
+
+public:
+  // @param maxInsts: bound on the instructions encoded, including the
+  // sync.nop padding of CACHELINEALIGN instructions
+  KernelStreamEncoder(iga::Kernel *k, bool compact,
+                      iga::SWSB_ENCODE_MODE swsbEncodeMode, size_t maxInsts);
+  ~KernelStreamEncoder();
+  KernelStreamEncoder(const KernelStreamEncoder &) = delete;
+  KernelStreamEncoder &operator=(const KernelStreamEncoder &) = delete;
+
+  // the instructions encoded after this call belong to b
+  void startBlock(const iga::Block *b);
+  // encodes inst and sets its PC
+  void encode(iga::Instruction *inst);
+  // patches the jumps and finalizes the binary
+  iga_status_t finish(std::ostream &os);
+
+  void *getBinary() const { return m_buf; }
+  uint32_t getBinarySize() const { return m_binarySize; }
+};
+
 #endif // _IGA_ENCODER_WRAPPER_HPP
@@ -0,0 +1,125 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2026 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#ifndef __COMPILETRACE_H__
+#define __COMPILETRACE_H__
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Hierarchical compile-time tracing shared by IGC, vISA and IGA encoding.
+//
+// Spans are opened and closed on the thread that runs them and are recorded
+// into a buffer private to that thread. The buffers are written out in the
+// Chrome trace-event JSON format, which chrome://tracing and Perfetto open.
+//
+// A span name is interned once into a SpanID, so recording a span costs a
+// clock read and a buffer append at each end. When tracing is off, every
+// entry point below is a single relaxed load.
+//
+// Tracing may be sampled: with a sample rate of N only every Nth compilation
+// opened by a Sample is recorded. Threads that are outside of any Sample,
+// e.g. workers that compile for one, record while a sampled compilation is
+// in flight.
+
+namespace vISA {
+namespace trace {
+
+using SpanID = uint32_t;
+
+namespace detail {
+extern std::atomic<bool> Enabled;
+bool isRecording();
+void begin(SpanID id);
+void end(SpanID id);
+void addArg(const char *key, uint64_t value);
+void addArg(const char *key, const std::string &value);
+} // namespace detail
+
+inline bool isEnabled() {
+  return detail::Enabled.load(std::memory_order_relaxed);
+}
+
+// Returns whether spans begun on this thread are recorded, i.e. tracing is on
+// and the compilation in flight is sampled. Callers can skip building span
+// names and interning them when this is false.
+inline bool isRecording() { return isEnabled() && detail::isRecording(); }
+
+// Starts writing the trace to path. Only the first call has an effect.
+void enable(const char *path, unsigned sampleRate);
+
+// Returns the ID of the span called name. category groups spans in the
+// viewer, e.g. "igc", "pass" or "visa".
+SpanID intern(const std::string &name, const char *category);
+
+inline void begin(SpanID id) {
+  if (isEnabled())
+    detail::begin(id);
+}
+
+// Closes the innermost open span with this ID, and any span opened inside it
+// that is still open.
+inline void end(SpanID id) {
+  if (isEnabled())
+    detail::end(id);
+}
+
+// Attaches an attribute to the innermost open span of this thread. key must
+// be a string literal.
+inline void addArg(const char *key, uint64_t value) {
+  if (isEnabled())
+    detail::addArg(key, value);
+}
+inline void addArg(const char *key, const std::string &value) {
+  if (isEnabled())
+    detail::addArg(key, value);
+}
+
+// Writes out the events this thread has buffered. Buffers are also written
+// out when they fill up and when their thread exits.
+void flush();
+
+class Span {
+  const SpanID id;
+
+public:
+  explicit Span(SpanID _id) : id(_id) { begin(id); }
+  Span(const Span &) = delete;
+  Span &operator=(const Span &) = delete;
+  ~Span() { end(id); }
+};
+
+// Decides whether the compilation in its scope is recorded. Scopes may nest;
+// only the outermost one counts. The trace is flushed when a sampled
+// compilation ends.
+class Sample {
+  bool entered = false;
+  bool sampled = false;
+
+public:
+  Sample();
+  Sample(const Sample &) = delete;
+  Sample &operator=(const Sample &) = delete;
+  ~Sample();
+};
+
+} // namespace trace
+} // namespace vISA
+
+#define COMPILE_TRACE_CONCAT_IMPL(a, b) a##b
+#define COMPILE_TRACE_CONCAT(a, b) COMPILE_TRACE_CONCAT_IMPL(a, b)
+
+// Traces the rest of the enclosing scope as the span NAME.
+#define COMPILE_TRACE_SCOPE(NAME, CATEGORY)                                    \
+  static const vISA::trace::SpanID COMPILE_TRACE_CONCAT(                       \
+      __traceSpanID, __LINE__) = vISA::trace::intern(NAME, CATEGORY);          \
+  vISA::trace::Span COMPILE_TRACE_CONCAT(__traceSpan, __LINE__)(               \
+      COMPILE_TRACE_CONCAT(__traceSpanID, __LINE__))
+
+#endif // __COMPILETRACE_H__
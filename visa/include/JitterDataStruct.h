@@ -158,6 +158,17 @@ struct PERF_STATS_VERBOSE {
   // Number of SIMD inteference edges.
   uint32_t augIntfNum = 0;
 
+  // Global scheduling counters: the sends hoisted across BBs and the static
+  // estimate of the cycles they save per run of the kernel.
+  uint32_t globalSchedHoistedSends = 0;
+  uint32_t globalSchedCycleGain = 0;
+
+  // Latency-based spill cost model (-latencyspillcost): the predicted cycles
+  // of the spill/fill code RA inserted, and the cycles saved compared to the
+  // candidates the default spill cost would have picked.
+  uint32_t spillCostCycles = 0;
+  uint32_t spillCostCyclesAvoided = 0;
+
   // preRA scheduler counters
   uint32_t minRegClusterCount;
   uint32_t minRegSUCount;
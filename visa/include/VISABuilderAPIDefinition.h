@@ -17,6 +17,7 @@ SPDX-License-Identifier: MIT
 #include "visa_igc_common_header.h"
 
 #include <unordered_set>
+#include <vector>
 
 #define VISA_BUILDER_API
 
@@ -1443,6 +1444,17 @@ public:
   ParseVISAText(const std::string &visaText,
                 const std::string &visaTextFile) = 0;
   VISA_BUILDER_API virtual int ParseVISAText(const std::string &visaFile) = 0;
+  // Parses the vISA text of modules linked together and runs the vISA
+  // verifier once over all of them. failedText is the index of the text that
+  // failed to parse, or ~0u if verification failed.
+  VISA_BUILDER_API virtual int
+  ParseLinkedVISAText(const std::vector<const char *> &visaTexts,
+                      unsigned &failedText) = 0;
+  // Parses a fragment of vISA text, e.g. one inline asm block, and appends
+  // its instructions to kernel. The fragment refers to the kernel's variables
+  // by name, so vISA_InlineVISAFragments must be set before they are created.
+  VISA_BUILDER_API virtual int
+  ParseVISAFragment(VISAKernel *kernel, const std::string &visaText) = 0;
   VISA_BUILDER_API virtual std::stringstream &GetAsmTextStream() = 0;
   VISA_BUILDER_API virtual VISAKernel *
   GetVISAKernel(const std::string &kernelName = "") const = 0;
@@ -43,6 +43,9 @@ DEF_VISA_OPTION(vISA_DumpPerfStatsVerbose, ET_BOOL, "-dumpVISAJsonStatsVerbose",
                 "dump the verbose stats to default json file name", false)
 DEF_VISA_OPTION(vISA_DumpSendInfoStats, ET_BOOL, "-dumpVISASendInfoStats",
                 "dumps the sendinfo stats with the stats.json file", false)
+DEF_VISA_OPTION(vISA_DumpArenaUsage, ET_BOOL, "-dumpArenaUsage",
+                "print peak and per-pass arena memory of each kernel to stderr",
+                false)
 DEF_VISA_OPTION(vISA_ShaderStatsDumpless, ET_BOOL, "-noDumpShaderStats",
         "executes pathway for no dumping and running shader stats", false)
 DEF_VISA_OPTION(VISA_FullIRVerify, ET_BOOL, "-fullIRVerify", UNUSED, false)
@@ -500,12 +503,26 @@ DEF_VISA_OPTION(vISA_RAAntiDepRecolorRotation, ET_INT32,
 DEF_VISA_OPTION(vISA_SplitGRFAlignedScalar, ET_BOOL, "-nosplitGRFalignedscalar",
                 UNUSED, true)
 DEF_VISA_OPTION(vISA_DoSplitOnSpill, ET_BOOL, "-nosplitonspill", UNUSED, true)
+DEF_VISA_OPTION(vISA_LoopBoundarySplit, ET_BOOL, "-loopBoundarySplit",
+                "USAGE: -loopBoundarySplit "
+                "split spilled variables live through hot loops at the loop "
+                "boundaries before spilling",
+                false)
 DEF_VISA_OPTION(vISA_IncSpillCostAllAddrTaken, ET_BOOL, "-allowaddrtakenspill",
                 UNUSED, false)
 DEF_VISA_OPTION(vISA_NewSpillCostFunction, ET_BOOL, "-newspillcost", UNUSED,
                 false)
 DEF_VISA_OPTION(vISA_NewSpillCostFunctionISPC, ET_BOOL, "-newspillcostispc", UNUSED,
                 false)
+DEF_VISA_OPTION(vISA_LatencySpillCost, ET_BOOL, "-latencyspillcost",
+                "USAGE: -latencyspillcost "
+                "weigh GRF spill candidates by the predicted cycles of their "
+                "spill and fill code",
+                false)
+DEF_VISA_OPTION(vISA_SpillCostLoopTripCount, ET_INT32, "-spillCostLoopTrip",
+                "USAGE: -spillCostLoopTrip <NUM> "
+                "assumed trip count of each loop when there is no profile",
+                16)
 
 DEF_VISA_OPTION(vISA_VerifyAugmentation, ET_BOOL, "-verifyaugmentation", UNUSED,
                 false)
@@ -534,10 +551,18 @@ DEF_VISA_OPTION(vISA_DumpLiveRanges, ET_BOOL, "-dumplrs", UNUSED, false)
 DEF_VISA_OPTION(vISA_FailSafeRALimit, ET_INT32, "-failSafeRALimit", UNUSED, 3)
 DEF_VISA_OPTION(vISA_DenseMatrixLimit, ET_INT32, "-denseMatrixLimit", UNUSED,
                 0x800)
+DEF_VISA_OPTION(vISA_ParallelIntfThreads, ET_INT32, "-parallelIntfThreads",
+                "USAGE: -parallelIntfThreads <N> where N is the number of threads "
+                "building the interference graph, 0 uses all hardware threads", 1)
+DEF_VISA_OPTION(vISA_ParallelIntfMinInsts, ET_INT32, "-parallelIntfMinInsts",
+                UNUSED, 10000)
 DEF_VISA_OPTION(vISA_FillConstOpt, ET_BOOL, "-nofillconstopt", UNUSED, true)
 DEF_VISA_OPTION(vISA_GCRRInFF, ET_BOOL_TRUE, "-GCRRinFF", UNUSED, true)
 DEF_VISA_OPTION(vISA_IncrementalRA, ET_INT32, "-incrementalra",
                 "USAGE: -incrementalra <0|1|2> where 0 is disabled, 1 is enabled, 2 is enabled with verification", 0)
+DEF_VISA_OPTION(vISA_IncrementalLiveness, ET_BOOL, "-noIncrementalLiveness",
+                "USAGE: -noIncrementalLiveness disables reusing liveness of "
+                "previous iteration when incremental RA is enabled", true)
 DEF_VISA_OPTION(vISA_SplitAlignedScalarMinDist, ET_INT32,
                 "-splitAlignedScalarMinDist",
                 "dist threshold for controlling when to split aligned scalars in RA", 200)
@@ -548,6 +573,14 @@ DEF_VISA_OPTION(vISA_SplitAlignedScalarBloatPPT, ET_INT32,
 DEF_VISA_OPTION(vISA_LocalScheduling, ET_BOOL, "-noschedule", UNUSED, true)
 DEF_VISA_OPTION(vISA_preRA_Schedule, ET_BOOL, "-nopresched", UNUSED, true)
 DEF_VISA_OPTION(vISA_preRA_ScheduleForce, ET_BOOL, "-presched", UNUSED, false)
+DEF_VISA_OPTION(vISA_GlobalScheduling, ET_BOOL, "-globalSched",
+                "hoist sends across basic blocks before preRA scheduling",
+                false)
+DEF_VISA_OPTION(vISA_GlobalSchedMaxRegionInsts, ET_INT32,
+                "-globalSchedMaxRegionInsts",
+                "USAGE: -globalSchedMaxRegionInsts <num>\n", 1000)
+DEF_VISA_OPTION(vISA_GlobalSchedMaxSends, ET_INT32, "-globalSchedMaxSends",
+                "USAGE: -globalSchedMaxSends <num>\n", 4)
 DEF_VISA_OPTION(vISA_preRA_ScheduleCtrl, ET_INT32, "-presched-ctrl",
                 "USAGE: -presched-ctrl <ctrl>\n", 4)
 DEF_VISA_OPTION(vISA_preRA_ScheduleRPThreshold, ET_INT32, "-presched-rp",
@@ -604,6 +637,11 @@ DEF_VISA_OPTION(vISA_LocalSchedulingStartBB, ET_INT32, "-scheduleStartBB",
                 UNUSED, 0)
 DEF_VISA_OPTION(vISA_LocalSchedulingEndBB, ET_INT32, "-scheduleEndBB", UNUSED,
                 UINT_MAX)
+DEF_VISA_OPTION(vISA_LocalSchedulingThreads, ET_INT32, "-localSchedThreads",
+                "USAGE: -localSchedThreads <N> where N is the number of threads "
+                "scheduling basic blocks, 0 uses all hardware threads", 1)
+DEF_VISA_OPTION(vISA_LocalSchedulingParallelMinInsts, ET_INT32,
+                "-localSchedParallelMinInsts", UNUSED, 10000)
 DEF_VISA_OPTION(vISA_assumeL1Hit, ET_BOOL, "-assumeL1Hit", UNUSED, false)
 DEF_VISA_OPTION(vISA_ignoreL1Hit, ET_BOOL, "-ignoreL1Hit",
                 "Ignore LSC L1Hit cache option when calculating latency in scheduling", false)
@@ -698,6 +736,18 @@ DEF_VISA_OPTION(vISA_HybridRAWithSpill, ET_BOOL, "-hybridRAWithSpill", UNUSED,
                 false)
 DEF_VISA_OPTION(vISA_SelectiveFastRA, ET_BOOL, "-selectiveFastRA", UNUSED,
                 false)
+DEF_VISA_OPTION(vISA_CompileTier, ET_INT32, "-compileTier",
+                "USAGE: -compileTier <0|1|2> where 0 uses linear scan RA and no "
+                "preRA scheduling, 1 uses single iteration hybrid RA, 2 uses "
+                "full graph coloring RA. With -compileBudget it is the highest "
+                "tier to pick", 2)
+DEF_VISA_OPTION(vISA_CompileBudget, ET_INT32, "-compileBudget",
+                "USAGE: -compileBudget <ms> picks the highest tier whose "
+                "estimated compile time fits in the budget, 0 means no budget",
+                0)
+DEF_VISA_OPTION(vISA_CompileTierInstsPerMs, ET_INT32, "-compileTierInstsPerMs",
+                "USAGE: -compileTierInstsPerMs <N> where N is the number of "
+                "instructions compiled per millisecond at tier 2", 200)
 DEF_VISA_OPTION(vISA_SelectiveRAInstThreshold, ET_INT32, "-selectiveRAInstThreshold",
                 UNUSED, 131072) // 128*1024
 DEF_VISA_OPTION(vISA_SelectiveRAGlobaVarRatioThreshold, ET_CSTR, "-selectiveRAGVRatioThreshold",
@@ -720,6 +770,12 @@ DEF_VISA_OPTION(vISA_BXMLEncoder, ET_BOOL, "-nobxmlencoder", UNUSED, true)
 DEF_VISA_OPTION(vISA_IGAEncoder, ET_BOOL, "-IGAEncoder",
                 "forces use of IGA encoder (default on some platforms)",
                 false)
+DEF_VISA_OPTION(vISA_IGAStreamEncode, ET_BOOL_TRUE, "-igaStreamEncode",
+                "Encode each instruction as it is translated to IGA instead "
+                "of building the whole IGA kernel first. Falls back to the "
+                "whole-kernel encoder for -IGASWSB, -dumpIgaJson and "
+                "platforms that restrict compaction",
+                false)
 //=== asm/isaasm/isa emission options ===
 DEF_VISA_OPTION(vISA_outputToFile, ET_BOOL, "-output", UNUSED, false)
 DEF_VISA_OPTION(vISA_SymbolReg, ET_BOOL, "-symbolreg", "DEPRECATED, is a nop", false)
@@ -734,6 +790,14 @@ DEF_VISA_OPTION(vISA_ISAASMToConsole, ET_BOOL, "-isaasmToConsole",
                 "emit isaasm to stdout instead of file and do early exit", false)
 DEF_VISA_OPTION(vISA_AddISAASMDeclarationsToEnd, ET_BOOL, "-isaasmAddDeclarationsAtEnd",
                 "Add a comment with .decl section to the end of isaasm console dump. Used in tests.", false)
+DEF_VISA_OPTION(vISA_LinkableVISA, ET_BOOL, "-linkableVisa",
+                "Keep unique variable names and the vISA IR after compilation so that "
+                "the .visaasm of each kernel can be linked into another module, "
+                "without dumping .visaasm files", false)
+DEF_VISA_OPTION(vISA_InlineVISAFragments, ET_BOOL, "-inlineVisaFragments",
+                "Record variable names as variables are created so that vISA text "
+                "fragments such as inline assembly can be parsed into the kernel",
+                false)
 DEF_VISA_OPTION(vISA_DumpIsaVarNames, ET_BOOL, "-dumpisavarnames", UNUSED, true)
 DEF_VISA_OPTION(vISA_UniqueLabels, ET_BOOL, "-uniqueLabel", UNUSED, false)
 DEF_VISA_OPTION(vISA_ShaderDumpRegexFilter, ET_CSTR, "-shaderDumpRegexFilter",
@@ -963,6 +1027,8 @@ DEF_VISA_OPTION(vISA_ScratchAllocForStackInKB, ET_INT32,
 DEF_VISA_OPTION(vISA_dumpToCurrentDir, ET_BOOL, "-dumpToCurrentDir", UNUSED,
                 false)
 DEF_VISA_OPTION(vISA_dumpTimer, ET_BOOL, "-timestats", UNUSED, false)
+DEF_VISA_OPTION(vISA_CompileTraceFile, ET_CSTR, "-compileTrace",
+                "USAGE: -compileTrace <trace.json>\n", NULL)
 DEF_VISA_OPTION(vISA_ShaderDataBaseStats, ET_BOOL, "--sdbStats", UNUSED, false)
 DEF_VISA_OPTION(vISA_ShaderDataBaseStatsFilePath, ET_CSTR, "-sdbStatsFile",
                 UNUSED, NULL)